@@ -0,0 +1,246 @@
+#include <string.h>
+
+#include "agenda.h"
+
+#define Q8 256
+#define NIVEL_MAX_Q8 (100 * Q8)
+#define EWMA_PESO 8           // Peso 1/8 depois das primeiras horas
+#define LACUNA_MAX_S 7200     // Sem amostras por mais que isso, a hora é descartada
+
+// Fora de ponta nos dias úteis exceto 17h às 22h (ponta e intermediária) e o
+// dia todo no fim de semana
+const agenda_janela_t agenda_tarifa_branca[] = {
+    {AGENDA_DIAS_UTEIS, 22, 17},
+    {AGENDA_FIM_DE_SEMANA, 0, 24},
+};
+const uint8_t agenda_tarifa_branca_num = sizeof(agenda_tarifa_branca) / sizeof(agenda_tarifa_branca[0]);
+
+// 01/01/1970 foi uma quinta-feira: 4 dias depois do domingo
+static uint8_t hora_da_semana(uint32_t epoca_s, int32_t fuso_s) {
+    uint32_t local = epoca_s + (uint32_t)fuso_s;
+    return (uint8_t)((local / 3600 + 4 * 24) % AGENDA_SLOTS);
+}
+
+static uint16_t nivel_q8(float nivel) {
+    if (nivel <= 0.0f) {
+        return 0;
+    }
+    return nivel >= 100.0f ? NIVEL_MAX_Q8 : (uint16_t)(nivel * Q8 + 0.5f);
+}
+
+static bool janela_contem(const agenda_janela_t *j, uint8_t dia, uint8_t hora) {
+    if (!(j->dias & (1u << dia))) {
+        return false;
+    }
+    if (j->hora_inicio <= j->hora_fim) {
+        return hora >= j->hora_inicio && hora < j->hora_fim;
+    }
+    return hora >= j->hora_inicio || hora < j->hora_fim;
+}
+
+void agenda_init(agenda_t *ag, const agenda_janela_t *baratas, uint8_t num_baratas, int32_t fuso_s) {
+    memset(ag, 0, sizeof(*ag));
+    ag->fuso_s = fuso_s;
+    ag->hora = -1;
+    for (uint8_t h = 0; h < AGENDA_SLOTS; h++) {
+        for (uint8_t i = 0; i < num_baratas; i++) {
+            if (janela_contem(&baratas[i], h / 24, h % 24)) {
+                ag->barata[h / 8] |= 1u << (h % 8);
+                break;
+            }
+        }
+    }
+}
+
+bool agenda_hora_barata(const agenda_t *ag, uint8_t hora_semana) {
+    return ag->barata[hora_semana / 8] & (1u << (hora_semana % 8));
+}
+
+// Previsão em Q8.8: média mais AGENDA_K_DESVIO desvios
+static uint32_t previsao_q8(const agenda_t *ag, uint8_t h) {
+    const agenda_slot_t *s = &ag->slots[h];
+    return s->amostras ? (uint32_t)s->media + AGENDA_K_DESVIO * (uint32_t)s->desvio : 0;
+}
+
+float agenda_previsao(const agenda_t *ag, uint8_t hora_semana) {
+    return (float)previsao_q8(ag, hora_semana) / Q8;
+}
+
+/**
+ * Nas últimas AGENDA_ANTECEDENCIA_H horas de uma janela barata, a reserva é
+ * o consumo previsto das horas caras seguintes, até a próxima hora barata.
+ * Antes disso e fora da janela, zero: a bomba liga só em lim_min, o que evita
+ * manter o mínimo perto de lim_max (ciclos curtos) durante a janela inteira.
+ */
+static void recalcula_reserva(agenda_t *ag) {
+    ag->reserva_q8 = 0;
+    if (ag->hora < 0 || !agenda_hora_barata(ag, (uint8_t)ag->hora)) {
+        return;
+    }
+    uint32_t soma = 0;
+    bool na_janela = true;
+    for (uint8_t i = 1; i < AGENDA_SLOTS; i++) {
+        uint8_t h = (uint8_t)((ag->hora + i) % AGENDA_SLOTS);
+        bool barata = agenda_hora_barata(ag, h);
+        if (na_janela) {
+            na_janela = barata;
+            if (barata) {
+                continue;
+            }
+            if (i > AGENDA_ANTECEDENCIA_H) {
+                return;  // Ainda há tempo barato de sobra para encher depois
+            }
+        } else if (barata) {
+            break;
+        }
+        soma += previsao_q8(ag, h);
+    }
+    ag->reserva_q8 = soma > NIVEL_MAX_Q8 ? NIVEL_MAX_Q8 : (uint16_t)soma;
+}
+
+// Média móvel do consumo da hora; nas primeiras horas, média simples
+static void aprende(agenda_slot_t *s, uint32_t taxa_q8) {
+    if (taxa_q8 > UINT16_MAX) {
+        taxa_q8 = UINT16_MAX;
+    }
+    if (s->amostras == 0) {
+        s->media = (uint16_t)taxa_q8;
+        s->desvio = (uint16_t)(taxa_q8 / 2);  // Incerteza inicial
+        s->amostras = 1;
+        return;
+    }
+    int32_t peso = s->amostras < EWMA_PESO ? s->amostras + 1 : EWMA_PESO;
+    int32_t erro = (int32_t)taxa_q8 - s->media;
+    int32_t erro_abs = erro < 0 ? -erro : erro;
+    s->media = (uint16_t)(s->media + erro / peso);
+    s->desvio = (uint16_t)(s->desvio + (erro_abs - s->desvio) / peso);
+    if (s->amostras < UINT8_MAX) {
+        s->amostras++;
+    }
+}
+
+static void fecha_trecho(agenda_t *ag, uint16_t nivel, uint32_t t_s) {
+    if (!ag->trecho_aberto) {
+        return;
+    }
+    if (ag->nivel_trecho_q8 > nivel) {
+        ag->consumo_q8 += ag->nivel_trecho_q8 - nivel;
+    }
+    ag->t_observado_s += t_s - ag->t_trecho_s;
+    ag->trecho_aberto = false;
+}
+
+static void inicia_hora(agenda_t *ag, uint8_t hora) {
+    ag->hora = hora;
+    ag->consumo_q8 = 0;
+    ag->t_observado_s = 0;
+    ag->trecho_aberto = false;
+    recalcula_reserva(ag);
+}
+
+void agenda_amostra(agenda_t *ag, uint32_t epoca_s, float nivel, bool bomba_ligada) {
+    uint16_t n = nivel_q8(nivel);
+    uint8_t hora = hora_da_semana(epoca_s, ag->fuso_s);
+
+    if (ag->hora < 0 || epoca_s < ag->t_ultima_s || epoca_s - ag->t_ultima_s > LACUNA_MAX_S) {
+        // Primeira hora, relógio ajustado para trás ou lacuna longa: recomeça
+        inicia_hora(ag, hora);
+    } else if (hora != ag->hora) {
+        fecha_trecho(ag, n, epoca_s);
+        if (ag->t_observado_s >= AGENDA_OBSERVACAO_MIN_S) {
+            aprende(&ag->slots[ag->hora], ag->consumo_q8 * 3600 / ag->t_observado_s);
+        }
+        inicia_hora(ag, hora);
+    }
+    ag->t_ultima_s = epoca_s;
+
+    if (bomba_ligada) {
+        fecha_trecho(ag, n, epoca_s);
+    } else if (!ag->trecho_aberto) {
+        ag->trecho_aberto = true;
+        ag->nivel_trecho_q8 = n;
+        ag->t_trecho_s = epoca_s;
+    }
+}
+
+float agenda_limite_minimo(const agenda_t *ag, float lim_min, float lim_max) {
+    float minimo = lim_min + (float)ag->reserva_q8 / Q8;
+    float teto = lim_max - AGENDA_FOLGA;
+    if (minimo > teto) {
+        minimo = teto;
+    }
+    return minimo > lim_min ? minimo : lim_min;
+}
+
+float agenda_reserva(const agenda_t *ag) {
+    return (float)ag->reserva_q8 / Q8;
+}
+
+uint8_t agenda_horas_aprendidas(const agenda_t *ag) {
+    uint8_t n = 0;
+    for (uint8_t h = 0; h < AGENDA_SLOTS; h++) {
+        n += ag->slots[h].amostras != 0;
+    }
+    return n;
+}
+
+// ===== Perfil na flash =====
+
+static uint8_t *escreve_u16(uint8_t *p, uint16_t v) {
+    p[0] = (uint8_t)v;
+    p[1] = (uint8_t)(v >> 8);
+    return p + 2;
+}
+
+static uint8_t *escreve_u32(uint8_t *p, uint32_t v) {
+    return escreve_u16(escreve_u16(p, (uint16_t)v), (uint16_t)(v >> 16));
+}
+
+static uint16_t le_u16(const uint8_t *p) {
+    return (uint16_t)(p[0] | (p[1] << 8));
+}
+
+static uint32_t le_u32(const uint8_t *p) {
+    return (uint32_t)le_u16(p) | ((uint32_t)le_u16(p + 2) << 16);
+}
+
+// CRC-32 (IEEE, refletido), bit a bit: roda só ao gravar e no boot
+static uint32_t crc32(const uint8_t *dados, uint32_t len) {
+    uint32_t crc = 0xFFFFFFFFu;
+    for (uint32_t i = 0; i < len; i++) {
+        crc ^= dados[i];
+        for (uint8_t b = 0; b < 8; b++) {
+            crc = (crc >> 1) ^ (0xEDB88320u & (0u - (crc & 1)));
+        }
+    }
+    return ~crc;
+}
+
+void agenda_perfil_serializa(const agenda_t *ag, uint8_t perfil[AGENDA_PERFIL_TAM]) {
+    uint8_t *p = escreve_u32(perfil, AGENDA_PERFIL_MAGICA);
+    p = escreve_u16(p, AGENDA_PERFIL_VERSAO);
+    p = escreve_u16(p, AGENDA_SLOTS);
+    p = escreve_u32(p, (uint32_t)ag->fuso_s);
+    for (uint8_t h = 0; h < AGENDA_SLOTS; h++) {
+        p = escreve_u16(p, ag->slots[h].media);
+        p = escreve_u16(p, ag->slots[h].desvio);
+        *p++ = ag->slots[h].amostras;
+    }
+    escreve_u32(p, crc32(perfil, (uint32_t)(p - perfil)));
+}
+
+bool agenda_perfil_carrega(agenda_t *ag, const uint8_t *perfil, uint32_t len) {
+    if (len < AGENDA_PERFIL_TAM || le_u32(perfil) != AGENDA_PERFIL_MAGICA ||
+        le_u16(perfil + 4) != AGENDA_PERFIL_VERSAO || le_u16(perfil + 6) != AGENDA_SLOTS ||
+        (int32_t)le_u32(perfil + 8) != ag->fuso_s ||
+        le_u32(perfil + AGENDA_PERFIL_TAM - 4) != crc32(perfil, AGENDA_PERFIL_TAM - 4)) {
+        return false;
+    }
+    const uint8_t *p = perfil + 12;
+    for (uint8_t h = 0; h < AGENDA_SLOTS; h++, p += 5) {
+        ag->slots[h].media = le_u16(p);
+        ag->slots[h].desvio = le_u16(p + 2);
+        ag->slots[h].amostras = p[4];
+    }
+    return true;
+}
@@ -0,0 +1,86 @@
+#ifndef AGENDA_H
+#define AGENDA_H
+
+#include <stdbool.h>
+#include <stdint.h>
+
+// Agenda por tarifa: aprende o consumo de água por hora da semana a partir
+// da queda do nível com a bomba desligada e, no fim das janelas de tarifa
+// barata, eleva o limite mínimo efetivo para guardar a demanda prevista até
+// a próxima janela barata. Nunca devolve um mínimo abaixo de lim_min. Não
+// depende do hardware: recebe a hora de parede (UTC) a cada amostra.
+
+#define AGENDA_SLOTS 168             // Horas da semana; 0 = domingo, 0h
+#define AGENDA_OBSERVACAO_MIN_S 1800 // Tempo sem bomba exigido para aprender a hora
+#define AGENDA_K_DESVIO 2            // Margem da previsão, em desvios médios
+#define AGENDA_FOLGA 5.0f            // Distância mínima (%) entre o mínimo efetivo e lim_max
+#define AGENDA_ANTECEDENCIA_H 3      // Horas baratas finais em que o pré-enchimento vale
+
+// Dias da semana em máscara (bit 0 = domingo)
+#define AGENDA_DIAS_UTEIS     0x3E
+#define AGENDA_FIM_DE_SEMANA  0x41
+#define AGENDA_TODOS_OS_DIAS  0x7F
+
+// Janela de tarifa barata em hora local; fim exclusivo. Se hora_fim for
+// menor que hora_inicio, a janela cobre o começo e o fim do mesmo dia.
+typedef struct {
+    uint8_t dias;
+    uint8_t hora_inicio;
+    uint8_t hora_fim;
+} agenda_janela_t;
+
+// Consumo de uma hora da semana em %/h, ponto fixo Q8.8, por médias móveis
+typedef struct {
+    uint16_t media;
+    uint16_t desvio;    // Média do desvio absoluto em relação à média
+    uint8_t amostras;   // Horas já aprendidas (satura em 255)
+} agenda_slot_t;
+
+typedef struct {
+    int32_t fuso_s;
+    uint8_t barata[(AGENDA_SLOTS + 7) / 8];  // Horas baratas, calculadas no init
+    agenda_slot_t slots[AGENDA_SLOTS];
+
+    // Hora em observação (-1 antes da primeira amostra com hora válida)
+    int16_t hora;
+    uint32_t t_ultima_s;
+    uint32_t consumo_q8;      // Queda acumulada (% Q8.8) nos trechos sem bomba
+    uint32_t t_observado_s;   // Duração desses trechos
+    bool trecho_aberto;
+    uint16_t nivel_trecho_q8;
+    uint32_t t_trecho_s;
+
+    uint16_t reserva_q8;      // Pré-enchimento da hora atual (% Q8.8)
+} agenda_t;
+
+// Tarifa branca (UTC-3), usada pelo firmware e pelo reprodutor
+#define AGENDA_FUSO_PADRAO_S (-3 * 3600)
+extern const agenda_janela_t agenda_tarifa_branca[];
+extern const uint8_t agenda_tarifa_branca_num;
+
+void agenda_init(agenda_t *ag, const agenda_janela_t *baratas, uint8_t num_baratas, int32_t fuso_s);
+// Alimenta o aprendizado e recalcula a reserva ao mudar de hora
+void agenda_amostra(agenda_t *ag, uint32_t epoca_s, float nivel, bool bomba_ligada);
+// Limite mínimo efetivo para controle_decide: lim_min + reserva, limitado
+// a lim_max - AGENDA_FOLGA e nunca abaixo de lim_min
+float agenda_limite_minimo(const agenda_t *ag, float lim_min, float lim_max);
+
+bool agenda_hora_barata(const agenda_t *ag, uint8_t hora_semana);
+// Consumo previsto (%/h) para a hora da semana; 0 se ainda não aprendida
+float agenda_previsao(const agenda_t *ag, uint8_t hora_semana);
+float agenda_reserva(const agenda_t *ag);
+uint8_t agenda_horas_aprendidas(const agenda_t *ag);
+
+// Perfil aprendido para a flash, em little-endian: mágica, versão, número de
+// horas e fuso, os slots (média, desvio e amostras) e o CRC-32 de tudo antes
+// dele. Suba a versão quando o significado dos slots mudar.
+#define AGENDA_PERFIL_MAGICA 0x31444741  // "AGD1"
+#define AGENDA_PERFIL_VERSAO 1
+#define AGENDA_PERFIL_TAM (12 + AGENDA_SLOTS * 5 + 4)
+
+void agenda_perfil_serializa(const agenda_t *ag, uint8_t perfil[AGENDA_PERFIL_TAM]);
+// Restaura os slots de um perfil gravado; falso (e agenda intacta) se a
+// mágica, a versão, o fuso ou o CRC não conferem, como numa flash apagada
+bool agenda_perfil_carrega(agenda_t *ag, const uint8_t *perfil, uint32_t len);
+
+#endif // AGENDA_H
@@ -0,0 +1,139 @@
+#include <stddef.h>
+
+#include "alarme.h"
+
+// Padrões padrão: bipes lentos para nível, rápidos e agudos para falhas
+static const alarme_passo_t PADRAO_BAIXO[] = {
+    {1000, 250}, {0, 750}
+};
+static const alarme_passo_t PADRAO_ALTO[] = {
+    {2000, 250}, {0, 250}, {2000, 250}, {0, 1250}
+};
+static const alarme_passo_t PADRAO_FALHA_SENSOR[] = {
+    {1500, 100}, {0, 100}, {1500, 100}, {0, 100}, {1500, 100}, {0, 500}
+};
+static const alarme_passo_t PADRAO_SECO[] = {
+    {3000, 150}, {2000, 150}
+};
+
+static alarme_padrao_t padroes[ALARME_NUM_CLASSES];
+
+static volatile uint32_t ativos = 0;       // Bit por classe ativa
+static volatile uint32_t reconhecidos = 0; // Bit por classe silenciada pelo usuário
+static uint32_t disparos[ALARME_NUM_CLASSES];
+
+// Estado do sequenciador (alterado apenas em alarme_tick)
+static volatile alarme_classe_t classe_atual = ALARME_NENHUM;
+static uint8_t passo_atual = 0;
+static uint32_t inicio_passo_ms = 0;
+
+void alarme_init(void) {
+    alarme_define_padrao(ALARME_NIVEL_BAIXO, PADRAO_BAIXO, sizeof(PADRAO_BAIXO) / sizeof(PADRAO_BAIXO[0]), 1);
+    alarme_define_padrao(ALARME_NIVEL_ALTO, PADRAO_ALTO, sizeof(PADRAO_ALTO) / sizeof(PADRAO_ALTO[0]), 2);
+    alarme_define_padrao(ALARME_FALHA_SENSOR, PADRAO_FALHA_SENSOR, sizeof(PADRAO_FALHA_SENSOR) / sizeof(PADRAO_FALHA_SENSOR[0]), 3);
+    alarme_define_padrao(ALARME_BOMBA_SECO, PADRAO_SECO, sizeof(PADRAO_SECO) / sizeof(PADRAO_SECO[0]), 4);
+    ativos = 0;
+    reconhecidos = 0;
+    classe_atual = ALARME_NENHUM;
+    for (int i = 0; i < ALARME_NUM_CLASSES; i++) {
+        disparos[i] = 0;
+    }
+}
+
+void alarme_define_padrao(alarme_classe_t classe, const alarme_passo_t *passos, uint8_t num_passos, uint8_t prioridade) {
+    if (classe >= ALARME_NUM_CLASSES) {
+        return;
+    }
+    padroes[classe].passos = passos;
+    padroes[classe].num_passos = num_passos;
+    padroes[classe].prioridade = prioridade;
+}
+
+// Ativa ou limpa uma classe; ao limpar, o reconhecimento também é descartado
+void alarme_ativa(alarme_classe_t classe, bool ativo) {
+    uint32_t bit = 1u << classe;
+    if (ativo) {
+        if (!(ativos & bit)) {
+            disparos[classe]++;
+            ativos |= bit;
+        }
+    } else {
+        ativos &= ~bit;
+        reconhecidos &= ~bit;
+    }
+}
+
+// Silencia todos os alarmes ativos até que sejam limpos e disparem de novo
+void alarme_reconhece(void) {
+    reconhecidos |= ativos;
+}
+
+// Classe ativa e não reconhecida de maior prioridade
+static alarme_classe_t seleciona_classe(void) {
+    uint32_t pendentes = ativos & ~reconhecidos;
+    alarme_classe_t escolhida = ALARME_NENHUM;
+    for (int i = 0; i < ALARME_NUM_CLASSES; i++) {
+        if ((pendentes & (1u << i)) && padroes[i].num_passos &&
+            (escolhida == ALARME_NENHUM || padroes[i].prioridade > padroes[escolhida].prioridade)) {
+            escolhida = (alarme_classe_t)i;
+        }
+    }
+    return escolhida;
+}
+
+/**
+ * Avança o sequenciador até agora_ms e retorna a frequência a tocar (0 = mudo).
+ * Independe do hardware: o relógio é fornecido pelo chamador.
+ */
+uint16_t alarme_tick(uint32_t agora_ms) {
+    alarme_classe_t classe = seleciona_classe();
+    if (classe != classe_atual) {
+        classe_atual = classe;
+        passo_atual = 0;
+        inicio_passo_ms = agora_ms;
+    }
+    if (classe == ALARME_NENHUM) {
+        return 0;
+    }
+
+    const alarme_padrao_t *padrao = &padroes[classe];
+    while (agora_ms - inicio_passo_ms >= padrao->passos[passo_atual].duracao_ms) {
+        inicio_passo_ms += padrao->passos[passo_atual].duracao_ms;
+        passo_atual = (passo_atual + 1) % padrao->num_passos;
+    }
+    return padrao->passos[passo_atual].freq_hz;
+}
+
+bool alarme_ativo(alarme_classe_t classe) {
+    return (ativos >> classe) & 1u;
+}
+
+bool alarme_soando(void) {
+    return (ativos & ~reconhecidos) != 0;
+}
+
+// Alarme de maior prioridade ativo, mesmo que silenciado
+alarme_classe_t alarme_classe_atual(void) {
+    alarme_classe_t escolhida = ALARME_NENHUM;
+    for (int i = 0; i < ALARME_NUM_CLASSES; i++) {
+        if ((ativos & (1u << i)) &&
+            (escolhida == ALARME_NENHUM || padroes[i].prioridade > padroes[escolhida].prioridade)) {
+            escolhida = (alarme_classe_t)i;
+        }
+    }
+    return escolhida;
+}
+
+const char *alarme_nome(alarme_classe_t classe) {
+    switch (classe) {
+        case ALARME_NIVEL_BAIXO:  return "nivel_baixo";
+        case ALARME_NIVEL_ALTO:   return "nivel_alto";
+        case ALARME_FALHA_SENSOR: return "falha_sensor";
+        case ALARME_BOMBA_SECO:   return "bomba_seco";
+        default:                  return "nenhum";
+    }
+}
+
+uint32_t alarme_disparos(alarme_classe_t classe) {
+    return classe < ALARME_NUM_CLASSES ? disparos[classe] : 0;
+}
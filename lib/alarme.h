@@ -0,0 +1,43 @@
+#ifndef ALARME_H
+#define ALARME_H
+
+#include <stdbool.h>
+#include <stdint.h>
+
+// Classes de alarme; a ordem não define prioridade (ver alarme_padrao_t)
+typedef enum {
+    ALARME_NIVEL_BAIXO,
+    ALARME_NIVEL_ALTO,
+    ALARME_FALHA_SENSOR,
+    ALARME_BOMBA_SECO,
+    ALARME_NUM_CLASSES
+} alarme_classe_t;
+
+#define ALARME_NENHUM ALARME_NUM_CLASSES
+
+// Um passo do padrão sonoro: frequência em Hz (0 = silêncio) por duracao_ms (> 0)
+typedef struct {
+    uint16_t freq_hz;
+    uint16_t duracao_ms;
+} alarme_passo_t;
+
+// Padrão sonoro repetido enquanto a classe estiver ativa e não reconhecida
+typedef struct {
+    const alarme_passo_t *passos;
+    uint8_t num_passos;
+    uint8_t prioridade;   // Maior valor vence quando há mais de um alarme ativo
+} alarme_padrao_t;
+
+void alarme_init(void);
+void alarme_define_padrao(alarme_classe_t classe, const alarme_passo_t *passos, uint8_t num_passos, uint8_t prioridade);
+void alarme_ativa(alarme_classe_t classe, bool ativo);
+void alarme_reconhece(void);
+uint16_t alarme_tick(uint32_t agora_ms);
+
+bool alarme_ativo(alarme_classe_t classe);
+bool alarme_soando(void);
+alarme_classe_t alarme_classe_atual(void);
+const char *alarme_nome(alarme_classe_t classe);
+uint32_t alarme_disparos(alarme_classe_t classe);
+
+#endif // ALARME_H
@@ -0,0 +1,45 @@
+#include "controle.h"
+#include "alarme.h"
+#include "diagnostico.h"
+
+float controle_nivel_percentual(uint16_t adc) {
+    float volume = 1.5f + (6.3f * ((float)(adc - CONTROLE_ADC_VAZIO) /
+                                   (float)(CONTROLE_ADC_CHEIO - CONTROLE_ADC_VAZIO)));
+    float nivel = ((volume - 1.5f) / 6.3f) * 100;
+    return nivel < 0.0f ? 0.0f : (nivel > 100.0f ? 100.0f : nivel);
+}
+
+bool controle_decide(bool bomba_ligada, float nivel, float lim_min, float lim_max, bool estado_seguro) {
+    if (estado_seguro) {
+        return false;
+    }
+    if (nivel < lim_min) {
+        return true;
+    }
+    if (nivel > lim_max) {
+        return false;
+    }
+    return bomba_ligada;
+}
+
+bool controle_amostra(controle_t *c, agenda_t *ag, uint32_t agora_ms, uint16_t adc,
+                      const uint32_t *epoca_s, float lim_min, float lim_max) {
+    c->nivel = controle_nivel_percentual(adc);
+    c->falhas = diagnostico_avalia(agora_ms, adc, c->nivel, c->bomba_ligada);
+    bool seguro = diagnostico_estado_seguro();
+    if (!seguro && epoca_s) {
+        agenda_amostra(ag, *epoca_s, c->nivel, c->bomba_ligada);
+    }
+    c->lim_min_efetivo = agenda_limite_minimo(ag, lim_min, lim_max);
+    bool ligar = controle_decide(c->bomba_ligada, c->nivel, c->lim_min_efetivo, lim_max, seguro);
+    if (ligar == c->bomba_ligada) {
+        return false;
+    }
+    c->bomba_ligada = ligar;
+    return true;
+}
+
+void controle_reconhece(void) {
+    alarme_reconhece();
+    diagnostico_rearma();
+}
@@ -0,0 +1,52 @@
+#ifndef CONTROLE_H
+#define CONTROLE_H
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#include "agenda.h"
+
+// Passo de controle (conversão, diagnóstico, agenda e decisão da bomba), sem
+// dependência do hardware: o firmware e o reprodutor de gravações
+// (tools/reproduz.c) usam exatamente este código.
+
+// Calibração do sensor: leitura com o reservatório vazio e cheio
+#define CONTROLE_ADC_VAZIO 2680
+#define CONTROLE_ADC_CHEIO 2040
+
+// Formato das gravações (.nvl, little-endian): cabeçalho "NVL1" + instante da
+// primeira amostra (uint32, ms), seguido de amostras de 4 bytes: intervalo
+// desde a anterior (uint16, ms) e leitura do ADC (uint16). Intervalos maiores
+// que 65535 ms são quebrados em amostras com leitura CONTROLE_NVL_LACUNA; um
+// reconhecimento do operador é um registro com leitura CONTROLE_NVL_RECONHECE,
+// aplicado antes da amostra seguinte. No log da USB ele é a linha "NVL ACK <ms>".
+#define CONTROLE_NVL_ASSINATURA "NVL1"
+#define CONTROLE_NVL_LACUNA     0xFFFF
+#define CONTROLE_NVL_RECONHECE  0xFFFE
+
+// Estado do controle entre amostras
+typedef struct {
+    float nivel;
+    bool bomba_ligada;
+    float lim_min_efetivo;  // lim_min elevado pela agenda de tarifas
+    uint32_t falhas;        // Máscara do diagnóstico na última amostra
+} controle_t;
+
+// Nível em % (0 a 100) correspondente a uma leitura do ADC
+float controle_nivel_percentual(uint16_t adc);
+
+// Novo estado da bomba dada a histerese entre os limites; em estado seguro
+// (falha diagnosticada) a bomba é sempre desligada
+bool controle_decide(bool bomba_ligada, float nivel, float lim_min, float lim_max, bool estado_seguro);
+
+/**
+ * Uma amostra, na ordem do laço principal: nível, diagnóstico, aprendizado da
+ * agenda (só com hora de parede em `epoca_s` e sem falha), mínimo efetivo e
+ * decisão. Retorna true se a bomba mudou de estado.
+ */
+bool controle_amostra(controle_t *c, agenda_t *ag, uint32_t agora_ms, uint16_t adc,
+                      const uint32_t *epoca_s, float lim_min, float lim_max);
+// Reconhecimento pelo operador (botão A ou web): cala o alarme e rearma o diagnóstico
+void controle_reconhece(void);
+
+#endif // CONTROLE_H
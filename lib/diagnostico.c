@@ -0,0 +1,137 @@
+#include <stddef.h>
+
+#include "diagnostico.h"
+
+// Valores padrão para a calibração do sensor em main.c (2680 = vazio, 2040 = cheio)
+static const diagnostico_config_t CONFIG_PADRAO = {
+    .adc_min = 1840,
+    .adc_max = 2880,
+    .tolerancia_estagnado = 2,      // Ruído de ±1 LSB entre leituras
+    .janela_estagnado_ms = 300000,
+    .janela_ruido_ms = 3600000,     // Mais que uma madrugada de consumo baixo leva para passar de 2 LSB
+    .taxa_max = 10.0f,
+    .retencao_taxa_ms = 5000,
+    .janela_seco_ms = 60000,
+    .subida_min = 2.0f,
+};
+
+static diagnostico_config_t config;
+static diagnostico_metricas_t metricas;
+static uint32_t falhas = 0;
+
+static bool primeira_amostra = true;
+static uint32_t t_anterior_ms = 0;
+static float nivel_anterior = 0;
+
+// Referências para detectar estagnação: a última leitura diferente e a última
+// que saiu da faixa de ruído
+static uint16_t adc_anterior = 0;
+static uint32_t t_mudanca_ms = 0;
+static uint16_t adc_referencia = 0;
+static uint32_t t_referencia_ms = 0;
+static uint32_t t_ultimo_salto_ms = 0;
+
+static bool bomba_anterior = false;
+static uint32_t t_inicio_janela_seco_ms = 0;
+static float nivel_inicio_janela_seco = 0;
+
+static void registra(uint32_t falha, uint32_t agora_ms, uint32_t *t_deteccao) {
+    if (!(falhas & falha)) {
+        *t_deteccao = agora_ms;
+        metricas.deteccoes++;
+    }
+    falhas |= falha;
+}
+
+void diagnostico_init(const diagnostico_config_t *cfg) {
+    config = cfg ? *cfg : CONFIG_PADRAO;
+    falhas = 0;
+    primeira_amostra = true;
+    bomba_anterior = false;
+    metricas = (diagnostico_metricas_t){0};
+}
+
+/**
+ * Avalia uma nova amostra e retorna a máscara de falhas ativas.
+ * O relógio é fornecido pelo chamador, permitindo simular o tempo.
+ */
+uint32_t diagnostico_avalia(uint32_t agora_ms, uint16_t adc, float nivel, bool bomba_ligada) {
+    // Faixa física do sensor
+    if (adc < config.adc_min || adc > config.adc_max) {
+        registra(DIAG_FORA_FAIXA, agora_ms, &metricas.t_fora_faixa_ms);
+    } else {
+        falhas &= ~DIAG_FORA_FAIXA;
+    }
+
+    if (primeira_amostra) {
+        primeira_amostra = false;
+        adc_anterior = adc_referencia = adc;
+        t_mudanca_ms = t_referencia_ms = agora_ms;
+    } else {
+        // Sensor travado: leitura idêntica por janela_estagnado_ms, ou presa na
+        // faixa de ruído por janela_ruido_ms (em curto, ou travado num ADC
+        // vivo). A segunda janela é longa porque um reservatório parado também
+        // fica nessa faixa enquanto o consumo é baixo.
+        if (adc != adc_anterior) {
+            adc_anterior = adc;
+            t_mudanca_ms = agora_ms;
+        }
+        int delta_adc = (int)adc - (int)adc_referencia;
+        if (delta_adc > config.tolerancia_estagnado || -delta_adc > config.tolerancia_estagnado) {
+            adc_referencia = adc;
+            t_referencia_ms = agora_ms;
+            falhas &= ~DIAG_ESTAGNADO;
+        } else if (agora_ms - t_mudanca_ms >= config.janela_estagnado_ms ||
+                   agora_ms - t_referencia_ms >= config.janela_ruido_ms) {
+            registra(DIAG_ESTAGNADO, agora_ms, &metricas.t_estagnado_ms);
+        }
+
+        // Taxa de variação implausível
+        uint32_t dt_ms = agora_ms - t_anterior_ms;
+        float delta_nivel = nivel - nivel_anterior;
+        if (delta_nivel < 0) {
+            delta_nivel = -delta_nivel;
+        }
+        if (dt_ms > 0 && delta_nivel * 1000.0f > config.taxa_max * (float)dt_ms) {
+            t_ultimo_salto_ms = agora_ms;
+            registra(DIAG_TAXA, agora_ms, &metricas.t_taxa_ms);
+        } else if ((falhas & DIAG_TAXA) && agora_ms - t_ultimo_salto_ms >= config.retencao_taxa_ms) {
+            falhas &= ~DIAG_TAXA;
+        }
+    }
+
+    // Funcionamento a seco: bomba ligada sem subida mínima dentro da janela
+    if (bomba_ligada && !bomba_anterior) {
+        t_inicio_janela_seco_ms = agora_ms;
+        nivel_inicio_janela_seco = nivel;
+    } else if (bomba_ligada && agora_ms - t_inicio_janela_seco_ms >= config.janela_seco_ms) {
+        if (nivel - nivel_inicio_janela_seco < config.subida_min) {
+            registra(DIAG_BOMBA_SECO, agora_ms, &metricas.t_bomba_seco_ms);
+        }
+        t_inicio_janela_seco_ms = agora_ms;
+        nivel_inicio_janela_seco = nivel;
+    }
+
+    bomba_anterior = bomba_ligada;
+    t_anterior_ms = agora_ms;
+    nivel_anterior = nivel;
+    return falhas;
+}
+
+uint32_t diagnostico_falhas(void) {
+    return falhas;
+}
+
+// Com qualquer falha ativa a bomba deve permanecer desligada
+bool diagnostico_estado_seguro(void) {
+    return falhas != 0;
+}
+
+// Libera o travamento de funcionamento a seco após reconhecimento do operador
+void diagnostico_rearma(void) {
+    falhas &= ~DIAG_BOMBA_SECO;
+}
+
+const diagnostico_metricas_t *diagnostico_metricas(void) {
+    return &metricas;
+}
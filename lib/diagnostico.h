@@ -0,0 +1,43 @@
+#ifndef DIAGNOSTICO_H
+#define DIAGNOSTICO_H
+
+#include <stdbool.h>
+#include <stdint.h>
+
+// Falhas detectadas (máscara de bits)
+#define DIAG_FORA_FAIXA   (1u << 0)  // Leitura do ADC fora da faixa física do sensor
+#define DIAG_ESTAGNADO    (1u << 1)  // Leitura parada (idêntica ou só com ruído) por tempo demais
+#define DIAG_TAXA         (1u << 2)  // Variação de nível fisicamente impossível
+#define DIAG_BOMBA_SECO   (1u << 3)  // Bomba ligada sem subida de nível (travado até rearme)
+
+#define DIAG_FALHAS_SENSOR (DIAG_FORA_FAIXA | DIAG_ESTAGNADO | DIAG_TAXA)
+
+typedef struct {
+    uint16_t adc_min;              // Menor leitura plausível do sensor
+    uint16_t adc_max;              // Maior leitura plausível do sensor
+    uint16_t tolerancia_estagnado; // Variação (LSB) em torno da referência tratada como ruído
+    uint32_t janela_estagnado_ms;  // Leitura idêntica por este tempo: sensor travado
+    uint32_t janela_ruido_ms;      // Leitura só dentro da tolerância por este tempo: travado com ruído
+    float taxa_max;                // Variação máxima de nível aceitável (%/s)
+    uint32_t retencao_taxa_ms;     // Tempo que a falha de taxa permanece após o último salto
+    uint32_t janela_seco_ms;       // Tempo de bomba ligada para avaliar a subida
+    float subida_min;              // Subida mínima de nível (%) dentro da janela
+} diagnostico_config_t;
+
+// Tempos de detecção de cada falha (ms desde o boot; 0 = nunca detectada)
+typedef struct {
+    uint32_t t_fora_faixa_ms;
+    uint32_t t_estagnado_ms;
+    uint32_t t_taxa_ms;
+    uint32_t t_bomba_seco_ms;
+    uint32_t deteccoes;
+} diagnostico_metricas_t;
+
+void diagnostico_init(const diagnostico_config_t *cfg);
+uint32_t diagnostico_avalia(uint32_t agora_ms, uint16_t adc, float nivel, bool bomba_ligada);
+uint32_t diagnostico_falhas(void);
+bool diagnostico_estado_seguro(void);
+void diagnostico_rearma(void);
+const diagnostico_metricas_t *diagnostico_metricas(void);
+
+#endif // DIAGNOSTICO_H
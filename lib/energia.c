@@ -0,0 +1,104 @@
+#include "pico/stdlib.h"
+#include "hardware/clocks.h"
+#include "hardware/sync.h"
+
+#include "energia.h"
+
+#ifndef SYS_CLK_KHZ
+#define SYS_CLK_KHZ 125000
+#endif
+
+#define ENERGIA_PRAZO_MAX_MS 1000   // Teto da espera quando ninguém propõe prazo
+
+static energia_metricas_t metricas;
+static uint32_t inatividade_ms;
+static volatile uint32_t ultima_atividade_ms = 0;
+static volatile bool acordar = false;
+static bool apagada = false;
+static bool clock_reduzido = false;
+static bool prazo_definido = false;
+static uint32_t proximo_prazo_ms = 0;
+static uint64_t fim_espera_us = 0;
+
+void energia_init(uint32_t inatividade) {
+    inatividade_ms = inatividade;
+    ultima_atividade_ms = to_ms_since_boot(get_absolute_time());
+    fim_espera_us = time_us_64();
+}
+
+void energia_atividade(void) {
+    ultima_atividade_ms = to_ms_since_boot(get_absolute_time());
+    acordar = true;
+    __sev();
+}
+
+void energia_acorda(void) {
+    acordar = true;
+    __sev();
+}
+
+bool energia_interface_ativa(uint32_t agora_ms) {
+    bool ativa = agora_ms - ultima_atividade_ms < inatividade_ms;
+    if (!ativa && !apagada) {
+        metricas.apagamentos++;
+    }
+    apagada = !ativa;
+    return ativa;
+}
+
+void energia_prazo(uint32_t prazo_ms) {
+    if (!prazo_definido || (int32_t)(prazo_ms - proximo_prazo_ms) < 0) {
+        proximo_prazo_ms = prazo_ms;
+        prazo_definido = true;
+    }
+}
+
+void energia_dorme(void) {
+    uint64_t inicio_us = time_us_64();
+    metricas.ciclos++;
+    metricas.us_ativo += inicio_us - fim_espera_us;
+
+    uint32_t agora_ms = (uint32_t)(inicio_us / 1000);
+    int32_t falta_ms = prazo_definido ? (int32_t)(proximo_prazo_ms - agora_ms) : ENERGIA_PRAZO_MAX_MS;
+    prazo_definido = false;
+
+    // Um acordar pedido enquanto o laço trabalhava fica pendente até aqui: não
+    // dorme e só o consome depois da espera, para não perder o aviso
+    if (falta_ms > 0 && !acordar) {
+        absolute_time_t fim = make_timeout_time_ms(falta_ms);
+        // Qualquer IRQ tira o núcleo do WFE; volta a dormir até o prazo,
+        // a menos que tenha sido uma interação local
+        bool venceu;
+        do {
+            venceu = best_effort_wfe_or_timeout(fim);
+            metricas.despertares++;
+        } while (!venceu && !acordar);
+    }
+    acordar = false;
+
+    fim_espera_us = time_us_64();
+    metricas.us_dormindo += fim_espera_us - inicio_us;
+}
+
+bool energia_clock_reduzido(bool reduzido) {
+    if (reduzido == clock_reduzido) {
+        return false;
+    }
+    if (reduzido) {
+        set_sys_clock_48mhz();
+    } else {
+        set_sys_clock_khz(SYS_CLK_KHZ, true);
+    }
+    clock_reduzido = reduzido;
+    metricas.trocas_clock++;
+    return true;
+}
+
+uint32_t energia_ciclo_trabalho_pm(void) {
+    uint64_t total = metricas.us_ativo + metricas.us_dormindo;
+    return total ? (uint32_t)(metricas.us_ativo * 1000 / total) : 1000;
+}
+
+const energia_metricas_t *energia_metricas(void) {
+    return &metricas;
+}
@@ -0,0 +1,39 @@
+#ifndef ENERGIA_H
+#define ENERGIA_H
+
+#include <stdbool.h>
+#include <stdint.h>
+
+// Gerência de energia: o laço principal propõe prazos e dorme (WFE) até o
+// menor deles; a interface local é apagada após um tempo sem interação.
+
+// Contadores para estimar a corrente média (tempos em us)
+typedef struct {
+    uint32_t ciclos;          // Iterações do laço principal
+    uint32_t despertares;     // Retornos do WFE (timer, botões, rede, USB)
+    uint32_t apagamentos;     // Vezes que a interface foi apagada por inatividade
+    uint32_t trocas_clock;    // Mudanças de clk_sys
+    uint64_t us_ativo;        // Tempo executando entre uma espera e outra
+    uint64_t us_dormindo;     // Tempo dentro de energia_dorme
+} energia_metricas_t;
+
+void energia_init(uint32_t inatividade_ms);
+// Registra interação local; segura em contexto de IRQ (botões)
+void energia_atividade(void);
+// Encerra a espera atual (ou a próxima, se chamada fora dela) sem contar como
+// interação; segura em contexto de IRQ
+void energia_acorda(void);
+// false depois de inatividade_ms sem energia_atividade
+bool energia_interface_ativa(uint32_t agora_ms);
+// Propõe um prazo (ms desde o boot) para a próxima iteração; vale o menor
+void energia_prazo(uint32_t prazo_ms);
+// Dorme até o menor prazo proposto ou até uma nova atividade
+void energia_dorme(void);
+// Troca clk_sys entre o nominal e 48 MHz (PLL USB, PLL do sistema desligado);
+// retorna true se mudou e os periféricos dependentes precisam ser ajustados
+bool energia_clock_reduzido(bool reduzido);
+// Fração do tempo acordado, em milésimos
+uint32_t energia_ciclo_trabalho_pm(void);
+const energia_metricas_t *energia_metricas(void);
+
+#endif // ENERGIA_H
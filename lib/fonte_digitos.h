@@ -0,0 +1,271 @@
+// Gerado por tools/gera_fonte.py a partir de DejaVuSans-Bold.ttf. Não editar à mão.
+#ifndef FONTE_DIGITOS_H
+#define FONTE_DIGITOS_H
+
+#include "texto.h"
+
+static const uint8_t fonte_digitos_bitmap[] = {
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x3C, 0x00, 0x7E, 0x00, 0xE7, 0x00, 0xC3, 0x00, 0xC3, 0x40, 0xE7, 0x70, 0x7E, 0x3C, 0x3C, 0x1E,
+    0x80, 0x07, 0xC0, 0x01, 0xF0, 0x00, 0x3C, 0x1E, 0x1E, 0x3F, 0x87, 0x73, 0x81, 0x61, 0x80, 0x61,
+    0x80, 0x73, 0x00, 0x3F, 0x00, 0x1E, 0x00, 0x00, 0x00, 0x07, 0x00, 0x07, 0x00, 0x07, 0x00, 0x07,
+    0x00, 0x07, 0x00, 0x07, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x78, 0x00, 0x78, 0x00, 0x78,
+    0x00, 0x78, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0xF0, 0x07, 0xFC, 0x1F, 0xFE, 0x3F, 0xFF, 0x7F,
+    0x07, 0x70, 0x03, 0x60, 0x03, 0x60, 0x07, 0x70, 0xFF, 0x7F, 0xFE, 0x3F, 0xFC, 0x1F, 0xF0, 0x07,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x06, 0x60, 0x07, 0x60, 0x03, 0x60, 0xFF, 0x7F,
+    0xFF, 0x7F, 0xFF, 0x7F, 0xFF, 0x7F, 0x00, 0x60, 0x00, 0x60, 0x00, 0x60, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x0E, 0x60, 0x06, 0x70, 0x03, 0x78, 0x03, 0x7C, 0x03, 0x7E, 0x03, 0x7F, 0xC7, 0x6F,
+    0xFF, 0x67, 0xFE, 0x63, 0xFE, 0x63, 0xFC, 0x60, 0x00, 0x00, 0x00, 0x00, 0x06, 0x30, 0x03, 0x60,
+    0x03, 0x60, 0xC3, 0x60, 0xC3, 0x60, 0xC3, 0x60, 0xE7, 0x71, 0xFF, 0x7F, 0xFF, 0x3F, 0xBE, 0x3F,
+    0x1C, 0x1F, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x0F, 0xC0, 0x0F, 0xE0, 0x0D, 0x78, 0x0C,
+    0x3C, 0x0C, 0x0F, 0x0C, 0xFF, 0x7F, 0xFF, 0x7F, 0xFF, 0x7F, 0xFF, 0x7F, 0x00, 0x0C, 0x00, 0x0C,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x30, 0xFF, 0x60, 0x7F, 0x60, 0x7F, 0x60, 0x63, 0x60,
+    0x63, 0x60, 0xE3, 0x70, 0xE3, 0x7F, 0xC3, 0x3F, 0xC3, 0x3F, 0x00, 0x0F, 0x00, 0x00, 0x00, 0x00,
+    0xF0, 0x07, 0xF8, 0x1F, 0xFE, 0x3F, 0xFE, 0x7F, 0xCF, 0x70, 0x67, 0x60, 0x63, 0x60, 0xE3, 0x70,
+    0xE3, 0x7F, 0xC3, 0x3F, 0xC6, 0x1F, 0x80, 0x0F, 0x00, 0x00, 0x00, 0x00, 0x03, 0x00, 0x03, 0x40,
+    0x03, 0x78, 0x03, 0x7E, 0x83, 0x7F, 0xE3, 0x7F, 0xFF, 0x0F, 0xFF, 0x03, 0xFF, 0x00, 0x3F, 0x00,
+    0x07, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x1C, 0x1E, 0x3E, 0x3F, 0xFF, 0x3F, 0xFF, 0x7F,
+    0xE7, 0x71, 0xC3, 0x60, 0xC3, 0x60, 0xE7, 0x71, 0xFF, 0x7F, 0xFF, 0x3F, 0x3E, 0x3F, 0x1C, 0x1E,
+    0x00, 0x00, 0x00, 0x00, 0xF8, 0x00, 0xFC, 0x31, 0xFE, 0x61, 0xFF, 0x63, 0x87, 0x63, 0x03, 0x63,
+    0x03, 0x73, 0x87, 0x79, 0xFE, 0x3F, 0xFE, 0x3F, 0xFC, 0x0F, 0xF0, 0x07, 0x00, 0x00,
+};
+
+static const texto_glifo_t fonte_digitos_glifos[] = {
+    {    0,  7,  7},  // U+0020
+    {    0,  0,  0},  // U+0021 !
+    {    0,  0,  0},  // U+0022 "
+    {    0,  0,  0},  // U+0023 #
+    {    0,  0,  0},  // U+0024 $
+    {   14, 20, 20},  // U+0025 %
+    {    0,  0,  0},  // U+0026 &
+    {    0,  0,  0},  // U+0027 '
+    {    0,  0,  0},  // U+0028 (
+    {    0,  0,  0},  // U+0029 )
+    {    0,  0,  0},  // U+002A *
+    {    0,  0,  0},  // U+002B +
+    {    0,  0,  0},  // U+002C ,
+    {   54,  8,  8},  // U+002D -
+    {   70,  8,  8},  // U+002E .
+    {    0,  0,  0},  // U+002F /
+    {   86, 14, 14},  // U+0030 0
+    {  114, 14, 14},  // U+0031 1
+    {  142, 14, 14},  // U+0032 2
+    {  170, 14, 14},  // U+0033 3
+    {  198, 14, 14},  // U+0034 4
+    {  226, 14, 14},  // U+0035 5
+    {  254, 14, 14},  // U+0036 6
+    {  282, 14, 14},  // U+0037 7
+    {  310, 14, 14},  // U+0038 8
+    {  338, 14, 14},  // U+0039 9
+    {    0,  0,  0},  // U+003A :
+    {    0,  0,  0},  // U+003B ;
+    {    0,  0,  0},  // U+003C <
+    {    0,  0,  0},  // U+003D =
+    {    0,  0,  0},  // U+003E >
+    {    0,  0,  0},  // U+003F ?
+    {    0,  0,  0},  // U+0040 @
+    {    0,  0,  0},  // U+0041 A
+    {    0,  0,  0},  // U+0042 B
+    {    0,  0,  0},  // U+0043 C
+    {    0,  0,  0},  // U+0044 D
+    {    0,  0,  0},  // U+0045 E
+    {    0,  0,  0},  // U+0046 F
+    {    0,  0,  0},  // U+0047 G
+    {    0,  0,  0},  // U+0048 H
+    {    0,  0,  0},  // U+0049 I
+    {    0,  0,  0},  // U+004A J
+    {    0,  0,  0},  // U+004B K
+    {    0,  0,  0},  // U+004C L
+    {    0,  0,  0},  // U+004D M
+    {    0,  0,  0},  // U+004E N
+    {    0,  0,  0},  // U+004F O
+    {    0,  0,  0},  // U+0050 P
+    {    0,  0,  0},  // U+0051 Q
+    {    0,  0,  0},  // U+0052 R
+    {    0,  0,  0},  // U+0053 S
+    {    0,  0,  0},  // U+0054 T
+    {    0,  0,  0},  // U+0055 U
+    {    0,  0,  0},  // U+0056 V
+    {    0,  0,  0},  // U+0057 W
+    {    0,  0,  0},  // U+0058 X
+    {    0,  0,  0},  // U+0059 Y
+    {    0,  0,  0},  // U+005A Z
+    {    0,  0,  0},  // U+005B [
+    {    0,  0,  0},  // U+005C
+    {    0,  0,  0},  // U+005D ]
+    {    0,  0,  0},  // U+005E ^
+    {    0,  0,  0},  // U+005F _
+    {    0,  0,  0},  // U+0060 `
+    {    0,  0,  0},  // U+0061 a
+    {    0,  0,  0},  // U+0062 b
+    {    0,  0,  0},  // U+0063 c
+    {    0,  0,  0},  // U+0064 d
+    {    0,  0,  0},  // U+0065 e
+    {    0,  0,  0},  // U+0066 f
+    {    0,  0,  0},  // U+0067 g
+    {    0,  0,  0},  // U+0068 h
+    {    0,  0,  0},  // U+0069 i
+    {    0,  0,  0},  // U+006A j
+    {    0,  0,  0},  // U+006B k
+    {    0,  0,  0},  // U+006C l
+    {    0,  0,  0},  // U+006D m
+    {    0,  0,  0},  // U+006E n
+    {    0,  0,  0},  // U+006F o
+    {    0,  0,  0},  // U+0070 p
+    {    0,  0,  0},  // U+0071 q
+    {    0,  0,  0},  // U+0072 r
+    {    0,  0,  0},  // U+0073 s
+    {    0,  0,  0},  // U+0074 t
+    {    0,  0,  0},  // U+0075 u
+    {    0,  0,  0},  // U+0076 v
+    {    0,  0,  0},  // U+0077 w
+    {    0,  0,  0},  // U+0078 x
+    {    0,  0,  0},  // U+0079 y
+    {    0,  0,  0},  // U+007A z
+    {    0,  0,  0},  // U+007B {
+    {    0,  0,  0},  // U+007C |
+    {    0,  0,  0},  // U+007D }
+    {    0,  0,  0},  // U+007E ~
+    {    0,  0,  0},  // U+007F
+    {    0,  0,  0},  // U+0080
+    {    0,  0,  0},  // U+0081
+    {    0,  0,  0},  // U+0082
+    {    0,  0,  0},  // U+0083
+    {    0,  0,  0},  // U+0084
+    {    0,  0,  0},  // U+0085
+    {    0,  0,  0},  // U+0086
+    {    0,  0,  0},  // U+0087
+    {    0,  0,  0},  // U+0088
+    {    0,  0,  0},  // U+0089
+    {    0,  0,  0},  // U+008A
+    {    0,  0,  0},  // U+008B
+    {    0,  0,  0},  // U+008C
+    {    0,  0,  0},  // U+008D
+    {    0,  0,  0},  // U+008E
+    {    0,  0,  0},  // U+008F
+    {    0,  0,  0},  // U+0090
+    {    0,  0,  0},  // U+0091
+    {    0,  0,  0},  // U+0092
+    {    0,  0,  0},  // U+0093
+    {    0,  0,  0},  // U+0094
+    {    0,  0,  0},  // U+0095
+    {    0,  0,  0},  // U+0096
+    {    0,  0,  0},  // U+0097
+    {    0,  0,  0},  // U+0098
+    {    0,  0,  0},  // U+0099
+    {    0,  0,  0},  // U+009A
+    {    0,  0,  0},  // U+009B
+    {    0,  0,  0},  // U+009C
+    {    0,  0,  0},  // U+009D
+    {    0,  0,  0},  // U+009E
+    {    0,  0,  0},  // U+009F
+    {    0,  0,  0},  // U+00A0
+    {    0,  0,  0},  // U+00A1 ¡
+    {    0,  0,  0},  // U+00A2 ¢
+    {    0,  0,  0},  // U+00A3 £
+    {    0,  0,  0},  // U+00A4 ¤
+    {    0,  0,  0},  // U+00A5 ¥
+    {    0,  0,  0},  // U+00A6 ¦
+    {    0,  0,  0},  // U+00A7 §
+    {    0,  0,  0},  // U+00A8 ¨
+    {    0,  0,  0},  // U+00A9 ©
+    {    0,  0,  0},  // U+00AA ª
+    {    0,  0,  0},  // U+00AB «
+    {    0,  0,  0},  // U+00AC ¬
+    {    0,  0,  0},  // U+00AD ­
+    {    0,  0,  0},  // U+00AE ®
+    {    0,  0,  0},  // U+00AF ¯
+    {    0,  0,  0},  // U+00B0 °
+    {    0,  0,  0},  // U+00B1 ±
+    {    0,  0,  0},  // U+00B2 ²
+    {    0,  0,  0},  // U+00B3 ³
+    {    0,  0,  0},  // U+00B4 ´
+    {    0,  0,  0},  // U+00B5 µ
+    {    0,  0,  0},  // U+00B6 ¶
+    {    0,  0,  0},  // U+00B7 ·
+    {    0,  0,  0},  // U+00B8 ¸
+    {    0,  0,  0},  // U+00B9 ¹
+    {    0,  0,  0},  // U+00BA º
+    {    0,  0,  0},  // U+00BB »
+    {    0,  0,  0},  // U+00BC ¼
+    {    0,  0,  0},  // U+00BD ½
+    {    0,  0,  0},  // U+00BE ¾
+    {    0,  0,  0},  // U+00BF ¿
+    {    0,  0,  0},  // U+00C0 À
+    {    0,  0,  0},  // U+00C1 Á
+    {    0,  0,  0},  // U+00C2 Â
+    {    0,  0,  0},  // U+00C3 Ã
+    {    0,  0,  0},  // U+00C4 Ä
+    {    0,  0,  0},  // U+00C5 Å
+    {    0,  0,  0},  // U+00C6 Æ
+    {    0,  0,  0},  // U+00C7 Ç
+    {    0,  0,  0},  // U+00C8 È
+    {    0,  0,  0},  // U+00C9 É
+    {    0,  0,  0},  // U+00CA Ê
+    {    0,  0,  0},  // U+00CB Ë
+    {    0,  0,  0},  // U+00CC Ì
+    {    0,  0,  0},  // U+00CD Í
+    {    0,  0,  0},  // U+00CE Î
+    {    0,  0,  0},  // U+00CF Ï
+    {    0,  0,  0},  // U+00D0 Ð
+    {    0,  0,  0},  // U+00D1 Ñ
+    {    0,  0,  0},  // U+00D2 Ò
+    {    0,  0,  0},  // U+00D3 Ó
+    {    0,  0,  0},  // U+00D4 Ô
+    {    0,  0,  0},  // U+00D5 Õ
+    {    0,  0,  0},  // U+00D6 Ö
+    {    0,  0,  0},  // U+00D7 ×
+    {    0,  0,  0},  // U+00D8 Ø
+    {    0,  0,  0},  // U+00D9 Ù
+    {    0,  0,  0},  // U+00DA Ú
+    {    0,  0,  0},  // U+00DB Û
+    {    0,  0,  0},  // U+00DC Ü
+    {    0,  0,  0},  // U+00DD Ý
+    {    0,  0,  0},  // U+00DE Þ
+    {    0,  0,  0},  // U+00DF ß
+    {    0,  0,  0},  // U+00E0 à
+    {    0,  0,  0},  // U+00E1 á
+    {    0,  0,  0},  // U+00E2 â
+    {    0,  0,  0},  // U+00E3 ã
+    {    0,  0,  0},  // U+00E4 ä
+    {    0,  0,  0},  // U+00E5 å
+    {    0,  0,  0},  // U+00E6 æ
+    {    0,  0,  0},  // U+00E7 ç
+    {    0,  0,  0},  // U+00E8 è
+    {    0,  0,  0},  // U+00E9 é
+    {    0,  0,  0},  // U+00EA ê
+    {    0,  0,  0},  // U+00EB ë
+    {    0,  0,  0},  // U+00EC ì
+    {    0,  0,  0},  // U+00ED í
+    {    0,  0,  0},  // U+00EE î
+    {    0,  0,  0},  // U+00EF ï
+    {    0,  0,  0},  // U+00F0 ð
+    {    0,  0,  0},  // U+00F1 ñ
+    {    0,  0,  0},  // U+00F2 ò
+    {    0,  0,  0},  // U+00F3 ó
+    {    0,  0,  0},  // U+00F4 ô
+    {    0,  0,  0},  // U+00F5 õ
+    {    0,  0,  0},  // U+00F6 ö
+    {    0,  0,  0},  // U+00F7 ÷
+    {    0,  0,  0},  // U+00F8 ø
+    {    0,  0,  0},  // U+00F9 ù
+    {    0,  0,  0},  // U+00FA ú
+    {    0,  0,  0},  // U+00FB û
+    {    0,  0,  0},  // U+00FC ü
+    {    0,  0,  0},  // U+00FD ý
+    {    0,  0,  0},  // U+00FE þ
+    {    0,  0,  0},  // U+00FF ÿ
+};
+
+static const texto_fonte_t fonte_digitos = {
+    .altura = 15,
+    .paginas = 2,
+    .primeiro = 0x20,
+    .ultimo = 0xFF,
+    .glifos = fonte_digitos_glifos,
+    .bitmap = fonte_digitos_bitmap,
+    .kerning = 0,
+    .num_kerning = 0,
+};
+
+#endif // FONTE_DIGITOS_H
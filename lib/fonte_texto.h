@@ -0,0 +1,501 @@
+// Gerado por tools/gera_fonte.py a partir de lib/font.h. Não editar à mão.
+#ifndef FONTE_TEXTO_H
+#define FONTE_TEXTO_H
+
+#include "texto.h"
+
+static const uint8_t fonte_texto_bitmap[] = {
+    0xF8, 0x02, 0xF8, 0x02, 0x38, 0x00, 0x38, 0x00, 0x00, 0x00, 0x38, 0x00, 0x38, 0x00, 0xA0, 0x00,
+    0xF8, 0x03, 0xF8, 0x03, 0xA0, 0x00, 0xF8, 0x03, 0xF8, 0x03, 0xA0, 0x00, 0x20, 0x01, 0x70, 0x01,
+    0x50, 0x01, 0x58, 0x03, 0x58, 0x03, 0xD0, 0x01, 0x90, 0x00, 0x30, 0x02, 0x30, 0x03, 0x80, 0x01,
+    0xC0, 0x00, 0x60, 0x00, 0x30, 0x03, 0x10, 0x03, 0x80, 0x01, 0xD0, 0x03, 0x78, 0x02, 0xE8, 0x02,
+    0xB8, 0x01, 0xD0, 0x03, 0x40, 0x02, 0x20, 0x00, 0x38, 0x00, 0x18, 0x00, 0xE0, 0x00, 0xF0, 0x01,
+    0x18, 0x03, 0x08, 0x02, 0x08, 0x02, 0x18, 0x03, 0xF0, 0x01, 0xE0, 0x00, 0x40, 0x00, 0x50, 0x01,
+    0xF0, 0x01, 0xE0, 0x00, 0xE0, 0x00, 0xF0, 0x01, 0x50, 0x01, 0x40, 0x00, 0x40, 0x00, 0x40, 0x00,
+    0xF0, 0x01, 0xF0, 0x01, 0x40, 0x00, 0x40, 0x00, 0x00, 0x04, 0x00, 0x07, 0x00, 0x03, 0x40, 0x00,
+    0x40, 0x00, 0x40, 0x00, 0x40, 0x00, 0x40, 0x00, 0x40, 0x00, 0x00, 0x03, 0x00, 0x03, 0x00, 0x03,
+    0x80, 0x01, 0xC0, 0x00, 0x60, 0x00, 0x30, 0x00, 0x18, 0x00, 0x08, 0x00, 0xF0, 0x01, 0xF8, 0x03,
+    0xC8, 0x02, 0x68, 0x02, 0x38, 0x02, 0xF8, 0x03, 0xF0, 0x01, 0x00, 0x02, 0x10, 0x02, 0xF8, 0x03,
+    0xF8, 0x03, 0x00, 0x02, 0x00, 0x02, 0x90, 0x03, 0xD8, 0x03, 0x48, 0x02, 0x48, 0x02, 0x48, 0x02,
+    0x78, 0x02, 0x30, 0x02, 0x08, 0x02, 0x08, 0x02, 0x48, 0x02, 0x48, 0x02, 0x48, 0x02, 0xF8, 0x03,
+    0xB0, 0x01, 0xF0, 0x00, 0xF0, 0x00, 0x80, 0x00, 0x80, 0x00, 0xF8, 0x03, 0xF8, 0x03, 0x80, 0x00,
+    0x38, 0x01, 0x38, 0x03, 0x28, 0x02, 0x28, 0x02, 0x28, 0x02, 0xE8, 0x03, 0xC8, 0x01, 0xF0, 0x01,
+    0xF8, 0x03, 0x48, 0x02, 0x48, 0x02, 0x48, 0x02, 0xC8, 0x03, 0x80, 0x01, 0x08, 0x00, 0x08, 0x00,
+    0x08, 0x03, 0x88, 0x03, 0xC8, 0x00, 0x78, 0x00, 0x38, 0x00, 0xB0, 0x01, 0xF8, 0x03, 0x48, 0x02,
+    0x48, 0x02, 0x48, 0x02, 0xF8, 0x03, 0xB0, 0x01, 0x30, 0x00, 0x78, 0x02, 0x48, 0x02, 0x48, 0x02,
+    0x48, 0x02, 0xF8, 0x03, 0xF0, 0x01, 0x30, 0x03, 0x30, 0x03, 0x00, 0x04, 0x30, 0x07, 0x30, 0x03,
+    0x40, 0x00, 0xE0, 0x00, 0xB0, 0x01, 0x18, 0x03, 0x08, 0x02, 0xA0, 0x00, 0xA0, 0x00, 0xA0, 0x00,
+    0xA0, 0x00, 0xA0, 0x00, 0xA0, 0x00, 0x08, 0x02, 0x18, 0x03, 0xB0, 0x01, 0xE0, 0x00, 0x40, 0x00,
+    0x10, 0x00, 0x18, 0x00, 0xC8, 0x02, 0xE8, 0x02, 0x38, 0x00, 0x10, 0x00, 0xF0, 0x01, 0xF8, 0x03,
+    0x08, 0x02, 0xE8, 0x02, 0xE8, 0x02, 0xF8, 0x02, 0xF0, 0x02, 0xE0, 0x03, 0xF0, 0x03, 0x98, 0x00,
+    0x88, 0x00, 0x98, 0x00, 0xF0, 0x03, 0xE0, 0x03, 0xF8, 0x03, 0xF8, 0x03, 0x48, 0x02, 0x48, 0x02,
+    0x48, 0x02, 0xF8, 0x03, 0xB0, 0x01, 0xF0, 0x01, 0xF8, 0x03, 0x08, 0x02, 0x08, 0x02, 0x08, 0x02,
+    0x18, 0x03, 0x10, 0x01, 0xF8, 0x03, 0xF8, 0x03, 0x08, 0x02, 0x08, 0x02, 0x18, 0x03, 0xF0, 0x01,
+    0xE0, 0x00, 0xF8, 0x03, 0xF8, 0x03, 0x48, 0x02, 0x48, 0x02, 0x48, 0x02, 0x08, 0x02, 0x08, 0x02,
+    0xF8, 0x03, 0xF8, 0x03, 0x48, 0x00, 0x48, 0x00, 0x48, 0x00, 0x08, 0x00, 0x08, 0x00, 0xF0, 0x01,
+    0xF8, 0x03, 0x08, 0x02, 0x08, 0x02, 0x88, 0x02, 0x98, 0x03, 0x90, 0x01, 0xF8, 0x03, 0xF8, 0x03,
+    0x40, 0x00, 0x40, 0x00, 0x40, 0x00, 0xF8, 0x03, 0xF8, 0x03, 0x08, 0x02, 0x08, 0x02, 0xF8, 0x03,
+    0xF8, 0x03, 0x08, 0x02, 0x08, 0x02, 0x00, 0x01, 0x00, 0x03, 0x00, 0x02, 0x00, 0x02, 0x00, 0x02,
+    0xF8, 0x03, 0xF8, 0x01, 0xF8, 0x03, 0xF8, 0x03, 0x40, 0x00, 0xE0, 0x00, 0xB0, 0x01, 0x18, 0x03,
+    0x08, 0x02, 0xF8, 0x03, 0xF8, 0x03, 0x00, 0x02, 0x00, 0x02, 0x00, 0x02, 0x00, 0x02, 0x00, 0x02,
+    0xF8, 0x03, 0xF8, 0x03, 0x70, 0x00, 0xE0, 0x00, 0x70, 0x00, 0xF8, 0x03, 0xF8, 0x03, 0xF8, 0x03,
+    0xF8, 0x03, 0x30, 0x00, 0x60, 0x00, 0xC0, 0x00, 0xF8, 0x03, 0xF8, 0x03, 0xF0, 0x01, 0xF8, 0x03,
+    0x08, 0x02, 0x08, 0x02, 0x08, 0x02, 0xF8, 0x03, 0xF0, 0x01, 0xF8, 0x03, 0xF8, 0x03, 0x48, 0x00,
+    0x48, 0x00, 0x48, 0x00, 0x78, 0x00, 0x30, 0x00, 0xF0, 0x01, 0xF8, 0x03, 0x08, 0x02, 0x88, 0x03,
+    0x08, 0x03, 0xF8, 0x07, 0xF0, 0x05, 0xF8, 0x03, 0xF8, 0x03, 0x48, 0x00, 0xC8, 0x00, 0xC8, 0x01,
+    0x78, 0x03, 0x30, 0x02, 0x30, 0x01, 0x78, 0x03, 0x48, 0x02, 0x48, 0x02, 0x48, 0x02, 0xD8, 0x03,
+    0x90, 0x01, 0x08, 0x00, 0x08, 0x00, 0x08, 0x00, 0xF8, 0x03, 0xF8, 0x03, 0x08, 0x00, 0x08, 0x00,
+    0x08, 0x00, 0xF8, 0x03, 0xF8, 0x03, 0x00, 0x02, 0x00, 0x02, 0x00, 0x02, 0xF8, 0x03, 0xF8, 0x03,
+    0xF8, 0x00, 0xF8, 0x01, 0x00, 0x03, 0x00, 0x03, 0x00, 0x03, 0xF8, 0x01, 0xF8, 0x00, 0xF8, 0x01,
+    0xF8, 0x03, 0x00, 0x03, 0x80, 0x01, 0x00, 0x03, 0xF8, 0x03, 0xF8, 0x01, 0x18, 0x03, 0xB8, 0x03,
+    0xE0, 0x00, 0x40, 0x00, 0xE0, 0x00, 0xB8, 0x03, 0x18, 0x03, 0x38, 0x02, 0x78, 0x02, 0x40, 0x03,
+    0xC0, 0x01, 0xC0, 0x00, 0x78, 0x00, 0x38, 0x00, 0x08, 0x02, 0x08, 0x03, 0x88, 0x03, 0xC8, 0x02,
+    0x68, 0x02, 0x38, 0x02, 0x18, 0x02, 0xF8, 0x03, 0xF8, 0x03, 0x08, 0x02, 0x08, 0x02, 0x08, 0x00,
+    0x18, 0x00, 0x30, 0x00, 0x60, 0x00, 0xC0, 0x00, 0x80, 0x01, 0x00, 0x03, 0x08, 0x02, 0x08, 0x02,
+    0xF8, 0x03, 0xF8, 0x03, 0x40, 0x00, 0x60, 0x00, 0x30, 0x00, 0x18, 0x00, 0x30, 0x00, 0x60, 0x00,
+    0x40, 0x00, 0x00, 0x04, 0x00, 0x04, 0x00, 0x04, 0x00, 0x04, 0x00, 0x04, 0x00, 0x04, 0x00, 0x04,
+    0x00, 0x04, 0x18, 0x00, 0x38, 0x00, 0x20, 0x00, 0x00, 0x01, 0xA0, 0x03, 0xA0, 0x02, 0xA0, 0x02,
+    0xA0, 0x02, 0xE0, 0x03, 0xC0, 0x03, 0xF8, 0x03, 0xF8, 0x03, 0x40, 0x02, 0x40, 0x02, 0x40, 0x02,
+    0xC0, 0x03, 0x80, 0x01, 0xC0, 0x01, 0xE0, 0x03, 0x20, 0x02, 0x20, 0x02, 0x20, 0x02, 0x60, 0x03,
+    0x40, 0x01, 0x80, 0x01, 0xC0, 0x03, 0x40, 0x02, 0x40, 0x02, 0x40, 0x02, 0xF8, 0x03, 0xF8, 0x03,
+    0xC0, 0x01, 0xE0, 0x03, 0xA0, 0x02, 0xA0, 0x02, 0xA0, 0x02, 0xE0, 0x02, 0xC0, 0x00, 0x40, 0x02,
+    0xF0, 0x03, 0xF8, 0x03, 0x48, 0x02, 0x18, 0x00, 0x10, 0x00, 0xC0, 0x04, 0xE0, 0x05, 0x20, 0x05,
+    0x20, 0x05, 0x20, 0x05, 0xE0, 0x07, 0xE0, 0x03, 0xF8, 0x03, 0xF8, 0x03, 0x20, 0x00, 0x20, 0x00,
+    0x20, 0x00, 0xE0, 0x03, 0xC0, 0x03, 0x20, 0x02, 0xE8, 0x03, 0xE8, 0x03, 0x00, 0x02, 0x00, 0x02,
+    0x00, 0x06, 0x00, 0x04, 0x00, 0x04, 0x00, 0x04, 0xE8, 0x07, 0xE8, 0x03, 0xF8, 0x03, 0xF8, 0x03,
+    0x80, 0x00, 0xC0, 0x00, 0xE0, 0x01, 0x20, 0x03, 0x00, 0x02, 0x08, 0x02, 0xF8, 0x03, 0xF8, 0x03,
+    0x00, 0x02, 0xE0, 0x03, 0xE0, 0x03, 0xC0, 0x00, 0xC0, 0x03, 0xE0, 0x00, 0xE0, 0x03, 0xC0, 0x03,
+    0xE0, 0x03, 0xE0, 0x03, 0x20, 0x00, 0x20, 0x00, 0x20, 0x00, 0xE0, 0x03, 0xC0, 0x03, 0xC0, 0x01,
+    0xE0, 0x03, 0x20, 0x02, 0x20, 0x02, 0x20, 0x02, 0xE0, 0x03, 0xC0, 0x01, 0xE0, 0x07, 0xE0, 0x07,
+    0x20, 0x01, 0x20, 0x01, 0x20, 0x01, 0xE0, 0x01, 0xC0, 0x00, 0xC0, 0x00, 0xE0, 0x01, 0x20, 0x01,
+    0x20, 0x01, 0x20, 0x01, 0xE0, 0x07, 0xE0, 0x07, 0xE0, 0x03, 0xE0, 0x03, 0x20, 0x00, 0x20, 0x00,
+    0x20, 0x00, 0x60, 0x00, 0x40, 0x00, 0x40, 0x02, 0xE0, 0x02, 0xA0, 0x02, 0xA0, 0x02, 0xA0, 0x02,
+    0xA0, 0x03, 0x20, 0x01, 0x20, 0x00, 0x20, 0x00, 0xF8, 0x01, 0xF8, 0x03, 0x20, 0x02, 0x20, 0x02,
+    0xE0, 0x01, 0xE0, 0x03, 0x00, 0x02, 0x00, 0x02, 0x00, 0x02, 0xE0, 0x03, 0xE0, 0x03, 0xE0, 0x00,
+    0xE0, 0x01, 0x00, 0x03, 0x00, 0x03, 0x00, 0x03, 0xE0, 0x01, 0xE0, 0x00, 0xE0, 0x01, 0xE0, 0x03,
+    0x00, 0x03, 0x80, 0x01, 0x00, 0x03, 0xE0, 0x03, 0xE0, 0x01, 0x20, 0x02, 0x60, 0x03, 0xC0, 0x01,
+    0x80, 0x00, 0xC0, 0x01, 0x60, 0x03, 0x20, 0x02, 0xE0, 0x04, 0xE0, 0x05, 0x00, 0x05, 0x00, 0x05,
+    0x00, 0x05, 0xE0, 0x07, 0xE0, 0x03, 0x20, 0x02, 0x20, 0x03, 0xA0, 0x03, 0xA0, 0x02, 0xE0, 0x02,
+    0x60, 0x02, 0x20, 0x02, 0x40, 0x00, 0x40, 0x00, 0xF0, 0x01, 0xB8, 0x03, 0x08, 0x02, 0x08, 0x02,
+    0xB8, 0x03, 0xB8, 0x03, 0x08, 0x02, 0x08, 0x02, 0xB8, 0x03, 0xF0, 0x01, 0x40, 0x00, 0x40, 0x00,
+    0x10, 0x00, 0x18, 0x00, 0x08, 0x00, 0x18, 0x00, 0x10, 0x00, 0x18, 0x00, 0x08, 0x00, 0x20, 0x01,
+    0x50, 0x01, 0x50, 0x01, 0x70, 0x01, 0x30, 0x00, 0x48, 0x00, 0x48, 0x00, 0x30, 0x00, 0x30, 0x01,
+    0x48, 0x01, 0x48, 0x01, 0x30, 0x01, 0xE0, 0x03, 0xF0, 0x03, 0x99, 0x00, 0x8A, 0x00, 0x98, 0x00,
+    0xF0, 0x03, 0xE0, 0x03, 0xE0, 0x03, 0xF0, 0x03, 0x98, 0x00, 0x8A, 0x00, 0x99, 0x00, 0xF0, 0x03,
+    0xE0, 0x03, 0xE0, 0x03, 0xF0, 0x03, 0x9A, 0x00, 0x89, 0x00, 0x9A, 0x00, 0xF0, 0x03, 0xE0, 0x03,
+    0xE0, 0x03, 0xF2, 0x03, 0x99, 0x00, 0x8A, 0x00, 0x99, 0x00, 0xF0, 0x03, 0xE0, 0x03, 0xE0, 0x03,
+    0xF0, 0x03, 0x99, 0x00, 0x88, 0x00, 0x99, 0x00, 0xF0, 0x03, 0xE0, 0x03, 0xE0, 0x03, 0xF0, 0x03,
+    0x9A, 0x00, 0x89, 0x00, 0x9A, 0x00, 0xF0, 0x03, 0xE0, 0x03, 0xF0, 0x01, 0xF8, 0x03, 0x08, 0x0A,
+    0x08, 0x06, 0x08, 0x02, 0x18, 0x03, 0x10, 0x01, 0xF8, 0x03, 0xF8, 0x03, 0x49, 0x02, 0x4A, 0x02,
+    0x48, 0x02, 0x08, 0x02, 0x08, 0x02, 0xF8, 0x03, 0xF8, 0x03, 0x48, 0x02, 0x4A, 0x02, 0x49, 0x02,
+    0x08, 0x02, 0x08, 0x02, 0xF8, 0x03, 0xF8, 0x03, 0x4A, 0x02, 0x49, 0x02, 0x4A, 0x02, 0x08, 0x02,
+    0x08, 0x02, 0xF8, 0x03, 0xF8, 0x03, 0x49, 0x02, 0x48, 0x02, 0x49, 0x02, 0x08, 0x02, 0x08, 0x02,
+    0x08, 0x02, 0x09, 0x02, 0xFA, 0x03, 0xF8, 0x03, 0x08, 0x02, 0x08, 0x02, 0x08, 0x02, 0x08, 0x02,
+    0xFA, 0x03, 0xF9, 0x03, 0x08, 0x02, 0x08, 0x02, 0x08, 0x02, 0x0A, 0x02, 0xF9, 0x03, 0xFA, 0x03,
+    0x08, 0x02, 0x08, 0x02, 0x08, 0x02, 0x09, 0x02, 0xF8, 0x03, 0xF9, 0x03, 0x08, 0x02, 0x08, 0x02,
+    0xF8, 0x03, 0xFA, 0x03, 0x31, 0x00, 0x62, 0x00, 0xC1, 0x00, 0xF8, 0x03, 0xF8, 0x03, 0xF0, 0x01,
+    0xF8, 0x03, 0x09, 0x02, 0x0A, 0x02, 0x08, 0x02, 0xF8, 0x03, 0xF0, 0x01, 0xF0, 0x01, 0xF8, 0x03,
+    0x08, 0x02, 0x0A, 0x02, 0x09, 0x02, 0xF8, 0x03, 0xF0, 0x01, 0xF0, 0x01, 0xF8, 0x03, 0x0A, 0x02,
+    0x09, 0x02, 0x0A, 0x02, 0xF8, 0x03, 0xF0, 0x01, 0xF0, 0x01, 0xFA, 0x03, 0x09, 0x02, 0x0A, 0x02,
+    0x09, 0x02, 0xF8, 0x03, 0xF0, 0x01, 0xF0, 0x01, 0xF8, 0x03, 0x09, 0x02, 0x08, 0x02, 0x09, 0x02,
+    0xF8, 0x03, 0xF0, 0x01, 0xF8, 0x03, 0xF8, 0x03, 0x01, 0x02, 0x02, 0x02, 0x00, 0x02, 0xF8, 0x03,
+    0xF8, 0x03, 0xF8, 0x03, 0xF8, 0x03, 0x00, 0x02, 0x02, 0x02, 0x01, 0x02, 0xF8, 0x03, 0xF8, 0x03,
+    0xF8, 0x03, 0xF8, 0x03, 0x02, 0x02, 0x01, 0x02, 0x02, 0x02, 0xF8, 0x03, 0xF8, 0x03, 0xF8, 0x03,
+    0xF8, 0x03, 0x01, 0x02, 0x00, 0x02, 0x01, 0x02, 0xF8, 0x03, 0xF8, 0x03, 0x38, 0x02, 0x78, 0x02,
+    0x40, 0x03, 0xC2, 0x01, 0xC1, 0x00, 0x78, 0x00, 0x38, 0x00, 0x00, 0x01, 0xA0, 0x03, 0xA4, 0x02,
+    0xA8, 0x02, 0xA0, 0x02, 0xE0, 0x03, 0xC0, 0x03, 0x00, 0x01, 0xA0, 0x03, 0xA0, 0x02, 0xA8, 0x02,
+    0xA4, 0x02, 0xE0, 0x03, 0xC0, 0x03, 0x00, 0x01, 0xA0, 0x03, 0xA8, 0x02, 0xA4, 0x02, 0xA8, 0x02,
+    0xE0, 0x03, 0xC0, 0x03, 0x00, 0x01, 0xA8, 0x03, 0xA4, 0x02, 0xA8, 0x02, 0xA4, 0x02, 0xE0, 0x03,
+    0xC0, 0x03, 0x00, 0x01, 0xA0, 0x03, 0xA4, 0x02, 0xA0, 0x02, 0xA4, 0x02, 0xE0, 0x03, 0xC0, 0x03,
+    0x00, 0x01, 0xA0, 0x03, 0xA8, 0x02, 0xA4, 0x02, 0xA8, 0x02, 0xE0, 0x03, 0xC0, 0x03, 0xC0, 0x01,
+    0xE0, 0x03, 0x20, 0x0A, 0x20, 0x06, 0x20, 0x02, 0x60, 0x03, 0x40, 0x01, 0xC0, 0x01, 0xE0, 0x03,
+    0xA4, 0x02, 0xA8, 0x02, 0xA0, 0x02, 0xE0, 0x02, 0xC0, 0x00, 0xC0, 0x01, 0xE0, 0x03, 0xA0, 0x02,
+    0xA8, 0x02, 0xA4, 0x02, 0xE0, 0x02, 0xC0, 0x00, 0xC0, 0x01, 0xE0, 0x03, 0xA8, 0x02, 0xA4, 0x02,
+    0xA8, 0x02, 0xE0, 0x02, 0xC0, 0x00, 0xC0, 0x01, 0xE0, 0x03, 0xA4, 0x02, 0xA0, 0x02, 0xA4, 0x02,
+    0xE0, 0x02, 0xC0, 0x00, 0x24, 0x02, 0xE8, 0x03, 0xE0, 0x03, 0x00, 0x02, 0x20, 0x02, 0xE8, 0x03,
+    0xE4, 0x03, 0x00, 0x02, 0x28, 0x02, 0xE4, 0x03, 0xE8, 0x03, 0x00, 0x02, 0x24, 0x02, 0xE0, 0x03,
+    0xE4, 0x03, 0x00, 0x02, 0xE0, 0x03, 0xE8, 0x03, 0x24, 0x00, 0x28, 0x00, 0x24, 0x00, 0xE0, 0x03,
+    0xC0, 0x03, 0xC0, 0x01, 0xE0, 0x03, 0x24, 0x02, 0x28, 0x02, 0x20, 0x02, 0xE0, 0x03, 0xC0, 0x01,
+    0xC0, 0x01, 0xE0, 0x03, 0x20, 0x02, 0x28, 0x02, 0x24, 0x02, 0xE0, 0x03, 0xC0, 0x01, 0xC0, 0x01,
+    0xE0, 0x03, 0x28, 0x02, 0x24, 0x02, 0x28, 0x02, 0xE0, 0x03, 0xC0, 0x01, 0xC0, 0x01, 0xE8, 0x03,
+    0x24, 0x02, 0x28, 0x02, 0x24, 0x02, 0xE0, 0x03, 0xC0, 0x01, 0xC0, 0x01, 0xE0, 0x03, 0x24, 0x02,
+    0x20, 0x02, 0x24, 0x02, 0xE0, 0x03, 0xC0, 0x01, 0xE0, 0x01, 0xE0, 0x03, 0x04, 0x02, 0x08, 0x02,
+    0x00, 0x02, 0xE0, 0x03, 0xE0, 0x03, 0xE0, 0x01, 0xE0, 0x03, 0x00, 0x02, 0x08, 0x02, 0x04, 0x02,
+    0xE0, 0x03, 0xE0, 0x03, 0xE0, 0x01, 0xE0, 0x03, 0x08, 0x02, 0x04, 0x02, 0x08, 0x02, 0xE0, 0x03,
+    0xE0, 0x03, 0xE0, 0x01, 0xE0, 0x03, 0x04, 0x02, 0x00, 0x02, 0x04, 0x02, 0xE0, 0x03, 0xE0, 0x03,
+    0xE0, 0x04, 0xE0, 0x05, 0x00, 0x05, 0x08, 0x05, 0x04, 0x05, 0xE0, 0x07, 0xE0, 0x03, 0xE0, 0x04,
+    0xE0, 0x05, 0x04, 0x05, 0x00, 0x05, 0x04, 0x05, 0xE0, 0x07, 0xE0, 0x03,
+};
+
+static const texto_glifo_t fonte_texto_glifos[] = {
+    {    0,  0,  3},  // U+0020
+    {    0,  2,  3},  // U+0021 !
+    {    4,  5,  6},  // U+0022 "
+    {   14,  7,  8},  // U+0023 #
+    {   28,  7,  8},  // U+0024 $
+    {   42,  7,  8},  // U+0025 %
+    {   56,  7,  8},  // U+0026 &
+    {   70,  3,  4},  // U+0027 '
+    {   76,  4,  5},  // U+0028 (
+    {   84,  4,  5},  // U+0029 )
+    {   92,  8,  9},  // U+002A *
+    {  108,  6,  7},  // U+002B +
+    {  120,  3,  4},  // U+002C ,
+    {  126,  6,  7},  // U+002D -
+    {  138,  2,  3},  // U+002E .
+    {  142,  7,  8},  // U+002F /
+    {  156,  7,  8},  // U+0030 0
+    {  170,  6,  7},  // U+0031 1
+    {  182,  7,  8},  // U+0032 2
+    {  196,  7,  8},  // U+0033 3
+    {  210,  7,  8},  // U+0034 4
+    {  224,  7,  8},  // U+0035 5
+    {  238,  7,  8},  // U+0036 6
+    {  252,  7,  8},  // U+0037 7
+    {  266,  7,  8},  // U+0038 8
+    {  280,  7,  8},  // U+0039 9
+    {  294,  2,  3},  // U+003A :
+    {  298,  3,  4},  // U+003B ;
+    {  304,  5,  6},  // U+003C <
+    {  314,  6,  7},  // U+003D =
+    {  326,  5,  6},  // U+003E >
+    {  336,  6,  7},  // U+003F ?
+    {  348,  7,  8},  // U+0040 @
+    {  362,  7,  8},  // U+0041 A
+    {  376,  7,  8},  // U+0042 B
+    {  390,  7,  8},  // U+0043 C
+    {  404,  7,  8},  // U+0044 D
+    {  418,  7,  8},  // U+0045 E
+    {  432,  7,  8},  // U+0046 F
+    {  446,  7,  8},  // U+0047 G
+    {  460,  7,  8},  // U+0048 H
+    {  474,  6,  7},  // U+0049 I
+    {  486,  7,  8},  // U+004A J
+    {  500,  7,  8},  // U+004B K
+    {  514,  7,  8},  // U+004C L
+    {  528,  7,  8},  // U+004D M
+    {  542,  7,  8},  // U+004E N
+    {  556,  7,  8},  // U+004F O
+    {  570,  7,  8},  // U+0050 P
+    {  584,  7,  8},  // U+0051 Q
+    {  598,  7,  8},  // U+0052 R
+    {  612,  7,  8},  // U+0053 S
+    {  626,  8,  9},  // U+0054 T
+    {  642,  7,  8},  // U+0055 U
+    {  656,  7,  8},  // U+0056 V
+    {  670,  7,  8},  // U+0057 W
+    {  684,  7,  8},  // U+0058 X
+    {  698,  7,  8},  // U+0059 Y
+    {  712,  7,  8},  // U+005A Z
+    {  726,  4,  5},  // U+005B [
+    {  734,  7,  8},  // U+005C
+    {  748,  4,  5},  // U+005D ]
+    {  756,  7,  8},  // U+005E ^
+    {  770,  8,  9},  // U+005F _
+    {  786,  3,  4},  // U+0060 `
+    {  792,  7,  8},  // U+0061 a
+    {  806,  7,  8},  // U+0062 b
+    {  820,  7,  8},  // U+0063 c
+    {  834,  7,  8},  // U+0064 d
+    {  848,  7,  8},  // U+0065 e
+    {  862,  6,  7},  // U+0066 f
+    {  874,  7,  8},  // U+0067 g
+    {  888,  7,  8},  // U+0068 h
+    {  902,  4,  5},  // U+0069 i
+    {  910,  7,  8},  // U+006A j
+    {  924,  7,  8},  // U+006B k
+    {  938,  4,  5},  // U+006C l
+    {  946,  7,  8},  // U+006D m
+    {  960,  7,  8},  // U+006E n
+    {  974,  7,  8},  // U+006F o
+    {  988,  7,  8},  // U+0070 p
+    { 1002,  7,  8},  // U+0071 q
+    { 1016,  7,  8},  // U+0072 r
+    { 1030,  7,  8},  // U+0073 s
+    { 1044,  6,  7},  // U+0074 t
+    { 1056,  7,  8},  // U+0075 u
+    { 1070,  7,  8},  // U+0076 v
+    { 1084,  7,  8},  // U+0077 w
+    { 1098,  7,  8},  // U+0078 x
+    { 1112,  7,  8},  // U+0079 y
+    { 1126,  7,  8},  // U+007A z
+    { 1140,  6,  7},  // U+007B {
+    { 1152,  2,  3},  // U+007C |
+    { 1156,  6,  7},  // U+007D }
+    { 1168,  7,  8},  // U+007E ~
+    {    0,  0,  0},  // U+007F
+    {    0,  0,  0},  // U+0080
+    {    0,  0,  0},  // U+0081
+    {    0,  0,  0},  // U+0082
+    {    0,  0,  0},  // U+0083
+    {    0,  0,  0},  // U+0084
+    {    0,  0,  0},  // U+0085
+    {    0,  0,  0},  // U+0086
+    {    0,  0,  0},  // U+0087
+    {    0,  0,  0},  // U+0088
+    {    0,  0,  0},  // U+0089
+    {    0,  0,  0},  // U+008A
+    {    0,  0,  0},  // U+008B
+    {    0,  0,  0},  // U+008C
+    {    0,  0,  0},  // U+008D
+    {    0,  0,  0},  // U+008E
+    {    0,  0,  0},  // U+008F
+    {    0,  0,  0},  // U+0090
+    {    0,  0,  0},  // U+0091
+    {    0,  0,  0},  // U+0092
+    {    0,  0,  0},  // U+0093
+    {    0,  0,  0},  // U+0094
+    {    0,  0,  0},  // U+0095
+    {    0,  0,  0},  // U+0096
+    {    0,  0,  0},  // U+0097
+    {    0,  0,  0},  // U+0098
+    {    0,  0,  0},  // U+0099
+    {    0,  0,  0},  // U+009A
+    {    0,  0,  0},  // U+009B
+    {    0,  0,  0},  // U+009C
+    {    0,  0,  0},  // U+009D
+    {    0,  0,  0},  // U+009E
+    {    0,  0,  0},  // U+009F
+    {    0,  0,  0},  // U+00A0
+    {    0,  0,  0},  // U+00A1 ¡
+    {    0,  0,  0},  // U+00A2 ¢
+    {    0,  0,  0},  // U+00A3 £
+    {    0,  0,  0},  // U+00A4 ¤
+    {    0,  0,  0},  // U+00A5 ¥
+    {    0,  0,  0},  // U+00A6 ¦
+    {    0,  0,  0},  // U+00A7 §
+    {    0,  0,  0},  // U+00A8 ¨
+    {    0,  0,  0},  // U+00A9 ©
+    { 1182,  4,  5},  // U+00AA ª
+    {    0,  0,  0},  // U+00AB «
+    {    0,  0,  0},  // U+00AC ¬
+    {    0,  0,  0},  // U+00AD ­
+    {    0,  0,  0},  // U+00AE ®
+    {    0,  0,  0},  // U+00AF ¯
+    { 1190,  4,  5},  // U+00B0 °
+    {    0,  0,  0},  // U+00B1 ±
+    {    0,  0,  0},  // U+00B2 ²
+    {    0,  0,  0},  // U+00B3 ³
+    {    0,  0,  0},  // U+00B4 ´
+    {    0,  0,  0},  // U+00B5 µ
+    {    0,  0,  0},  // U+00B6 ¶
+    {    0,  0,  0},  // U+00B7 ·
+    {    0,  0,  0},  // U+00B8 ¸
+    {    0,  0,  0},  // U+00B9 ¹
+    { 1198,  4,  5},  // U+00BA º
+    {    0,  0,  0},  // U+00BB »
+    {    0,  0,  0},  // U+00BC ¼
+    {    0,  0,  0},  // U+00BD ½
+    {    0,  0,  0},  // U+00BE ¾
+    {    0,  0,  0},  // U+00BF ¿
+    { 1206,  7,  8},  // U+00C0 À
+    { 1220,  7,  8},  // U+00C1 Á
+    { 1234,  7,  8},  // U+00C2 Â
+    { 1248,  7,  8},  // U+00C3 Ã
+    { 1262,  7,  8},  // U+00C4 Ä
+    { 1276,  7,  8},  // U+00C5 Å
+    {    0,  0,  0},  // U+00C6 Æ
+    { 1290,  7,  8},  // U+00C7 Ç
+    { 1304,  7,  8},  // U+00C8 È
+    { 1318,  7,  8},  // U+00C9 É
+    { 1332,  7,  8},  // U+00CA Ê
+    { 1346,  7,  8},  // U+00CB Ë
+    { 1360,  6,  7},  // U+00CC Ì
+    { 1372,  6,  7},  // U+00CD Í
+    { 1384,  6,  7},  // U+00CE Î
+    { 1396,  6,  7},  // U+00CF Ï
+    {    0,  0,  0},  // U+00D0 Ð
+    { 1408,  7,  8},  // U+00D1 Ñ
+    { 1422,  7,  8},  // U+00D2 Ò
+    { 1436,  7,  8},  // U+00D3 Ó
+    { 1450,  7,  8},  // U+00D4 Ô
+    { 1464,  7,  8},  // U+00D5 Õ
+    { 1478,  7,  8},  // U+00D6 Ö
+    {    0,  0,  0},  // U+00D7 ×
+    {    0,  0,  0},  // U+00D8 Ø
+    { 1492,  7,  8},  // U+00D9 Ù
+    { 1506,  7,  8},  // U+00DA Ú
+    { 1520,  7,  8},  // U+00DB Û
+    { 1534,  7,  8},  // U+00DC Ü
+    { 1548,  7,  8},  // U+00DD Ý
+    {    0,  0,  0},  // U+00DE Þ
+    {    0,  0,  0},  // U+00DF ß
+    { 1562,  7,  8},  // U+00E0 à
+    { 1576,  7,  8},  // U+00E1 á
+    { 1590,  7,  8},  // U+00E2 â
+    { 1604,  7,  8},  // U+00E3 ã
+    { 1618,  7,  8},  // U+00E4 ä
+    { 1632,  7,  8},  // U+00E5 å
+    {    0,  0,  0},  // U+00E6 æ
+    { 1646,  7,  8},  // U+00E7 ç
+    { 1660,  7,  8},  // U+00E8 è
+    { 1674,  7,  8},  // U+00E9 é
+    { 1688,  7,  8},  // U+00EA ê
+    { 1702,  7,  8},  // U+00EB ë
+    { 1716,  4,  5},  // U+00EC ì
+    { 1724,  4,  5},  // U+00ED í
+    { 1732,  4,  5},  // U+00EE î
+    { 1740,  4,  5},  // U+00EF ï
+    {    0,  0,  0},  // U+00F0 ð
+    { 1748,  7,  8},  // U+00F1 ñ
+    { 1762,  7,  8},  // U+00F2 ò
+    { 1776,  7,  8},  // U+00F3 ó
+    { 1790,  7,  8},  // U+00F4 ô
+    { 1804,  7,  8},  // U+00F5 õ
+    { 1818,  7,  8},  // U+00F6 ö
+    {    0,  0,  0},  // U+00F7 ÷
+    {    0,  0,  0},  // U+00F8 ø
+    { 1832,  7,  8},  // U+00F9 ù
+    { 1846,  7,  8},  // U+00FA ú
+    { 1860,  7,  8},  // U+00FB û
+    { 1874,  7,  8},  // U+00FC ü
+    { 1888,  7,  8},  // U+00FD ý
+    {    0,  0,  0},  // U+00FE þ
+    { 1902,  7,  8},  // U+00FF ÿ
+};
+
+static const texto_kerning_t fonte_texto_kerning[] = {
+    {0x22, 0x4A, -1},
+    {0x22, 0x6A, -1},
+    {0x27, 0x2F, -1},
+    {0x27, 0x4A, -1},
+    {0x27, 0x6A, -1},
+    {0x2B, 0x2C, -1},
+    {0x2C, 0x54, -1},
+    {0x2C, 0x5C, -1},
+    {0x2D, 0x37, -1},
+    {0x2D, 0x4A, -1},
+    {0x2D, 0x54, -1},
+    {0x2D, 0x6A, -1},
+    {0x2E, 0x54, -1},
+    {0x2E, 0x5C, -1},
+    {0x2F, 0x2C, -1},
+    {0x2F, 0x2E, -1},
+    {0x2F, 0x2F, -1},
+    {0x2F, 0x4A, -1},
+    {0x2F, 0x5F, -1},
+    {0x2F, 0x64, -1},
+    {0x2F, 0x6A, -1},
+    {0x37, 0x2C, -1},
+    {0x37, 0x5F, -1},
+    {0x37, 0x6A, -1},
+    {0x3D, 0x54, -1},
+    {0x3D, 0x6A, -1},
+    {0x3E, 0x5F, -1},
+    {0x43, 0x2D, -1},
+    {0x46, 0x2C, -1},
+    {0x46, 0x2E, -1},
+    {0x46, 0x2F, -1},
+    {0x46, 0x4A, -1},
+    {0x46, 0x5F, -1},
+    {0x46, 0x61, -1},
+    {0x46, 0x6A, -1},
+    {0x4C, 0x22, -1},
+    {0x4C, 0x27, -1},
+    {0x4C, 0x2D, -1},
+    {0x4C, 0x34, -1},
+    {0x4C, 0x3D, -1},
+    {0x4C, 0x54, -1},
+    {0x4C, 0x5C, -1},
+    {0x4C, 0x5E, -1},
+    {0x4C, 0x60, -1},
+    {0x4C, 0x7E, -1},
+    {0x50, 0x2C, -1},
+    {0x50, 0x2E, -1},
+    {0x50, 0x4A, -1},
+    {0x50, 0x5F, -1},
+    {0x50, 0x6A, -1},
+    {0x54, 0x2C, -1},
+    {0x54, 0x2D, -1},
+    {0x54, 0x2E, -1},
+    {0x54, 0x2F, -1},
+    {0x54, 0x3D, -1},
+    {0x54, 0x4A, -1},
+    {0x54, 0x5F, -1},
+    {0x54, 0x61, -1},
+    {0x54, 0x63, -1},
+    {0x54, 0x64, -1},
+    {0x54, 0x65, -1},
+    {0x54, 0x67, -1},
+    {0x54, 0x6A, -1},
+    {0x54, 0x6D, -1},
+    {0x54, 0x6E, -1},
+    {0x54, 0x6F, -1},
+    {0x54, 0x70, -1},
+    {0x54, 0x71, -1},
+    {0x54, 0x72, -1},
+    {0x54, 0x73, -1},
+    {0x54, 0x75, -1},
+    {0x54, 0x76, -1},
+    {0x54, 0x77, -1},
+    {0x54, 0x78, -1},
+    {0x54, 0x79, -1},
+    {0x54, 0x7A, -1},
+    {0x59, 0x2C, -1},
+    {0x59, 0x5F, -1},
+    {0x59, 0x6A, -1},
+    {0x5C, 0x54, -1},
+    {0x5C, 0x5C, -1},
+    {0x5C, 0x60, -1},
+    {0x5C, 0x7E, -1},
+    {0x5E, 0x4A, -1},
+    {0x5E, 0x6A, -1},
+    {0x5F, 0x24, -1},
+    {0x5F, 0x34, -1},
+    {0x5F, 0x3C, -1},
+    {0x5F, 0x54, -1},
+    {0x5F, 0x5C, -1},
+    {0x5F, 0x71, -1},
+    {0x5F, 0x74, -1},
+    {0x5F, 0x7B, -1},
+    {0x60, 0x4A, -1},
+    {0x60, 0x6A, -1},
+    {0x61, 0x54, -1},
+    {0x62, 0x54, -1},
+    {0x62, 0x5C, -1},
+    {0x62, 0x7E, -1},
+    {0x63, 0x54, -1},
+    {0x65, 0x54, -1},
+    {0x67, 0x54, -1},
+    {0x68, 0x54, -1},
+    {0x6B, 0x54, -1},
+    {0x6D, 0x54, -1},
+    {0x6E, 0x54, -1},
+    {0x6F, 0x54, -1},
+    {0x70, 0x54, -1},
+    {0x70, 0x5F, -1},
+    {0x71, 0x54, -1},
+    {0x72, 0x2C, -1},
+    {0x72, 0x2E, -1},
+    {0x72, 0x37, -1},
+    {0x72, 0x4A, -1},
+    {0x72, 0x54, -1},
+    {0x72, 0x5F, -1},
+    {0x72, 0x6A, -1},
+    {0x73, 0x54, -1},
+    {0x75, 0x54, -1},
+    {0x76, 0x54, -1},
+    {0x77, 0x54, -1},
+    {0x78, 0x54, -1},
+    {0x79, 0x54, -1},
+    {0x7A, 0x54, -1},
+    {0x7D, 0x2C, -1},
+    {0x7D, 0x5F, -1},
+    {0x7E, 0x2F, -1},
+    {0x7E, 0x4A, -1},
+    {0x7E, 0x64, -1},
+    {0x7E, 0x6A, -1},
+};
+
+static const texto_fonte_t fonte_texto = {
+    .altura = 12,
+    .paginas = 2,
+    .primeiro = 0x20,
+    .ultimo = 0xFF,
+    .glifos = fonte_texto_glifos,
+    .bitmap = fonte_texto_bitmap,
+    .kerning = fonte_texto_kerning,
+    .num_kerning = 130,
+};
+
+#endif // FONTE_TEXTO_H
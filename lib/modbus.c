@@ -0,0 +1,131 @@
+#include <stddef.h>
+
+#include "modbus.h"
+
+#define FC_LE_HOLDING      0x03
+#define FC_LE_INPUT        0x04
+#define FC_ESCREVE_UM      0x06
+#define FC_ESCREVE_VARIOS  0x10
+
+static uint16_t le_u16(const uint8_t *p) {
+    return (uint16_t)((p[0] << 8) | p[1]);
+}
+
+static void escreve_u16(uint8_t *p, uint16_t v) {
+    p[0] = v >> 8;
+    p[1] = v & 0xFF;
+}
+
+/**
+ * Tamanho total da próxima ADU no buffer: 0 se ainda incompleta,
+ * -1 se o cabeçalho é inválido (a conexão deve ser encerrada)
+ */
+int modbus_tamanho_adu(const uint8_t *dados, uint16_t disponivel) {
+    if (disponivel < MODBUS_MBAP_TAM)
+        return 0;
+    uint16_t protocolo = le_u16(&dados[2]);
+    uint16_t tamanho = le_u16(&dados[4]);   // Unidade + PDU
+    if (protocolo != 0 || tamanho < 2 || tamanho > MODBUS_ADU_MAX - 6)
+        return -1;
+    return disponivel >= 6 + tamanho ? 6 + tamanho : 0;
+}
+
+static uint16_t excecao(uint8_t *pdu, uint8_t funcao, uint8_t codigo) {
+    pdu[0] = funcao | 0x80;
+    pdu[1] = codigo;
+    return 2;
+}
+
+static uint16_t le_registradores(const modbus_mapa_t *mapa, bool input, const uint8_t *req, uint16_t len, uint8_t *pdu) {
+    uint8_t funcao = req[0];
+    if (len != 5)
+        return excecao(pdu, funcao, MODBUS_EXC_VALOR_ILEGAL);
+    uint16_t primeiro = le_u16(&req[1]);
+    uint16_t quantidade = le_u16(&req[3]);
+    uint16_t limite = input ? mapa->num_input : mapa->num_holding;
+    if (quantidade < 1 || quantidade > 125)
+        return excecao(pdu, funcao, MODBUS_EXC_VALOR_ILEGAL);
+    if ((uint32_t)primeiro + quantidade > limite)
+        return excecao(pdu, funcao, MODBUS_EXC_ENDERECO_ILEGAL);
+
+    pdu[0] = funcao;
+    pdu[1] = quantidade * 2;
+    for (uint16_t i = 0; i < quantidade; i++) {
+        uint16_t valor;
+        uint8_t erro = input ? mapa->le_input(primeiro + i, &valor) : mapa->le_holding(primeiro + i, &valor);
+        if (erro)
+            return excecao(pdu, funcao, erro);
+        escreve_u16(&pdu[2 + i * 2], valor);
+    }
+    return 2 + quantidade * 2;
+}
+
+static uint16_t escreve_registradores(const modbus_mapa_t *mapa, const uint8_t *req, uint16_t len, uint8_t *pdu) {
+    uint8_t funcao = req[0];
+    uint16_t valores[123];
+    uint16_t primeiro, quantidade;
+
+    if (funcao == FC_ESCREVE_UM) {
+        if (len != 5)
+            return excecao(pdu, funcao, MODBUS_EXC_VALOR_ILEGAL);
+        primeiro = le_u16(&req[1]);
+        quantidade = 1;
+        valores[0] = le_u16(&req[3]);
+    } else {
+        if (len < 6)
+            return excecao(pdu, funcao, MODBUS_EXC_VALOR_ILEGAL);
+        primeiro = le_u16(&req[1]);
+        quantidade = le_u16(&req[3]);
+        if (quantidade < 1 || quantidade > 123 || req[5] != quantidade * 2 || len != 6 + quantidade * 2)
+            return excecao(pdu, funcao, MODBUS_EXC_VALOR_ILEGAL);
+        for (uint16_t i = 0; i < quantidade; i++)
+            valores[i] = le_u16(&req[6 + i * 2]);
+    }
+    if ((uint32_t)primeiro + quantidade > mapa->num_holding)
+        return excecao(pdu, funcao, MODBUS_EXC_ENDERECO_ILEGAL);
+
+    uint8_t erro = mapa->escreve_holding(primeiro, valores, quantidade);
+    if (erro)
+        return excecao(pdu, funcao, erro);
+
+    // Resposta ecoa o endereço e o valor (06) ou a quantidade (16)
+    pdu[0] = funcao;
+    escreve_u16(&pdu[1], primeiro);
+    escreve_u16(&pdu[3], funcao == FC_ESCREVE_UM ? valores[0] : quantidade);
+    return 5;
+}
+
+/**
+ * Processa uma ADU Modbus TCP completa e monta a resposta em resp
+ * (até MODBUS_ADU_MAX bytes). Retorna o tamanho da resposta.
+ */
+uint16_t modbus_processa(const modbus_mapa_t *mapa, const uint8_t *req, uint16_t len, uint8_t *resp) {
+    const uint8_t *pdu_req = &req[MODBUS_MBAP_TAM];
+    uint16_t pdu_len = len - MODBUS_MBAP_TAM;
+    uint8_t *pdu = &resp[MODBUS_MBAP_TAM];
+    uint16_t resp_len;
+
+    switch (pdu_req[0]) {
+        case FC_LE_HOLDING:
+            resp_len = le_registradores(mapa, false, pdu_req, pdu_len, pdu);
+            break;
+        case FC_LE_INPUT:
+            resp_len = le_registradores(mapa, true, pdu_req, pdu_len, pdu);
+            break;
+        case FC_ESCREVE_UM:
+        case FC_ESCREVE_VARIOS:
+            resp_len = escreve_registradores(mapa, pdu_req, pdu_len, pdu);
+            break;
+        default:
+            resp_len = excecao(pdu, pdu_req[0], MODBUS_EXC_FUNCAO_ILEGAL);
+            break;
+    }
+
+    // MBAP: mesma transação e unidade, tamanho = unidade + PDU
+    resp[0] = req[0];
+    resp[1] = req[1];
+    escreve_u16(&resp[2], 0);
+    escreve_u16(&resp[4], resp_len + 1);
+    resp[6] = req[6];
+    return MODBUS_MBAP_TAM + resp_len;
+}
@@ -0,0 +1,31 @@
+#ifndef MODBUS_H
+#define MODBUS_H
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#define MODBUS_PORTA       502
+#define MODBUS_MBAP_TAM    7     // Cabeçalho MBAP (transação, protocolo, tamanho, unidade)
+#define MODBUS_ADU_MAX     260   // MBAP + maior PDU permitida
+
+// Códigos de exceção do protocolo
+#define MODBUS_EXC_FUNCAO_ILEGAL   0x01
+#define MODBUS_EXC_ENDERECO_ILEGAL 0x02
+#define MODBUS_EXC_VALOR_ILEGAL    0x03
+#define MODBUS_EXC_FALHA_ESCRAVO   0x04
+
+// Acesso ao mapa de registradores; cada função retorna 0 ou um código de exceção
+typedef struct {
+    uint16_t num_input;
+    uint16_t num_holding;
+    uint8_t (*le_input)(uint16_t endereco, uint16_t *valor);
+    uint8_t (*le_holding)(uint16_t endereco, uint16_t *valor);
+    uint8_t (*escreve_holding)(uint16_t primeiro, const uint16_t *valores, uint16_t quantidade);
+} modbus_mapa_t;
+
+int modbus_tamanho_adu(const uint8_t *dados, uint16_t disponivel);
+uint16_t modbus_processa(const modbus_mapa_t *mapa, const uint8_t *req, uint16_t len, uint8_t *resp);
+
+bool modbus_tcp_init(const modbus_mapa_t *mapa);
+
+#endif // MODBUS_H
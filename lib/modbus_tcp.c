@@ -0,0 +1,184 @@
+#include <stdio.h>
+#include <string.h>
+
+#include "pico/cyw43_arch.h"
+#include "lwip/tcp.h"
+
+#include "modbus.h"
+#include "trace.h"
+
+#define MODBUS_MAX_CONEXOES 4
+#define MODBUS_RX_TAM       (2 * MODBUS_ADU_MAX)
+
+// Conexões em pool estático: nenhuma alocação por conexão ou transação
+typedef struct {
+    struct tcp_pcb *pcb;
+    uint8_t rx[MODBUS_RX_TAM];
+    uint16_t rx_len;
+    struct pbuf *entrada;    // Segmento recebido que ainda não coube em rx
+    uint16_t entrada_pos;    // Bytes de `entrada` já copiados para rx
+    bool em_uso;
+} modbus_conexao_t;
+
+static modbus_conexao_t conexoes[MODBUS_MAX_CONEXOES];
+static uint8_t resposta[MODBUS_ADU_MAX];
+static const modbus_mapa_t *mapa_registradores;
+
+static void libera(modbus_conexao_t *c) {
+    if (c->entrada) {
+        pbuf_free(c->entrada);
+        c->entrada = NULL;
+    }
+    c->em_uso = false;
+    c->pcb = NULL;
+    c->rx_len = 0;
+}
+
+// Fecha a conexão; retorna ERR_ABRT se foi preciso abortar o pcb
+static err_t encerra(modbus_conexao_t *c) {
+    err_t resultado = ERR_OK;
+    tcp_arg(c->pcb, NULL);
+    tcp_recv(c->pcb, NULL);
+    tcp_sent(c->pcb, NULL);
+    tcp_err(c->pcb, NULL);
+    if (tcp_close(c->pcb) != ERR_OK) {
+        tcp_abort(c->pcb);
+        resultado = ERR_ABRT;
+    }
+    libera(c);
+    return resultado;
+}
+
+/**
+ * Responde todas as ADUs completas já recebidas (requisições em pipeline),
+ * parando se o buffer de envio do lwIP não comportar a próxima resposta.
+ * Retorna false se a conexão foi abortada por cabeçalho inválido.
+ */
+static bool processa_pendentes(modbus_conexao_t *c) {
+    uint16_t consumido = 0;
+    bool enviou = false;
+
+    while (true) {
+        int tamanho = modbus_tamanho_adu(&c->rx[consumido], c->rx_len - consumido);
+        if (tamanho < 0) {
+            tcp_abort(c->pcb);
+            libera(c);
+            return false;
+        }
+        if (tamanho == 0 || tcp_sndbuf(c->pcb) < MODBUS_ADU_MAX)
+            break;
+
+        uint16_t resp_len = modbus_processa(mapa_registradores, &c->rx[consumido], tamanho, resposta);
+        if (tcp_write(c->pcb, resposta, resp_len, TCP_WRITE_FLAG_COPY) != ERR_OK)
+            break;
+        trace(TRACE_MODBUS, c->rx[consumido + 7], resp_len);
+        consumido += tamanho;
+        enviou = true;
+    }
+
+    if (consumido) {
+        memmove(c->rx, &c->rx[consumido], c->rx_len - consumido);
+        c->rx_len -= consumido;
+        tcp_recved(c->pcb, consumido);
+    }
+    if (enviou)
+        tcp_output(c->pcb);
+    return true;
+}
+
+/**
+ * Copia para rx o quanto couber do segmento retido e responde o que ficou
+ * completo, repetindo enquanto houver progresso. Só os bytes respondidos são
+ * liberados com tcp_recved, então um cliente mais rápido que o envio vê a
+ * janela fechar em vez de ter a conexão abortada.
+ */
+static bool alimenta(modbus_conexao_t *c) {
+    while (true) {
+        if (c->entrada) {
+            uint16_t n = c->entrada->tot_len - c->entrada_pos;
+            if (n > MODBUS_RX_TAM - c->rx_len)
+                n = MODBUS_RX_TAM - c->rx_len;
+            pbuf_copy_partial(c->entrada, &c->rx[c->rx_len], n, c->entrada_pos);
+            c->rx_len += n;
+            c->entrada_pos += n;
+            if (c->entrada_pos == c->entrada->tot_len) {
+                pbuf_free(c->entrada);
+                c->entrada = NULL;
+            }
+        }
+        uint16_t antes = c->rx_len;
+        if (!processa_pendentes(c))
+            return false;
+        if (!c->entrada || c->rx_len == antes)
+            return true;
+    }
+}
+
+static err_t modbus_recv(void *arg, struct tcp_pcb *tpcb, struct pbuf *p, err_t err) {
+    modbus_conexao_t *c = (modbus_conexao_t *)arg;
+    if (!p)
+        return encerra(c);
+
+    // Ainda há um segmento anterior esperando espaço em rx: o lwIP guarda
+    // este como dado recusado e o entrega de novo mais tarde
+    if (c->entrada)
+        return ERR_MEM;
+
+    c->entrada = p;
+    c->entrada_pos = 0;
+    return alimenta(c) ? ERR_OK : ERR_ABRT;
+}
+
+// Espaço liberado no envio: retoma requisições que ficaram na fila
+static err_t modbus_sent(void *arg, struct tcp_pcb *tpcb, u16_t len) {
+    modbus_conexao_t *c = (modbus_conexao_t *)arg;
+    if (c && (c->rx_len || c->entrada) && !alimenta(c))
+        return ERR_ABRT;
+    return ERR_OK;
+}
+
+static void modbus_err(void *arg, err_t err) {
+    if (arg)
+        libera((modbus_conexao_t *)arg);
+}
+
+static err_t modbus_accept(void *arg, struct tcp_pcb *newpcb, err_t err) {
+    if (err != ERR_OK || !newpcb)
+        return ERR_VAL;
+
+    for (int i = 0; i < MODBUS_MAX_CONEXOES; i++) {
+        modbus_conexao_t *c = &conexoes[i];
+        if (!c->em_uso) {
+            c->em_uso = true;
+            c->pcb = newpcb;
+            c->rx_len = 0;
+            c->entrada = NULL;
+            tcp_arg(newpcb, c);
+            tcp_recv(newpcb, modbus_recv);
+            tcp_sent(newpcb, modbus_sent);
+            tcp_err(newpcb, modbus_err);
+            return ERR_OK;
+        }
+    }
+
+    tcp_abort(newpcb);  // Sem conexões livres
+    return ERR_ABRT;
+}
+
+// Inicia o escravo Modbus TCP na porta 502 com o mapa de registradores dado
+bool modbus_tcp_init(const modbus_mapa_t *mapa) {
+    mapa_registradores = mapa;
+
+    cyw43_arch_lwip_begin();
+    struct tcp_pcb *pcb = tcp_new();
+    bool ok = pcb && tcp_bind(pcb, IP_ADDR_ANY, MODBUS_PORTA) == ERR_OK;
+    if (ok) {
+        pcb = tcp_listen(pcb);
+        tcp_accept(pcb, modbus_accept);
+    }
+    cyw43_arch_lwip_end();
+
+    printf(ok ? "Servidor Modbus TCP iniciado na porta %d\n" : "Falha ao iniciar o Modbus TCP na porta %d\n",
+           MODBUS_PORTA);
+    return ok;
+}
@@ -0,0 +1,126 @@
+#include <string.h>
+
+#include "ota.h"
+
+ota_status_t ota_inicia(ota_escrita_t *ota, const ota_flash_t *flash, uint32_t base, uint32_t capacidade,
+                        uint32_t tamanho, const uint8_t *chave, size_t chave_len,
+                        const uint8_t assinatura[SHA256_TAM]) {
+    ota->flash = flash;
+    ota->base = base;
+    ota->capacidade = capacidade;
+    ota->tamanho = tamanho;
+    ota->recebidos = 0;
+    ota->gravados = 0;
+    ota->pendentes = 0;
+    ota->chave = chave;
+    ota->chave_len = chave_len;
+    memcpy(ota->assinatura, assinatura, SHA256_TAM);
+    sha256_hmac_inicia(&ota->hmac, chave, chave_len);
+    ota->status = (tamanho == 0 || tamanho > capacidade) ? OTA_ERRO_TAMANHO : OTA_OK;
+    return ota->status;
+}
+
+// Apaga e programa o próximo setor; o restante de um setor parcial fica em 0xFF
+static bool grava_setor(ota_escrita_t *ota) {
+    memset(ota->setor + ota->pendentes, 0xFF, OTA_SETOR_TAM - ota->pendentes);
+    uint32_t offset = ota->base + ota->gravados;
+    if (!ota->flash->apaga(ota->flash->ctx, offset, OTA_SETOR_TAM) ||
+        !ota->flash->programa(ota->flash->ctx, offset, ota->setor, OTA_SETOR_TAM)) {
+        return false;
+    }
+    ota->gravados += OTA_SETOR_TAM;
+    ota->pendentes = 0;
+    return true;
+}
+
+ota_status_t ota_escreve(ota_escrita_t *ota, const void *dados, size_t len) {
+    if (ota->status != OTA_OK) {
+        return ota->status;
+    }
+    if (len > ota->tamanho - ota->recebidos) {
+        return ota->status = OTA_ERRO_EXCESSO;
+    }
+    sha256_hmac_atualiza(&ota->hmac, dados, len);
+    ota->recebidos += len;
+
+    const uint8_t *p = dados;
+    while (len) {
+        size_t n = OTA_SETOR_TAM - ota->pendentes;
+        if (n > len) {
+            n = len;
+        }
+        memcpy(ota->setor + ota->pendentes, p, n);
+        ota->pendentes += n;
+        p += n;
+        len -= n;
+        if (ota->pendentes == OTA_SETOR_TAM && !grava_setor(ota)) {
+            return ota->status = OTA_ERRO_FLASH;
+        }
+    }
+    return OTA_OK;
+}
+
+ota_status_t ota_finaliza(ota_escrita_t *ota) {
+    if (ota->status != OTA_OK) {
+        return ota->status;
+    }
+    if (ota->recebidos != ota->tamanho) {
+        return ota->status = OTA_ERRO_INCOMPLETO;
+    }
+    if (ota->pendentes && !grava_setor(ota)) {
+        return ota->status = OTA_ERRO_FLASH;
+    }
+
+    uint8_t mac[SHA256_TAM];
+    sha256_hmac_finaliza(&ota->hmac, mac);
+    if (!sha256_iguais(mac, ota->assinatura)) {
+        return ota->status = OTA_ERRO_ASSINATURA;
+    }
+
+    // Relê a região gravada usando o buffer do setor, já livre
+    sha256_hmac_inicia(&ota->hmac, ota->chave, ota->chave_len);
+    for (uint32_t lido = 0; lido < ota->tamanho; lido += OTA_SETOR_TAM) {
+        uint32_t n = ota->tamanho - lido < OTA_SETOR_TAM ? ota->tamanho - lido : OTA_SETOR_TAM;
+        if (!ota->flash->le(ota->flash->ctx, ota->base + lido, ota->setor, n)) {
+            return ota->status = OTA_ERRO_FLASH;
+        }
+        sha256_hmac_atualiza(&ota->hmac, ota->setor, n);
+    }
+    sha256_hmac_finaliza(&ota->hmac, mac);
+    if (!sha256_iguais(mac, ota->assinatura)) {
+        return ota->status = OTA_ERRO_VERIFICACAO;
+    }
+    return OTA_OK;
+}
+
+const char *ota_status_str(ota_status_t status) {
+    switch (status) {
+        case OTA_OK:               return "ok";
+        case OTA_ERRO_TAMANHO:     return "tamanho invalido";
+        case OTA_ERRO_EXCESSO:     return "dados alem do tamanho anunciado";
+        case OTA_ERRO_FLASH:       return "falha na flash";
+        case OTA_ERRO_INCOMPLETO:  return "imagem incompleta";
+        case OTA_ERRO_ASSINATURA:  return "assinatura nao confere";
+        case OTA_ERRO_VERIFICACAO: return "verificacao da flash falhou";
+        default:                   return "desconhecido";
+    }
+}
+
+static int valor_hex(char c) {
+    if (c >= '0' && c <= '9') return c - '0';
+    if (c >= 'a' && c <= 'f') return c - 'a' + 10;
+    if (c >= 'A' && c <= 'F') return c - 'A' + 10;
+    return -1;
+}
+
+bool ota_hash_de_hex(const char *hex, uint8_t resumo[SHA256_TAM]) {
+    for (int i = 0; i < SHA256_TAM; i++) {
+        int alto = valor_hex(hex[2 * i]);
+        int baixo = alto < 0 ? -1 : valor_hex(hex[2 * i + 1]);
+        if (baixo < 0) {
+            return false;
+        }
+        resumo[i] = (uint8_t)(alto << 4 | baixo);
+    }
+    return true;
+}
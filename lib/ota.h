@@ -0,0 +1,93 @@
+#ifndef OTA_H
+#define OTA_H
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#include "sha256.h"
+
+// Atualização de firmware em duas partes:
+//  - ota.c: gravação em blocos e verificação, sobre um backend de flash
+//    abstrato (roda no host contra um arquivo que simula a flash);
+//  - ota_pico.c: backend da flash interna, metadados de boot em teste,
+//    troca das regiões a partir da RAM e reversão.
+
+#define OTA_SETOR_TAM 4096
+
+// Backend de flash; offsets absolutos desde o início da flash
+typedef struct {
+    void *ctx;
+    bool (*apaga)(void *ctx, uint32_t offset, uint32_t len);
+    bool (*programa)(void *ctx, uint32_t offset, const uint8_t *dados, uint32_t len);
+    bool (*le)(void *ctx, uint32_t offset, uint8_t *dados, uint32_t len);
+} ota_flash_t;
+
+typedef enum {
+    OTA_OK,
+    OTA_ERRO_TAMANHO,      // Imagem vazia ou maior que a região de destino
+    OTA_ERRO_EXCESSO,      // Mais dados que o tamanho anunciado
+    OTA_ERRO_FLASH,        // Falha do backend ao apagar, programar ou ler
+    OTA_ERRO_INCOMPLETO,   // Finalizada antes de receber todos os bytes
+    OTA_ERRO_ASSINATURA,   // HMAC-SHA256 dos dados recebidos difere da assinatura
+    OTA_ERRO_VERIFICACAO,  // O que ficou gravado difere do que foi recebido
+} ota_status_t;
+
+// Sessão de gravação; os dados passam por um único setor em RAM. A imagem é
+// autenticada por HMAC-SHA256 com a chave fixada no firmware: quem envia
+// precisa conhecê-la para produzir a assinatura, que é conferida no
+// recebimento e de novo relendo a flash.
+typedef struct {
+    const ota_flash_t *flash;
+    uint32_t base;         // Offset da região de destino
+    uint32_t capacidade;
+    uint32_t tamanho;      // Tamanho anunciado da imagem
+    uint32_t recebidos;
+    uint32_t gravados;     // Bytes já programados (múltiplo de OTA_SETOR_TAM)
+    uint16_t pendentes;    // Bytes em setor ainda não programados
+    ota_status_t status;
+    const uint8_t *chave;
+    size_t chave_len;
+    uint8_t assinatura[SHA256_TAM];
+    sha256_hmac_t hmac;
+    uint8_t setor[OTA_SETOR_TAM];
+} ota_escrita_t;
+
+ota_status_t ota_inicia(ota_escrita_t *ota, const ota_flash_t *flash, uint32_t base, uint32_t capacidade,
+                        uint32_t tamanho, const uint8_t *chave, size_t chave_len,
+                        const uint8_t assinatura[SHA256_TAM]);
+ota_status_t ota_escreve(ota_escrita_t *ota, const void *dados, size_t len);
+ota_status_t ota_finaliza(ota_escrita_t *ota);
+const char *ota_status_str(ota_status_t status);
+// Converte 64 dígitos hexadecimais em 32 bytes (assinatura ou chave)
+bool ota_hash_de_hex(const char *hex, uint8_t resumo[SHA256_TAM]);
+
+// ===== Flash interna do RP2040 (ota_pico.c) =====
+
+typedef enum {
+    OTA_BOOT_NORMAL,       // Sem atualização registrada ou imagem confirmada
+    OTA_BOOT_TESTE,        // Imagem nova aguardando confirmação
+    OTA_BOOT_REVERTIDO,    // A última imagem não se confirmou e foi revertida
+} ota_boot_t;
+
+extern const ota_flash_t ota_flash_pico;
+
+// Região de staging (offset e capacidade) para ota_inicia
+void ota_regiao_staging(uint32_t *base, uint32_t *capacidade);
+// No início do main: termina uma troca interrompida pelo diário, conta boots
+// em teste e reverte se passarem do limite
+void ota_boot_verifica(void);
+// Marca a imagem em execução como boa (só grava se estiver em teste)
+void ota_confirma(void);
+ota_boot_t ota_estado_boot(void);
+const char *ota_estado_boot_str(void);
+// Troca a imagem em staging com a atual e reinicia; não retorna
+void ota_troca_e_reinicia(uint32_t tamanho);
+
+// Setor de dados da aplicação (perfil da agenda), fora das regiões trocadas
+// pela atualização: leitura direta pelo XIP (OTA_SETOR_TAM bytes) e gravação
+// que apaga e programa o setor inteiro, com o restante em 0xFF
+const uint8_t *ota_dados_aplicacao(void);
+bool ota_grava_dados_aplicacao(const void *dados, uint32_t len);
+
+#endif // OTA_H
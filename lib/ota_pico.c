@@ -0,0 +1,273 @@
+#include <string.h>
+
+#include "pico/stdlib.h"
+#include "pico/flash.h"
+#include "hardware/flash.h"
+#include "hardware/sync.h"
+#include "hardware/structs/watchdog.h"
+
+#include "ota.h"
+
+// Mapa da flash: [aplicação | staging | troca | dados | metadados]; as duas
+// regiões têm o mesmo tamanho e a troca entre elas é a própria operação de
+// reversão. O setor de troca guarda o setor em trânsito e os metadados levam,
+// a partir da segunda página, o diário da troca: um byte zerado por passo.
+#define OTA_META_OFFSET    (PICO_FLASH_SIZE_BYTES - FLASH_SECTOR_SIZE)
+#define OTA_DADOS_OFFSET   (OTA_META_OFFSET - FLASH_SECTOR_SIZE)
+#define OTA_TROCA_OFFSET   (OTA_DADOS_OFFSET - FLASH_SECTOR_SIZE)
+#define OTA_REGIAO_TAM     ((OTA_TROCA_OFFSET / 2) & ~(FLASH_SECTOR_SIZE - 1))
+#define OTA_STAGING_OFFSET OTA_REGIAO_TAM
+#define OTA_DIARIO_OFFSET  (OTA_META_OFFSET + FLASH_PAGE_SIZE)
+
+#define OTA_MAGICA         0x4F544132  // "OTA2": mapa com o setor de troca
+#define OTA_MAX_TENTATIVAS 3           // Boots sem confirmação antes de reverter
+#define OTA_TIMEOUT_FLASH_MS 100
+
+#define OTA_PASSOS_SETOR   3           // aplicação -> troca, staging -> aplicação, troca -> staging
+
+_Static_assert(OTA_SETOR_TAM == FLASH_SECTOR_SIZE, "setor de OTA difere do setor da flash");
+_Static_assert(OTA_PASSOS_SETOR * (OTA_REGIAO_TAM / FLASH_SECTOR_SIZE) <= FLASH_SECTOR_SIZE - FLASH_PAGE_SIZE,
+               "diário da troca não cabe no setor de metadados");
+
+typedef struct {
+    uint32_t magica;
+    uint32_t estado;       // ota_boot_t
+    uint32_t setores;      // Setores trocados entre aplicação e staging
+    uint32_t tentativas;   // Boots em teste sem confirmação
+    uint32_t trocando;     // Troca iniciada e ainda não vista terminada no boot
+} ota_meta_t;
+
+typedef struct {
+    uint32_t offset;
+    const uint8_t *dados;
+    uint32_t len;
+} operacao_flash_t;
+
+extern char __flash_binary_end;
+
+static ota_meta_t meta_atual;
+static uint8_t buf_troca[FLASH_SECTOR_SIZE];
+static uint8_t buf_staging[FLASH_SECTOR_SIZE];
+static uint8_t buf_diario[FLASH_PAGE_SIZE];
+
+// ===== Backend da flash interna (só escreve na região de staging) =====
+
+static void executa_apaga(void *param) {
+    operacao_flash_t *op = param;
+    flash_range_erase(op->offset, op->len);
+}
+
+static void executa_programa(void *param) {
+    operacao_flash_t *op = param;
+    flash_range_program(op->offset, op->dados, op->len);
+}
+
+static bool dentro_do_staging(uint32_t offset, uint32_t len) {
+    return offset >= OTA_STAGING_OFFSET && offset + len <= OTA_STAGING_OFFSET + OTA_REGIAO_TAM;
+}
+
+static bool pico_apaga(void *ctx, uint32_t offset, uint32_t len) {
+    operacao_flash_t op = {offset, NULL, len};
+    return dentro_do_staging(offset, len) &&
+           flash_safe_execute(executa_apaga, &op, OTA_TIMEOUT_FLASH_MS) == PICO_OK;
+}
+
+static bool pico_programa(void *ctx, uint32_t offset, const uint8_t *dados, uint32_t len) {
+    operacao_flash_t op = {offset, dados, len};
+    return dentro_do_staging(offset, len) &&
+           flash_safe_execute(executa_programa, &op, OTA_TIMEOUT_FLASH_MS) == PICO_OK;
+}
+
+static bool pico_le(void *ctx, uint32_t offset, uint8_t *dados, uint32_t len) {
+    memcpy(dados, (const uint8_t *)(XIP_NOCACHE_NOALLOC_BASE + offset), len);
+    return true;
+}
+
+const ota_flash_t ota_flash_pico = {
+    .ctx = NULL,
+    .apaga = pico_apaga,
+    .programa = pico_programa,
+    .le = pico_le,
+};
+
+static uint32_t tamanho_imagem_atual(void) {
+    return (uint32_t)((uintptr_t)&__flash_binary_end - XIP_BASE);
+}
+
+void ota_regiao_staging(uint32_t *base, uint32_t *capacidade) {
+    *base = OTA_STAGING_OFFSET;
+    // Se a imagem atual invadir o staging, nenhuma atualização é aceita
+    *capacidade = tamanho_imagem_atual() <= OTA_REGIAO_TAM ? OTA_REGIAO_TAM : 0;
+}
+
+// ===== Metadados e troca =====
+
+static void executa_grava_setor(void *param) {
+    // O setor é gravado inteiro: os dados e o restante em 0xFF
+    operacao_flash_t *op = param;
+    memset(buf_staging, 0xFF, sizeof(buf_staging));
+    memcpy(buf_staging, op->dados, op->len);
+    flash_range_erase(op->offset, FLASH_SECTOR_SIZE);
+    flash_range_program(op->offset, buf_staging, FLASH_SECTOR_SIZE);
+}
+
+static bool grava_setor(uint32_t offset, const void *dados, uint32_t len) {
+    operacao_flash_t op = {offset, dados, len};
+    return len <= FLASH_SECTOR_SIZE && flash_safe_execute(executa_grava_setor, &op, OTA_TIMEOUT_FLASH_MS) == PICO_OK;
+}
+
+static void grava_meta(void) {
+    grava_setor(OTA_META_OFFSET, &meta_atual, sizeof(meta_atual));
+}
+
+static void __no_inline_not_in_flash_func(copia_da_flash)(uint8_t *destino, uint32_t offset) {
+    const volatile uint32_t *origem = (const volatile uint32_t *)(XIP_NOCACHE_NOALLOC_BASE + offset);
+    uint32_t *d = (uint32_t *)destino;
+    for (uint32_t i = 0; i < FLASH_SECTOR_SIZE / 4; i++) {
+        d[i] = origem[i];
+    }
+}
+
+// Copia um setor inteiro (apaga e programa o destino) passando pela RAM
+static void __no_inline_not_in_flash_func(copia_setor)(uint32_t destino, uint32_t origem) {
+    copia_da_flash(buf_troca, origem);
+    flash_range_erase(destino, FLASH_SECTOR_SIZE);
+    flash_range_program(destino, buf_troca, FLASH_SECTOR_SIZE);
+}
+
+// Zera o byte `passo` do diário; os já zerados na mesma página não mudam
+static void __no_inline_not_in_flash_func(registra_passo)(uint32_t passo) {
+    for (uint32_t i = 0; i < FLASH_PAGE_SIZE; i++) {
+        buf_diario[i] = 0xFF;
+    }
+    buf_diario[passo % FLASH_PAGE_SIZE] = 0x00;
+    flash_range_program(OTA_DIARIO_OFFSET + passo - passo % FLASH_PAGE_SIZE, buf_diario, FLASH_PAGE_SIZE);
+}
+
+/**
+ * Troca os primeiros `setores` setores da aplicação com os do staging, a
+ * partir do passo `inicio` do diário, e reinicia. Roda inteira da RAM com
+ * interrupções desligadas, pois o código em flash está sendo sobrescrito; não
+ * retorna. Cada passo regrava um setor a partir de uma origem que ele não
+ * altera e só depois é registrado, então refazer o passo interrompido por
+ * falta de energia dá o mesmo resultado.
+ */
+static void __no_inline_not_in_flash_func(troca_regioes)(uint32_t setores, uint32_t inicio) {
+    // A troca leva dezenas de segundos, mais que o timeout do watchdog
+    hw_clear_bits(&watchdog_hw->ctrl, WATCHDOG_CTRL_ENABLE_BITS);
+    for (uint32_t passo = inicio; passo < setores * OTA_PASSOS_SETOR; passo++) {
+        uint32_t aplicacao = passo / OTA_PASSOS_SETOR * FLASH_SECTOR_SIZE;
+        uint32_t staging = OTA_STAGING_OFFSET + aplicacao;
+        switch (passo % OTA_PASSOS_SETOR) {
+            case 0:  copia_setor(OTA_TROCA_OFFSET, aplicacao); break;
+            case 1:  copia_setor(aplicacao, staging); break;
+            default: copia_setor(staging, OTA_TROCA_OFFSET); break;
+        }
+        registra_passo(passo);
+    }
+    watchdog_hw->ctrl = WATCHDOG_CTRL_TRIGGER_BITS;
+    while (true) {
+        tight_loop_contents();
+    }
+}
+
+static void __no_inline_not_in_flash_func(troca_e_reinicia)(uint32_t setores, uint32_t inicio) {
+    save_and_disable_interrupts();
+    troca_regioes(setores, inicio);
+}
+
+// Marca a troca no metadado (o que também apaga o diário) e a executa
+static void inicia_troca(void) {
+    meta_atual.trocando = 1;
+    grava_meta();
+    troca_e_reinicia(meta_atual.setores, 0);
+}
+
+// Passos concluídos: bytes zerados seguidos no início do diário
+static uint32_t passos_no_diario(void) {
+    const uint8_t *diario = (const uint8_t *)(XIP_BASE + OTA_DIARIO_OFFSET);
+    uint32_t n = 0;
+    while (n < meta_atual.setores * OTA_PASSOS_SETOR && diario[n] == 0x00) {
+        n++;
+    }
+    return n;
+}
+
+void ota_boot_verifica(void) {
+    memcpy(&meta_atual, (const void *)(XIP_BASE + OTA_META_OFFSET), sizeof(meta_atual));
+    if (meta_atual.magica != OTA_MAGICA) {
+        meta_atual.magica = OTA_MAGICA;
+        meta_atual.estado = OTA_BOOT_NORMAL;
+        meta_atual.setores = 0;
+        meta_atual.tentativas = 0;
+        meta_atual.trocando = 0;
+        return;  // Nada gravado: primeira gravação só na próxima atualização
+    }
+
+    bool grava = false;
+    if (meta_atual.trocando) {
+        // Energia caiu no meio da troca: termina a partir do diário
+        uint32_t feitos = passos_no_diario();
+        if (feitos < meta_atual.setores * OTA_PASSOS_SETOR) {
+            troca_e_reinicia(meta_atual.setores, feitos);
+        }
+        meta_atual.trocando = 0;
+        grava = true;
+    }
+    if (meta_atual.estado == OTA_BOOT_TESTE) {
+        meta_atual.tentativas++;
+        if (meta_atual.tentativas > OTA_MAX_TENTATIVAS) {
+            // A imagem nova não se confirmou: a anterior está no staging
+            meta_atual.estado = OTA_BOOT_REVERTIDO;
+            inicia_troca();
+        }
+        grava = true;
+    }
+    if (grava) {
+        grava_meta();
+    }
+}
+
+void ota_confirma(void) {
+    if (meta_atual.estado == OTA_BOOT_TESTE) {
+        meta_atual.estado = OTA_BOOT_NORMAL;
+        meta_atual.tentativas = 0;
+        grava_meta();
+    }
+}
+
+ota_boot_t ota_estado_boot(void) {
+    return (ota_boot_t)meta_atual.estado;
+}
+
+const char *ota_estado_boot_str(void) {
+    switch (meta_atual.estado) {
+        case OTA_BOOT_TESTE:     return "teste";
+        case OTA_BOOT_REVERTIDO: return "revertido";
+        default:                 return "normal";
+    }
+}
+
+void ota_troca_e_reinicia(uint32_t tamanho) {
+    // Cobre a maior das duas imagens para que a troca inversa restaure a atual
+    uint32_t atual = tamanho_imagem_atual();
+    uint32_t maior = tamanho > atual ? tamanho : atual;
+    if (maior > OTA_REGIAO_TAM) {
+        maior = OTA_REGIAO_TAM;
+    }
+    meta_atual.magica = OTA_MAGICA;
+    meta_atual.estado = OTA_BOOT_TESTE;
+    meta_atual.setores = (maior + FLASH_SECTOR_SIZE - 1) / FLASH_SECTOR_SIZE;
+    meta_atual.tentativas = 0;
+    inicia_troca();
+}
+
+// ===== Dados da aplicação =====
+
+const uint8_t *ota_dados_aplicacao(void) {
+    return (const uint8_t *)(XIP_BASE + OTA_DADOS_OFFSET);
+}
+
+bool ota_grava_dados_aplicacao(const void *dados, uint32_t len) {
+    return grava_setor(OTA_DADOS_OFFSET, dados, len);
+}
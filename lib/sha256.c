@@ -0,0 +1,146 @@
+#include <string.h>
+
+#include "sha256.h"
+
+static const uint32_t K[64] = {
+    0x428a2f98, 0x71374491, 0xb5c0fbcf, 0xe9b5dba5, 0x3956c25b, 0x59f111f1, 0x923f82a4, 0xab1c5ed5,
+    0xd807aa98, 0x12835b01, 0x243185be, 0x550c7dc3, 0x72be5d74, 0x80deb1fe, 0x9bdc06a7, 0xc19bf174,
+    0xe49b69c1, 0xefbe4786, 0x0fc19dc6, 0x240ca1cc, 0x2de92c6f, 0x4a7484aa, 0x5cb0a9dc, 0x76f988da,
+    0x983e5152, 0xa831c66d, 0xb00327c8, 0xbf597fc7, 0xc6e00bf3, 0xd5a79147, 0x06ca6351, 0x14292967,
+    0x27b70a85, 0x2e1b2138, 0x4d2c6dfc, 0x53380d13, 0x650a7354, 0x766a0abb, 0x81c2c92e, 0x92722c85,
+    0xa2bfe8a1, 0xa81a664b, 0xc24b8b70, 0xc76c51a3, 0xd192e819, 0xd6990624, 0xf40e3585, 0x106aa070,
+    0x19a4c116, 0x1e376c08, 0x2748774c, 0x34b0bcb5, 0x391c0cb3, 0x4ed8aa4a, 0x5b9cca4f, 0x682e6ff3,
+    0x748f82ee, 0x78a5636f, 0x84c87814, 0x8cc70208, 0x90befffa, 0xa4506ceb, 0xbef9a3f7, 0xc67178f2,
+};
+
+#define ROTR(x, n) (((x) >> (n)) | ((x) << (32 - (n))))
+
+static void processa_bloco(sha256_t *ctx, const uint8_t *p) {
+    uint32_t w[64];
+    for (int i = 0; i < 16; i++) {
+        w[i] = ((uint32_t)p[4 * i] << 24) | ((uint32_t)p[4 * i + 1] << 16) |
+               ((uint32_t)p[4 * i + 2] << 8) | (uint32_t)p[4 * i + 3];
+    }
+    for (int i = 16; i < 64; i++) {
+        uint32_t s0 = ROTR(w[i - 15], 7) ^ ROTR(w[i - 15], 18) ^ (w[i - 15] >> 3);
+        uint32_t s1 = ROTR(w[i - 2], 17) ^ ROTR(w[i - 2], 19) ^ (w[i - 2] >> 10);
+        w[i] = w[i - 16] + s0 + w[i - 7] + s1;
+    }
+
+    uint32_t a = ctx->estado[0], b = ctx->estado[1], c = ctx->estado[2], d = ctx->estado[3];
+    uint32_t e = ctx->estado[4], f = ctx->estado[5], g = ctx->estado[6], h = ctx->estado[7];
+    for (int i = 0; i < 64; i++) {
+        uint32_t t1 = h + (ROTR(e, 6) ^ ROTR(e, 11) ^ ROTR(e, 25)) + ((e & f) ^ (~e & g)) + K[i] + w[i];
+        uint32_t t2 = (ROTR(a, 2) ^ ROTR(a, 13) ^ ROTR(a, 22)) + ((a & b) ^ (a & c) ^ (b & c));
+        h = g;
+        g = f;
+        f = e;
+        e = d + t1;
+        d = c;
+        c = b;
+        b = a;
+        a = t1 + t2;
+    }
+    ctx->estado[0] += a;
+    ctx->estado[1] += b;
+    ctx->estado[2] += c;
+    ctx->estado[3] += d;
+    ctx->estado[4] += e;
+    ctx->estado[5] += f;
+    ctx->estado[6] += g;
+    ctx->estado[7] += h;
+}
+
+void sha256_inicia(sha256_t *ctx) {
+    static const uint32_t INICIAL[8] = {
+        0x6a09e667, 0xbb67ae85, 0x3c6ef372, 0xa54ff53a, 0x510e527f, 0x9b05688c, 0x1f83d9ab, 0x5be0cd19,
+    };
+    memcpy(ctx->estado, INICIAL, sizeof(INICIAL));
+    ctx->total = 0;
+    ctx->usados = 0;
+}
+
+void sha256_atualiza(sha256_t *ctx, const void *dados, size_t len) {
+    const uint8_t *p = dados;
+    ctx->total += len;
+    if (ctx->usados) {
+        size_t livre = (size_t)(64 - ctx->usados);
+        size_t n = livre < len ? livre : len;
+        memcpy(ctx->bloco + ctx->usados, p, n);
+        ctx->usados += n;
+        p += n;
+        len -= n;
+        if (ctx->usados < 64) {
+            return;
+        }
+        processa_bloco(ctx, ctx->bloco);
+        ctx->usados = 0;
+    }
+    // Blocos completos direto da entrada, sem cópia
+    for (; len >= 64; p += 64, len -= 64) {
+        processa_bloco(ctx, p);
+    }
+    memcpy(ctx->bloco, p, len);
+    ctx->usados = len;
+}
+
+void sha256_finaliza(sha256_t *ctx, uint8_t resumo[SHA256_TAM]) {
+    uint64_t bits = ctx->total * 8;
+    ctx->bloco[ctx->usados++] = 0x80;
+    if (ctx->usados > 56) {
+        memset(ctx->bloco + ctx->usados, 0, 64 - ctx->usados);
+        processa_bloco(ctx, ctx->bloco);
+        ctx->usados = 0;
+    }
+    memset(ctx->bloco + ctx->usados, 0, 56 - ctx->usados);
+    for (int i = 0; i < 8; i++) {
+        ctx->bloco[56 + i] = bits >> (56 - 8 * i);
+    }
+    processa_bloco(ctx, ctx->bloco);
+    for (int i = 0; i < 8; i++) {
+        resumo[4 * i] = ctx->estado[i] >> 24;
+        resumo[4 * i + 1] = ctx->estado[i] >> 16;
+        resumo[4 * i + 2] = ctx->estado[i] >> 8;
+        resumo[4 * i + 3] = ctx->estado[i];
+    }
+}
+
+void sha256_hmac_inicia(sha256_hmac_t *ctx, const uint8_t *chave, size_t chave_len) {
+    // Chaves maiores que o bloco entram pelo seu resumo
+    uint8_t k[64] = {0};
+    if (chave_len > sizeof(k)) {
+        sha256_inicia(&ctx->interno);
+        sha256_atualiza(&ctx->interno, chave, chave_len);
+        sha256_finaliza(&ctx->interno, k);
+    } else {
+        memcpy(k, chave, chave_len);
+    }
+    uint8_t ipad[64];
+    for (int i = 0; i < 64; i++) {
+        ipad[i] = k[i] ^ 0x36;
+        ctx->chave_opad[i] = k[i] ^ 0x5c;
+    }
+    sha256_inicia(&ctx->interno);
+    sha256_atualiza(&ctx->interno, ipad, sizeof(ipad));
+}
+
+void sha256_hmac_atualiza(sha256_hmac_t *ctx, const void *dados, size_t len) {
+    sha256_atualiza(&ctx->interno, dados, len);
+}
+
+void sha256_hmac_finaliza(sha256_hmac_t *ctx, uint8_t mac[SHA256_TAM]) {
+    uint8_t interno[SHA256_TAM];
+    sha256_finaliza(&ctx->interno, interno);
+    sha256_inicia(&ctx->interno);
+    sha256_atualiza(&ctx->interno, ctx->chave_opad, sizeof(ctx->chave_opad));
+    sha256_atualiza(&ctx->interno, interno, sizeof(interno));
+    sha256_finaliza(&ctx->interno, mac);
+}
+
+bool sha256_iguais(const uint8_t a[SHA256_TAM], const uint8_t b[SHA256_TAM]) {
+    uint8_t diferenca = 0;
+    for (int i = 0; i < SHA256_TAM; i++) {
+        diferenca |= a[i] ^ b[i];
+    }
+    return diferenca == 0;
+}
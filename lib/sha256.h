@@ -0,0 +1,35 @@
+#ifndef SHA256_H
+#define SHA256_H
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+// SHA-256 incremental (FIPS 180-4) e HMAC-SHA256 (RFC 2104), sem dependência
+// do hardware
+
+#define SHA256_TAM 32
+
+typedef struct {
+    uint32_t estado[8];
+    uint64_t total;        // Bytes processados
+    uint8_t bloco[64];
+    uint8_t usados;        // Bytes pendentes em bloco
+} sha256_t;
+
+void sha256_inicia(sha256_t *ctx);
+void sha256_atualiza(sha256_t *ctx, const void *dados, size_t len);
+void sha256_finaliza(sha256_t *ctx, uint8_t resumo[SHA256_TAM]);
+
+typedef struct {
+    sha256_t interno;
+    uint8_t chave_opad[64];  // Chave XOR 0x5c, para a passada externa
+} sha256_hmac_t;
+
+void sha256_hmac_inicia(sha256_hmac_t *ctx, const uint8_t *chave, size_t chave_len);
+void sha256_hmac_atualiza(sha256_hmac_t *ctx, const void *dados, size_t len);
+void sha256_hmac_finaliza(sha256_hmac_t *ctx, uint8_t mac[SHA256_TAM]);
+// Compara dois resumos sem encerrar na primeira diferença
+bool sha256_iguais(const uint8_t a[SHA256_TAM], const uint8_t b[SHA256_TAM]);
+
+#endif // SHA256_H
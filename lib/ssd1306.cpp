@@ -0,0 +1,188 @@
+// Camada em C sobre o driver em modelo (ssd1306.hpp): mantém a API ssd1306_*
+// usada pelo restante do firmware, com a geometria fixada por WIDTH e HEIGHT
+#include <cassert>
+
+#include "ssd1306.h"
+#include "ssd1306.hpp"
+
+extern "C" {
+#include "font.h"
+#include "trace.h"
+}
+
+using Painel = ssd1306::Painel<WIDTH, HEIGHT, ssd1306::Enderecamento::vertical, ssd1306::TransporteI2C>;
+
+static Painel painel_de(const ssd1306_t *ssd) {
+  return Painel(ssd1306::TransporteI2C{ssd->i2c_port, ssd->address});
+}
+
+void ssd1306_init(ssd1306_t *ssd, uint8_t width, uint8_t height, bool external_vcc, uint8_t address, i2c_inst_t *i2c) {
+  // A geometria é a do modelo (WIDTH x HEIGHT); outra pedida aqui é erro de
+  // configuração, não algo a ajustar em tempo de execução
+  assert(width == Painel::largura && height == Painel::altura);
+  (void)width;
+  (void)height;
+  ssd->width = Painel::largura;
+  ssd->height = Painel::altura;
+  ssd->pages = Painel::paginas;
+  ssd->address = address;
+  ssd->i2c_port = i2c;
+  ssd->external_vcc = external_vcc;
+  ssd->bufsize = Painel::tam_buffer;
+  ssd->ram_buffer = Painel::buffer.data();
+  ssd->ram_buffer[0] = 0x40;
+  ssd->port_buffer[0] = 0x80;
+  ssd->dirty = false;
+  ssd->ao_enviar = NULL;
+}
+
+void ssd1306_config(ssd1306_t *ssd) {
+  painel_de(ssd).configura();
+}
+
+void ssd1306_command(ssd1306_t *ssd, uint8_t command) {
+  painel_de(ssd).comando(command);
+}
+
+void ssd1306_send_data(ssd1306_t *ssd) {
+  trace(TRACE_I2C_INICIO, 0, Painel::tam_buffer);
+  int enviados = painel_de(ssd).envia();
+  trace(TRACE_I2C_FIM, 0, enviados);
+  ssd->dirty = false;
+  if (ssd->ao_enviar)
+    ssd->ao_enviar(ssd, 0, Painel::largura - 1, 0, Painel::paginas - 1);
+}
+
+// Acumula o retângulo (em colunas e páginas) que precisa ser reenviado
+void ssd1306_mark_dirty(ssd1306_t *ssd, uint8_t x, uint8_t y, uint8_t width, uint8_t height) {
+  if (!width || !height || x >= ssd->width || y >= ssd->height)
+    return;
+  uint8_t x1 = (x + width > ssd->width) ? ssd->width - 1 : x + width - 1;
+  uint8_t y1 = (y + height > ssd->height) ? ssd->height - 1 : y + height - 1;
+  uint8_t p0 = y >> 3;
+  uint8_t p1 = y1 >> 3;
+  if (!ssd->dirty) {
+    ssd->dirty_x0 = x;
+    ssd->dirty_x1 = x1;
+    ssd->dirty_p0 = p0;
+    ssd->dirty_p1 = p1;
+    ssd->dirty = true;
+    return;
+  }
+  if (x < ssd->dirty_x0) ssd->dirty_x0 = x;
+  if (x1 > ssd->dirty_x1) ssd->dirty_x1 = x1;
+  if (p0 < ssd->dirty_p0) ssd->dirty_p0 = p0;
+  if (p1 > ssd->dirty_p1) ssd->dirty_p1 = p1;
+}
+
+// Envia somente o retângulo sujo, na ordem do modo de endereçamento do painel
+void ssd1306_send_dirty(ssd1306_t *ssd) {
+  if (!ssd->dirty)
+    return;
+
+  trace(TRACE_I2C_INICIO, 1, (ssd->dirty_x1 - ssd->dirty_x0 + 1) * (ssd->dirty_p1 - ssd->dirty_p0 + 1) + 1);
+  int enviados = painel_de(ssd).envia_janela(ssd->dirty_x0, ssd->dirty_x1, ssd->dirty_p0, ssd->dirty_p1);
+  trace(TRACE_I2C_FIM, 1, enviados);
+  ssd->dirty = false;
+  if (ssd->ao_enviar)
+    ssd->ao_enviar(ssd, ssd->dirty_x0, ssd->dirty_x1, ssd->dirty_p0, ssd->dirty_p1);
+}
+
+void ssd1306_pixel(ssd1306_t *ssd, uint8_t x, uint8_t y, bool value) {
+  (void)ssd;
+  Painel::pixel(x, y, value);
+}
+
+void ssd1306_fill(ssd1306_t *ssd, bool value) {
+  (void)ssd;
+  Painel::preenche(value);
+}
+
+void ssd1306_rect(ssd1306_t *ssd, uint8_t top, uint8_t left, uint8_t width, uint8_t height, bool value, bool fill) {
+  if (!width || !height)
+    return;
+  uint8_t right = left + width - 1;
+  uint8_t bottom = top + height - 1;
+  Painel::linha_h(left, right, top, value);
+  Painel::linha_h(left, right, bottom, value);
+  Painel::linha_v(left, top, bottom, value);
+  Painel::linha_v(right, top, bottom, value);
+
+  if (fill && width > 2 && height > 2) {
+    for (uint16_t y = top + 1; y < bottom; ++y)
+      Painel::linha_h(left + 1, right - 1, y, value);
+  }
+}
+
+void ssd1306_line(ssd1306_t *ssd, uint8_t x0, uint8_t y0, uint8_t x1, uint8_t y1, bool value) {
+    int dx = abs(x1 - x0);
+    int dy = abs(y1 - y0);
+
+    int sx = (x0 < x1) ? 1 : -1;
+    int sy = (y0 < y1) ? 1 : -1;
+
+    int err = dx - dy;
+
+    while (true) {
+        ssd1306_pixel(ssd, x0, y0, value); // Desenha o pixel atual
+
+        if (x0 == x1 && y0 == y1) break; // Termina quando alcança o ponto final
+
+        int e2 = err * 2;
+
+        if (e2 > -dy) {
+            err -= dy;
+            x0 += sx;
+        }
+
+        if (e2 < dx) {
+            err += dx;
+            y0 += sy;
+        }
+    }
+}
+
+void ssd1306_hline(ssd1306_t *ssd, uint8_t x0, uint8_t x1, uint8_t y, bool value) {
+  (void)ssd;
+  Painel::linha_h(x0, x1, y, value);
+}
+
+void ssd1306_vline(ssd1306_t *ssd, uint8_t x, uint8_t y0, uint8_t y1, bool value) {
+  (void)ssd;
+  Painel::linha_v(x, y0, y1, value);
+}
+
+void ssd1306_draw_column(ssd1306_t *ssd, uint8_t x, uint8_t y, uint32_t bits, uint8_t height) {
+  (void)ssd;
+  Painel::coluna(x, y, bits, height);
+}
+
+// Função para desenhar um caractere
+void ssd1306_draw_char(ssd1306_t *ssd, char c, uint8_t x, uint8_t y)
+{
+  // Caracteres fora da faixa ASCII imprimível viram espaço (índice 0)
+  uint16_t index = (c >= ' ' && c <= '~') ? (c - ' ') * 8 : 0;
+
+  // Cada byte da fonte é uma coluna de 8 pixels
+  for (uint8_t i = 0; i < 8; ++i)
+    Painel::coluna(x + i, y, font[index + i], 8);
+}
+
+// Função para desenhar uma string
+void ssd1306_draw_string(ssd1306_t *ssd, const char *str, uint8_t x, uint8_t y)
+{
+  while (*str)
+  {
+    ssd1306_draw_char(ssd, *str++, x, y);
+    x += 8;
+    if (x + 8 >= ssd->width)
+    {
+      x = 0;
+      y += 8;
+    }
+    if (y + 8 >= ssd->height)
+    {
+      break;
+    }
+  }
+}
@@ -0,0 +1,227 @@
+#ifndef SSD1306_HPP
+#define SSD1306_HPP
+
+/**
+ * Driver SSD1306 só de cabeçalho, parametrizado em tempo de compilação pela
+ * geometria do painel, pelo modo de endereçamento e pelo transporte.
+ *
+ * Com largura, altura e modo fixos, o cálculo de índices é constexpr e os
+ * laços têm limites constantes, o que permite ao compilador desenrolá-los
+ * para 128x64 e 128x32. O framebuffer é um std::array estático por
+ * instância do modelo (byte de controle 0x40 seguido dos dados), sem heap.
+ *
+ * O transporte precisa apenas de `int escreve(const uint8_t *, size_t)`,
+ * que envia um bloco já com o byte de controle na frente.
+ *
+ * A API em C (ssd1306.h) é implementada sobre este modelo em ssd1306.cpp.
+ */
+
+#include <array>
+#include <stddef.h>
+#include <stdint.h>
+
+#include "hardware/i2c.h"
+
+namespace ssd1306 {
+
+enum class Enderecamento : uint8_t {
+    horizontal = 0x00,  // Percorre a página inteira antes de descer
+    vertical = 0x01,    // Percorre as páginas de cada coluna antes de avançar
+};
+
+// Transporte pelo I2C do RP2040 (bloqueante)
+struct TransporteI2C {
+    i2c_inst_t *porta;
+    uint8_t endereco;
+
+    int escreve(const uint8_t *dados, size_t len) const {
+        return i2c_write_blocking(porta, endereco, dados, len, false);
+    }
+};
+
+template <uint8_t Largura, uint8_t Altura, Enderecamento Modo, class Transporte>
+class Painel {
+public:
+    static_assert(Largura > 0 && Largura <= 128, "largura fora do alcance do SSD1306");
+    static_assert(Altura == 32 || Altura == 64, "altura suportada: 32 ou 64 linhas");
+
+    static constexpr uint8_t largura = Largura;
+    static constexpr uint8_t altura = Altura;
+    static constexpr uint8_t paginas = Altura / 8;
+    static constexpr size_t tam_dados = size_t(Largura) * paginas;
+    static constexpr size_t tam_buffer = tam_dados + 1;
+
+    using buffer_t = std::array<uint8_t, tam_buffer>;
+
+    // Framebuffer compartilhado por todos os objetos desta geometria
+    static inline buffer_t buffer{0x40};
+
+    Transporte transporte;
+
+    constexpr explicit Painel(Transporte t) : transporte(t) {}
+
+    // Posição no buffer (já contando o byte de controle) da coluna x, página p
+    static constexpr size_t indice(uint8_t x, uint8_t pagina) {
+        return Modo == Enderecamento::vertical ? 1 + size_t(x) * paginas + pagina
+                                               : 1 + size_t(pagina) * Largura + x;
+    }
+
+    static constexpr uint8_t mascara(uint8_t y) { return uint8_t(1u << (y & 7)); }
+
+    void comando(uint8_t c) const {
+        const uint8_t pacote[2] = {0x80, c};
+        transporte.escreve(pacote, 2);
+    }
+
+    void configura() const {
+        static constexpr uint8_t sequencia[] = {
+            0xAE,                     // Display desligado
+            0x20, uint8_t(Modo),      // Modo de endereçamento
+            0x40,                     // Linha inicial 0
+            0xA1,                     // Segmentos remapeados
+            0xA8, Altura - 1,         // Multiplex
+            0xC8,                     // Varredura COM invertida
+            0xD3, 0x00,               // Sem deslocamento
+            0xDA, Altura == 64 ? 0x12 : 0x02,  // Ligação dos pinos COM
+            0xD5, 0x80,               // Divisor do clock
+            0xD9, 0xF1,               // Pré-carga
+            0xDB, 0x30,               // Nível VCOMH
+            0x81, 0xFF,               // Contraste
+            0xA4,                     // Segue a RAM
+            0xA6,                     // Não invertido
+            0x8D, 0x14,               // Bomba de carga
+            0xAF,                     // Display ligado
+        };
+        for (uint8_t c : sequencia) {
+            comando(c);
+        }
+    }
+
+    void janela(uint8_t x0, uint8_t x1, uint8_t p0, uint8_t p1) const {
+        comando(0x21);
+        comando(x0);
+        comando(x1);
+        comando(0x22);
+        comando(p0);
+        comando(p1);
+    }
+
+    // Envia o quadro inteiro; retorna o resultado do transporte
+    int envia() const {
+        janela(0, Largura - 1, 0, paginas - 1);
+        return transporte.escreve(buffer.data(), tam_buffer);
+    }
+
+    // Bytes de dados por transação em envia_janela (montados na pilha)
+    static constexpr size_t tam_parte = 64;
+
+    /**
+     * Envia só as colunas x0..x1 das páginas p0..p1, na ordem em que o
+     * controlador as percorre no modo atual. Os bytes saem do framebuffer em
+     * partes de tam_parte, cada uma numa transação com o próprio byte de
+     * controle; o ponteiro da GDDRAM continua de onde a anterior parou.
+     * Retorna os bytes escritos ou o primeiro erro do transporte.
+     */
+    int envia_janela(uint8_t x0, uint8_t x1, uint8_t p0, uint8_t p1) const {
+        if (x0 == 0 && x1 == Largura - 1 && p0 == 0 && p1 == paginas - 1) {
+            return envia();  // Quadro inteiro: sai direto do framebuffer
+        }
+        uint8_t parte[1 + tam_parte];
+        parte[0] = 0x40;
+        size_t len = 1;
+        int total = 0;
+        auto esvazia = [&]() {
+            int r = transporte.escreve(parte, len);
+            if (total >= 0) {
+                total = r < 0 ? r : total + r;
+            }
+            len = 1;
+        };
+        janela(x0, x1, p0, p1);
+        if constexpr (Modo == Enderecamento::vertical) {
+            for (uint16_t x = x0; x <= x1; ++x) {
+                for (uint16_t p = p0; p <= p1; ++p) {
+                    parte[len++] = buffer[indice(x, p)];
+                    if (len == sizeof(parte)) {
+                        esvazia();
+                    }
+                }
+            }
+        } else {
+            for (uint16_t p = p0; p <= p1; ++p) {
+                for (uint16_t x = x0; x <= x1; ++x) {
+                    parte[len++] = buffer[indice(x, p)];
+                    if (len == sizeof(parte)) {
+                        esvazia();
+                    }
+                }
+            }
+        }
+        if (len > 1) {
+            esvazia();
+        }
+        return total;
+    }
+
+    static void pixel(uint8_t x, uint8_t y, bool valor) {
+        if (x >= Largura || y >= Altura) {
+            return;
+        }
+        uint8_t &b = buffer[indice(x, y >> 3)];
+        b = valor ? (b | mascara(y)) : (b & ~mascara(y));
+    }
+
+    static void preenche(bool valor) {
+        const uint8_t byte = valor ? 0xFF : 0x00;
+        for (size_t i = 1; i < tam_buffer; ++i) {
+            buffer[i] = byte;
+        }
+    }
+
+    static void linha_h(uint8_t x0, uint8_t x1, uint8_t y, bool valor) {
+        if (y >= Altura) {
+            return;
+        }
+        const uint8_t m = mascara(y);
+        const uint8_t pagina = y >> 3;
+        for (uint16_t x = x0; x <= x1 && x < Largura; ++x) {
+            uint8_t &b = buffer[indice(x, pagina)];
+            b = valor ? (b | m) : (b & ~m);
+        }
+    }
+
+    static void linha_v(uint8_t x, uint8_t y0, uint8_t y1, bool valor) {
+        for (uint16_t y = y0; y <= y1 && y < Altura; ++y) {
+            pixel(x, y, valor);
+        }
+    }
+
+    // Escreve até 32 pixels verticais de uma vez, página a página (opaco na altura dada)
+    static void coluna(uint8_t x, uint8_t y, uint32_t bits, uint8_t alt) {
+        if (x >= Largura || y >= Altura || alt == 0) {
+            return;
+        }
+        const uint8_t desloc = y & 7;
+        uint64_t m = ((alt >= 32) ? 0xFFFFFFFFull : ((1ull << alt) - 1)) << desloc;
+        uint64_t v = (uint64_t(bits) << desloc) & m;
+        for (uint8_t p = y >> 3; p < paginas && m; ++p) {
+            const uint8_t mb = uint8_t(m);
+            if (mb) {
+                uint8_t &b = buffer[indice(x, p)];
+                b = (b & ~mb) | uint8_t(v);
+            }
+            m >>= 8;
+            v >>= 8;
+        }
+    }
+};
+
+// Os dois painéis usados com a BitDogLab e módulos comuns
+template <class Transporte>
+using Painel128x64 = Painel<128, 64, Enderecamento::vertical, Transporte>;
+template <class Transporte>
+using Painel128x32 = Painel<128, 32, Enderecamento::vertical, Transporte>;
+
+}  // namespace ssd1306
+
+#endif // SSD1306_HPP
@@ -0,0 +1,55 @@
+#include <stdio.h>
+#include <string.h>
+
+#include "tela.h"
+
+int tela_cabecalho_pbm(const ssd1306_t *ssd, char *saida, size_t max) {
+    return snprintf(saida, max, "P4\n%d %d\n", ssd->width, ssd->height);
+}
+
+size_t tela_tam_pbm(const ssd1306_t *ssd) {
+    return (size_t)ssd->width / 8 * ssd->height;
+}
+
+/**
+ * PBM binário (P4): largura/8 bytes por linha, bit mais significativo à
+ * esquerda, 1 = preto. O framebuffer guarda colunas de 8 pixels com
+ * 1 = aceso, daí a transposição e a inversão.
+ */
+size_t tela_codifica_pagina_pbm(const ssd1306_t *ssd, uint8_t pagina, uint8_t *saida) {
+    const uint8_t *colunas = ssd->ram_buffer + 1 + pagina;
+    size_t n = 0;
+    for (uint8_t linha = 0; linha < 8; linha++) {
+        for (uint16_t x = 0; x < ssd->width; x += 8) {
+            uint8_t byte = 0;
+            for (uint8_t i = 0; i < 8; i++) {
+                byte = (byte << 1) | ((colunas[(x + i) * ssd->pages] >> linha) & 1);
+            }
+            saida[n++] = (uint8_t)~byte;
+        }
+    }
+    return n;
+}
+
+size_t tela_tam_registro(uint8_t x0, uint8_t x1, uint8_t p0, uint8_t p1) {
+    return TELA_REGISTRO_CAB + (size_t)(x1 - x0 + 1) * (p1 - p0 + 1);
+}
+
+size_t tela_codifica_registro(const ssd1306_t *ssd, uint32_t seq, uint8_t x0, uint8_t x1, uint8_t p0, uint8_t p1,
+                              uint8_t *saida) {
+    uint8_t paginas = p1 - p0 + 1;
+    saida[0] = seq & 0xFF;
+    saida[1] = (seq >> 8) & 0xFF;
+    saida[2] = (seq >> 16) & 0xFF;
+    saida[3] = seq >> 24;
+    saida[4] = x0;
+    saida[5] = x1;
+    saida[6] = p0;
+    saida[7] = p1;
+    uint8_t *d = saida + TELA_REGISTRO_CAB;
+    for (uint16_t x = x0; x <= x1; x++) {
+        memcpy(d, ssd->ram_buffer + 1 + x * ssd->pages + p0, paginas);
+        d += paginas;
+    }
+    return (size_t)(d - saida);
+}
@@ -0,0 +1,28 @@
+#ifndef TELA_H
+#define TELA_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include "ssd1306.h"
+
+// Codificação do framebuffer do OLED para o espelho em /tela.pbm e
+// /tela/delta. Só leem o framebuffer (colunas de 8 pixels, bit 0 no topo,
+// 1 = aceso); o envio pela rede fica em webserver.c.
+
+// Registro de /tela/delta: seq (u32 little-endian), x0, x1, p0, p1 e as
+// colunas x0..x1 com as páginas p0..p1 de cada uma
+#define TELA_REGISTRO_CAB 8
+
+// Cabeçalho "P4\n<largura> <altura>\n"; retorna o tamanho como snprintf
+int tela_cabecalho_pbm(const ssd1306_t *ssd, char *saida, size_t max);
+// Bytes de imagem do PBM (sem o cabeçalho)
+size_t tela_tam_pbm(const ssd1306_t *ssd);
+// Codifica as 8 linhas de uma página (largura bytes); retorna o tamanho
+size_t tela_codifica_pagina_pbm(const ssd1306_t *ssd, uint8_t pagina, uint8_t *saida);
+
+size_t tela_tam_registro(uint8_t x0, uint8_t x1, uint8_t p0, uint8_t p1);
+// Monta o registro da janela com o conteúdo atual; retorna o tamanho
+size_t tela_codifica_registro(const ssd1306_t *ssd, uint32_t seq, uint8_t x0, uint8_t x1, uint8_t p0, uint8_t p1,
+                              uint8_t *saida);
+
+#endif // TELA_H
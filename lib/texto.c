@@ -0,0 +1,127 @@
+#include "texto.h"
+
+#define CODIGO_INVALIDO '?'
+
+/**
+ * Decodifica o próximo código UTF-8 e avança o ponteiro.
+ * Sequências inválidas retornam '?' e consomem um byte; fim da string retorna 0.
+ */
+uint32_t texto_utf8_proximo(const char **str) {
+    const uint8_t *s = (const uint8_t *)*str;
+    uint32_t cp;
+    uint8_t extras;
+
+    if (s[0] == 0)
+        return 0;
+    if (s[0] < 0x80) {
+        *str += 1;
+        return s[0];
+    } else if ((s[0] & 0xE0) == 0xC0) {
+        cp = s[0] & 0x1F;
+        extras = 1;
+    } else if ((s[0] & 0xF0) == 0xE0) {
+        cp = s[0] & 0x0F;
+        extras = 2;
+    } else if ((s[0] & 0xF8) == 0xF0) {
+        cp = s[0] & 0x07;
+        extras = 3;
+    } else {
+        *str += 1;
+        return CODIGO_INVALIDO;
+    }
+
+    for (uint8_t i = 1; i <= extras; ++i) {
+        if ((s[i] & 0xC0) != 0x80) {
+            *str += 1;
+            return CODIGO_INVALIDO;
+        }
+        cp = (cp << 6) | (s[i] & 0x3F);
+    }
+    *str += extras + 1;
+    return cp;
+}
+
+static const texto_glifo_t *busca_glifo(const texto_fonte_t *fonte, uint32_t *cp) {
+    if (*cp >= fonte->primeiro && *cp <= fonte->ultimo) {
+        const texto_glifo_t *g = &fonte->glifos[*cp - fonte->primeiro];
+        if (g->avanco)
+            return g;
+    }
+    // Fora do atlas: usa '?' (ou o primeiro glifo, se a fonte não o tiver)
+    *cp = CODIGO_INVALIDO;
+    if (CODIGO_INVALIDO >= fonte->primeiro && CODIGO_INVALIDO <= fonte->ultimo &&
+        fonte->glifos[CODIGO_INVALIDO - fonte->primeiro].avanco)
+        return &fonte->glifos[CODIGO_INVALIDO - fonte->primeiro];
+    *cp = fonte->primeiro;
+    return &fonte->glifos[0];
+}
+
+// Busca binária na tabela de kerning (ordenada por esquerda, direita)
+static int8_t kerning(const texto_fonte_t *fonte, uint32_t esquerda, uint32_t direita) {
+    int inicio = 0;
+    int fim = (int)fonte->num_kerning - 1;
+    uint16_t chave = (uint16_t)((esquerda << 8) | direita);
+    if (esquerda > 0xFF || direita > 0xFF)
+        return 0;
+    while (inicio <= fim) {
+        int meio = (inicio + fim) / 2;
+        const texto_kerning_t *k = &fonte->kerning[meio];
+        uint16_t atual = (uint16_t)((k->esquerda << 8) | k->direita);
+        if (atual == chave)
+            return k->ajuste;
+        if (atual < chave)
+            inicio = meio + 1;
+        else
+            fim = meio - 1;
+    }
+    return 0;
+}
+
+// Largura em pixels que a string ocupará, incluindo kerning
+uint16_t texto_largura(const texto_fonte_t *fonte, const char *str) {
+    uint16_t largura = 0;
+    uint32_t anterior = 0;
+    uint32_t cp;
+    while ((cp = texto_utf8_proximo(&str)) != 0) {
+        const texto_glifo_t *g = busca_glifo(fonte, &cp);
+        if (anterior)
+            largura += kerning(fonte, anterior, cp);
+        largura += g->avanco;
+        anterior = cp;
+    }
+    // O último avanço inclui uma coluna de espaçamento que não conta
+    return largura ? largura - 1 : 0;
+}
+
+/**
+ * Desenha a string copiando colunas inteiras do atlas para o framebuffer
+ * (fundo apagado dentro da altura da fonte). Retorna o x final.
+ */
+uint8_t texto_desenha(ssd1306_t *ssd, const texto_fonte_t *fonte, const char *str, uint8_t x, uint8_t y) {
+    uint32_t anterior = 0;
+    uint32_t cp;
+    int16_t cx = x;
+
+    while ((cp = texto_utf8_proximo(&str)) != 0) {
+        const texto_glifo_t *g = busca_glifo(fonte, &cp);
+        if (anterior)
+            cx += kerning(fonte, anterior, cp);
+        anterior = cp;
+
+        const uint8_t *coluna = &fonte->bitmap[g->offset];
+        for (uint8_t i = 0; i < g->avanco; ++i, ++cx) {
+            if (cx < 0)
+                continue;
+            if (cx >= ssd->width)
+                return ssd->width;
+            uint32_t bits = 0;
+            if (i < g->largura) {
+                for (uint8_t p = 0; p < fonte->paginas; ++p)
+                    bits |= (uint32_t)coluna[p] << (8 * p);
+                coluna += fonte->paginas;
+            }
+            ssd1306_draw_column(ssd, (uint8_t)cx, y, bits, fonte->altura);
+        }
+    }
+    return (uint8_t)cx;
+}
@@ -0,0 +1,37 @@
+#ifndef TEXTO_H
+#define TEXTO_H
+
+#include <stdint.h>
+#include "ssd1306.h"
+
+// Entrada do atlas: deslocamento no bitmap, colunas desenhadas e avanço
+// horizontal (avanço 0 = glifo ausente)
+typedef struct {
+    uint16_t offset;
+    uint8_t largura;
+    uint8_t avanco;
+} texto_glifo_t;
+
+// Ajuste horizontal para um par de caracteres
+typedef struct {
+    uint8_t esquerda, direita;
+    int8_t ajuste;
+} texto_kerning_t;
+
+// Fonte proporcional gerada por tools/gera_fonte.py; o bitmap guarda cada
+// coluna como `paginas` bytes consecutivos, no formato do framebuffer
+typedef struct {
+    uint8_t altura;
+    uint8_t paginas;
+    uint16_t primeiro, ultimo;
+    const texto_glifo_t *glifos;
+    const uint8_t *bitmap;
+    const texto_kerning_t *kerning;
+    uint16_t num_kerning;
+} texto_fonte_t;
+
+uint32_t texto_utf8_proximo(const char **str);
+uint16_t texto_largura(const texto_fonte_t *fonte, const char *str);
+uint8_t texto_desenha(ssd1306_t *ssd, const texto_fonte_t *fonte, const char *str, uint8_t x, uint8_t y);
+
+#endif // TEXTO_H
@@ -0,0 +1,80 @@
+#include <stdio.h>
+#include <string.h>
+
+#include "trace.h"
+
+trace_anel_t trace_aneis[TRACE_NUCLEOS];
+
+/**
+ * Cabeçalho do despejo binário (little-endian): "TRC" + versão, núcleos,
+ * reservado, registros por anel (16 bits), tamanho do registro, 3 bytes
+ * reservados, instante da captura em us e a contagem de escrita de cada
+ * núcleo nesse instante. Em seguida vem o conteúdo bruto de trace_aneis.
+ */
+uint16_t trace_cabecalho(uint8_t *buf) {
+    uint32_t agora = time_us_32();
+    buf[0] = 'T';
+    buf[1] = 'R';
+    buf[2] = 'C';
+    buf[3] = TRACE_VERSAO;
+    buf[4] = TRACE_NUCLEOS;
+    buf[5] = 0;
+    buf[6] = TRACE_TAM & 0xFF;
+    buf[7] = TRACE_TAM >> 8;
+    buf[8] = sizeof(trace_registro_t);
+    buf[9] = 0;
+    buf[10] = 0;
+    buf[11] = 0;
+    memcpy(&buf[12], &agora, sizeof(agora));
+    for (int i = 0; i < TRACE_NUCLEOS; i++) {
+        uint32_t escrita = trace_aneis[i].escrita;
+        memcpy(&buf[16 + 4 * i], &escrita, sizeof(escrita));
+    }
+    return TRACE_CABECALHO_TAM;
+}
+
+#define DESPEJO_LINHA    32     // Bytes dos anéis por linha "TRACE <hex>"
+#define DESPEJO_PASSO_US 50000  // Orçamento de cada passo no laço principal
+_Static_assert(TRACE_CABECALHO_TAM <= DESPEJO_LINHA, "cabeçalho cabe numa linha");
+
+static bool despejando = false;
+static size_t despejo_pos = 0;  // Próximo byte de trace_aneis a escrever
+
+// Uma linha "TRACE <hex>" num único printf: com a USB sem leitura, cada
+// chamada bloqueia no máximo o timeout da stdio
+static void escreve_linha(const uint8_t *dados, size_t n) {
+    char linha[sizeof("TRACE ") + 2 * DESPEJO_LINHA + 1];
+    size_t len = (size_t)snprintf(linha, sizeof(linha), "TRACE ");
+    for (size_t i = 0; i < n; i++) {
+        len += (size_t)snprintf(linha + len, sizeof(linha) - len, "%02x", dados[i]);
+    }
+    printf("%s\n", linha);
+}
+
+// Inicia o despejo: o cabeçalho sai agora e os anéis em trace_despeja_usb_passo
+void trace_despeja_usb(void) {
+    uint8_t cabecalho[TRACE_CABECALHO_TAM];
+    escreve_linha(cabecalho, trace_cabecalho(cabecalho));
+    despejo_pos = 0;
+    despejando = true;
+}
+
+bool trace_despeja_usb_passo(void) {
+    if (!despejando) {
+        return false;
+    }
+    const uint8_t *dados = (const uint8_t *)trace_aneis;
+    uint32_t inicio = time_us_32();
+    while (despejo_pos < sizeof(trace_aneis) && time_us_32() - inicio < DESPEJO_PASSO_US) {
+        size_t n = sizeof(trace_aneis) - despejo_pos;
+        n = n < DESPEJO_LINHA ? n : DESPEJO_LINHA;
+        escreve_linha(dados + despejo_pos, n);
+        despejo_pos += n;
+    }
+    if (despejo_pos < sizeof(trace_aneis)) {
+        return true;
+    }
+    printf("TRACE FIM\n");
+    despejando = false;
+    return false;
+}
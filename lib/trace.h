@@ -0,0 +1,93 @@
+#ifndef TRACE_H
+#define TRACE_H
+
+#include <stdbool.h>
+#include <stdint.h>
+#include "pico/stdlib.h"
+#include "hardware/sync.h"
+
+// Rastreamento binário de eventos com carimbo de tempo, em anel por núcleo.
+// Cada evento custa algumas dezenas de ciclos: sem formatação e sem E/S.
+
+#ifndef TRACE_HABILITADO
+#define TRACE_HABILITADO 1
+#endif
+
+#define TRACE_TAM     256   // Registros por núcleo (potência de 2)
+#define TRACE_NUCLEOS 2
+#define TRACE_VERSAO  1
+#define TRACE_CABECALHO_TAM (16 + 4 * TRACE_NUCLEOS)
+
+// IDs dos eventos; tools/trace_para_chrome.py lê esta lista para decodificar
+typedef enum {
+    TRACE_BOOT = 1,         // a: 1 se o watchdog causou o reinício, b: -
+    TRACE_BOMBA = 2,        // a: 1 liga / 0 desliga, b: nível x10
+    TRACE_LIMITES = 3,      // a: mínimo x10, b: máximo x10
+    TRACE_HTTP_INICIO = 4,  // a: rota, b: -
+    TRACE_HTTP_FIM = 5,     // a: rota, b: bytes da resposta
+    TRACE_WIFI = 6,         // a: estado (wifi_estado_t), b: tentativas
+    TRACE_I2C_INICIO = 7,   // a: 0 quadro inteiro / 1 retângulo sujo, b: bytes a enviar
+    TRACE_I2C_FIM = 8,      // a: idem, b: bytes enviados (negativo em erro)
+    TRACE_MODBUS = 9,       // a: código de função, b: tamanho da resposta
+    TRACE_ALARME = 10,      // a: classe (alarme_classe_t), b: -
+    TRACE_DIAGNOSTICO = 11, // a: máscara de falhas, b: leitura do ADC
+    TRACE_OTA = 12,         // a: resultado (ota_status_t), b: bytes recebidos
+} trace_evento_t;
+
+// Rotas HTTP usadas como argumento dos eventos TRACE_HTTP_*
+enum {
+    TRACE_ROTA_PAGINA,
+    TRACE_ROTA_ESTADO,
+    TRACE_ROTA_LIMITES,
+    TRACE_ROTA_METRICAS,
+    TRACE_ROTA_ALARME,
+    TRACE_ROTA_TRACE,
+    TRACE_ROTA_OTA,
+    TRACE_ROTA_TELA,
+};
+
+typedef struct {
+    uint32_t ts_us;
+    uint16_t id;
+    uint16_t a;
+    uint32_t b;
+} trace_registro_t;
+
+// Anel de um núcleo; `escrita` conta todos os eventos já registrados.
+// Cada núcleo só escreve no próprio anel, então não há trava entre núcleos.
+typedef struct {
+    uint32_t escrita;
+    uint32_t reservado;
+    trace_registro_t registros[TRACE_TAM];
+} trace_anel_t;
+
+extern trace_anel_t trace_aneis[TRACE_NUCLEOS];
+
+#if TRACE_HABILITADO
+static inline void trace(uint16_t id, uint16_t a, uint32_t b) {
+    trace_anel_t *anel = &trace_aneis[get_core_num()];
+    // Reserva do índice protegida contra IRQs do mesmo núcleo
+    uint32_t estado = save_and_disable_interrupts();
+    uint32_t i = anel->escrita++;
+    restore_interrupts(estado);
+    trace_registro_t *r = &anel->registros[i & (TRACE_TAM - 1)];
+    r->ts_us = time_us_32();
+    r->id = id;
+    r->a = a;
+    r->b = b;
+}
+#else
+#define trace(id, a, b) ((void)sizeof(id), (void)sizeof(a), (void)sizeof(b))  // Sem avaliar os argumentos
+#endif
+
+// Preenche o cabeçalho do despejo (TRACE_CABECALHO_TAM bytes) e retorna o tamanho
+uint16_t trace_cabecalho(uint8_t *buf);
+// Despejo em hexadecimal pela stdio (USB): trace_despeja_usb escreve o
+// cabeçalho e trace_despeja_usb_passo, a cada iteração do laço, as linhas
+// dos anéis que couberem em ~50 ms (cerca de 12 KB no total, que numa USB
+// lenta passariam do watchdog de uma vez). Os anéis seguem sendo escritos
+// durante o despejo, como no /trace. O passo retorna true enquanto há linhas.
+void trace_despeja_usb(void);
+bool trace_despeja_usb_passo(void);
+
+#endif // TRACE_H
@@ -0,0 +1,174 @@
+#include <string.h>
+
+#include "ui.h"
+#include "fonte_texto.h"
+
+// Assinatura FNV-1a de uma string, usada para detectar mudança de conteúdo
+static uint32_t assinatura_texto(const char *s) {
+    uint32_t h = 2166136261u;
+    if (!s)
+        return 0;
+    while (*s) {
+        h ^= (uint8_t)*s++;
+        h *= 16777619u;
+    }
+    return h;
+}
+
+// Assinatura do valor vinculado ao widget no momento
+static uint32_t assinatura(const ui_widget_t *w) {
+    switch (w->tipo) {
+        case UI_ROTULO:  return assinatura_texto(*w->fonte.texto);
+        case UI_GRAFICO: return w->fonte.historico->versao;
+        default:         return (uint32_t)*w->fonte.valor;
+    }
+}
+
+// Converte inteiro em texto decimal sem usar a família printf
+static char *formata_inteiro(char *fim, int32_t v) {
+    bool negativo = v < 0;
+    uint32_t u = negativo ? (uint32_t)(-v) : (uint32_t)v;
+    *--fim = '\0';
+    do {
+        *--fim = '0' + (u % 10);
+        u /= 10;
+    } while (u);
+    if (negativo)
+        *--fim = '-';
+    return fim;
+}
+
+static int32_t limita_0_100(int32_t v) {
+    return v < 0 ? 0 : (v > 100 ? 100 : v);
+}
+
+// Texto na fonte do widget, opcionalmente centralizado pela largura medida
+static void desenha_texto(ssd1306_t *ssd, const ui_widget_t *w, const char *texto) {
+    const texto_fonte_t *tipografia = w->tipografia ? w->tipografia : &fonte_texto;
+    uint8_t x = w->x;
+    if (w->centralizado) {
+        uint16_t largura = texto_largura(tipografia, texto);
+        if (largura < w->largura)
+            x += (w->largura - largura) / 2;
+    }
+    texto_desenha(ssd, tipografia, texto, x, w->y);
+}
+
+static void desenha(ssd1306_t *ssd, const ui_widget_t *w) {
+    switch (w->tipo) {
+        case UI_ROTULO:
+            if (*w->fonte.texto)
+                desenha_texto(ssd, w, *w->fonte.texto);
+            break;
+
+        case UI_VALOR: {
+            char buffer[20];
+            char *texto = formata_inteiro(buffer + 12, *w->fonte.valor);
+            if (w->extra.sufixo)
+                strncat(texto, w->extra.sufixo, 7);
+            desenha_texto(ssd, w, texto);
+            break;
+        }
+
+        case UI_BARRA: {
+            uint8_t preenchido = (uint8_t)(limita_0_100(*w->fonte.valor) * (w->largura - 2) / 100);
+            ssd1306_rect(ssd, w->y, w->x, w->largura, w->altura, true, false);
+            if (preenchido)
+                ssd1306_rect(ssd, w->y + 1, w->x + 1, preenchido, w->altura - 2, true, true);
+            break;
+        }
+
+        case UI_ICONE: {
+            const uint8_t *icone = w->extra.icones[*w->fonte.valor];
+            for (uint8_t i = 0; i < 8; ++i)
+                for (uint8_t j = 0; j < 8; ++j)
+                    if (icone[i] & (1 << j))
+                        ssd1306_pixel(ssd, w->x + i, w->y + j, true);
+            break;
+        }
+
+        case UI_GRAFICO: {
+            const ui_historico_t *h = w->fonte.historico;
+            uint8_t n = h->quantidade < w->largura ? h->quantidade : w->largura;
+            // Os pontos mais recentes ficam à direita
+            uint8_t x0 = w->x + w->largura - n;
+            uint8_t y_base = w->y + w->altura - 1;
+            uint8_t y_ant = 0;
+            for (uint8_t i = 0; i < n; ++i) {
+                uint8_t idx = (h->inicio + h->quantidade - n + i) % UI_HISTORICO_TAM;
+                uint8_t y = y_base - h->valores[idx] * (w->altura - 1) / 100;
+                if (i == 0)
+                    ssd1306_pixel(ssd, x0, y, true);
+                else
+                    ssd1306_line(ssd, x0 + i - 1, y_ant, x0 + i, y, true);
+                y_ant = y;
+            }
+            break;
+        }
+    }
+}
+
+void ui_init(ui_t *ui, ssd1306_t *ssd, const ui_tela_t *telas, uint8_t num_telas) {
+    ui->ssd = ssd;
+    ui->telas = telas;
+    ui->num_telas = num_telas;
+    ui_mostra_tela(ui, 0);
+}
+
+// Troca de tela: limpa o display e invalida todos os widgets da nova tela
+void ui_mostra_tela(ui_t *ui, uint8_t tela) {
+    const ui_tela_t *t = &ui->telas[tela];
+    ui->tela_atual = tela;
+    for (uint8_t i = 0; i < t->num_widgets; ++i)
+        t->widgets[i].valido = false;
+    ssd1306_fill(ui->ssd, false);
+    ssd1306_mark_dirty(ui->ssd, 0, 0, ui->ssd->width, ui->ssd->height);
+}
+
+void ui_proxima_tela(ui_t *ui) {
+    ui_mostra_tela(ui, (ui->tela_atual + 1) % ui->num_telas);
+}
+
+/**
+ * Redesenha apenas os widgets cujo valor vinculado mudou desde o último
+ * quadro e envia ao display somente a região alterada
+ */
+void ui_renderiza(ui_t *ui) {
+    const ui_tela_t *t = &ui->telas[ui->tela_atual];
+    ui->widgets_redesenhados = 0;
+    ui->pixels_redesenhados = 0;
+
+    for (uint8_t i = 0; i < t->num_widgets; ++i) {
+        ui_widget_t *w = &t->widgets[i];
+        uint32_t atual = assinatura(w);
+        if (w->valido && w->desenhado == atual)
+            continue;
+
+        ssd1306_rect(ui->ssd, w->y, w->x, w->largura, w->altura, false, true);
+        desenha(ui->ssd, w);
+        ssd1306_mark_dirty(ui->ssd, w->x, w->y, w->largura, w->altura);
+
+        w->desenhado = atual;
+        w->valido = true;
+        ui->widgets_redesenhados++;
+    }
+
+    // O que vai ao display é a janela que cobre tudo o que mudou, em páginas
+    // inteiras; widgets sobrepostos ou distantes contam o que de fato é enviado
+    if (ui->ssd->dirty)
+        ui->pixels_redesenhados = (uint32_t)(ui->ssd->dirty_x1 - ui->ssd->dirty_x0 + 1) *
+                                  (ui->ssd->dirty_p1 - ui->ssd->dirty_p0 + 1) * 8;
+    ssd1306_send_dirty(ui->ssd);
+}
+
+void ui_historico_adiciona(ui_historico_t *h, int32_t valor) {
+    uint8_t v = (uint8_t)limita_0_100(valor);
+    if (h->quantidade < UI_HISTORICO_TAM) {
+        h->valores[(h->inicio + h->quantidade) % UI_HISTORICO_TAM] = v;
+        h->quantidade++;
+    } else {
+        h->valores[h->inicio] = v;
+        h->inicio = (h->inicio + 1) % UI_HISTORICO_TAM;
+    }
+    h->versao++;
+}
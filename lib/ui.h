@@ -0,0 +1,65 @@
+#ifndef UI_H
+#define UI_H
+
+#include <stdbool.h>
+#include <stdint.h>
+#include "ssd1306.h"
+#include "texto.h"
+
+#define UI_HISTORICO_TAM 120
+
+typedef enum {
+    UI_ROTULO,    // Texto vinculado a um ponteiro de string
+    UI_VALOR,     // Inteiro vinculado com sufixo (ex.: "%")
+    UI_BARRA,     // Barra horizontal 0..100
+    UI_ICONE,     // Ícone 8x8 escolhido por índice
+    UI_GRAFICO    // Sparkline de um histórico
+} ui_tipo_t;
+
+// Histórico circular de valores 0..100 para o gráfico
+typedef struct {
+    uint8_t valores[UI_HISTORICO_TAM];
+    uint8_t inicio, quantidade;
+    uint32_t versao;
+} ui_historico_t;
+
+typedef struct {
+    ui_tipo_t tipo;
+    uint8_t x, y, largura, altura;
+    union {
+        const char *const *texto;       // UI_ROTULO
+        const int32_t *valor;           // UI_VALOR, UI_BARRA, UI_ICONE
+        const ui_historico_t *historico; // UI_GRAFICO
+    } fonte;
+    union {
+        const char *sufixo;             // UI_VALOR
+        const uint8_t (*icones)[8];     // UI_ICONE
+    } extra;
+    const texto_fonte_t *tipografia;    // UI_ROTULO/UI_VALOR (NULL = fonte_texto)
+    bool centralizado;                  // Centraliza o texto na largura do widget
+    // Estado retido: assinatura do último conteúdo desenhado
+    uint32_t desenhado;
+    bool valido;
+} ui_widget_t;
+
+typedef struct {
+    ui_widget_t *widgets;
+    uint8_t num_widgets;
+} ui_tela_t;
+
+typedef struct {
+    ssd1306_t *ssd;
+    const ui_tela_t *telas;
+    uint8_t num_telas;
+    uint8_t tela_atual;
+    uint32_t widgets_redesenhados;  // Último quadro
+    uint32_t pixels_redesenhados;   // Último quadro: pixels da janela enviada ao display
+} ui_t;
+
+void ui_init(ui_t *ui, ssd1306_t *ssd, const ui_tela_t *telas, uint8_t num_telas);
+void ui_mostra_tela(ui_t *ui, uint8_t tela);
+void ui_proxima_tela(ui_t *ui);
+void ui_renderiza(ui_t *ui);
+void ui_historico_adiciona(ui_historico_t *h, int32_t valor);
+
+#endif // UI_H
@@ -4,16 +4,30 @@
 
 #include "pico/cyw43_arch.h"
 #include "lwip/tcp.h"
+#include "lwip/stats.h"
+#include "lwip/memp.h"
+#include "hardware/clocks.h"
 
 #include "webserver.h" // Inclui o nosso novo cabeçalho
+#include "wifi.h"
+#include "alarme.h"
+#include "diagnostico.h"
+#include "trace.h"
+#include "energia.h"
+#include "ota.h"
+#include "ssd1306.h"
+#include "tela.h"
+#include "agenda.h"
 
 extern volatile float lim_min;
 extern volatile float lim_max;
 extern volatile float nivel_percentual;
 extern volatile bool bomba_ligada;
-
-#define WIFI_SSID "Sua Rede"
-#define WIFI_PASS "Sua senha"
+extern volatile bool silenciar_alarme;
+extern volatile uint32_t t_primeira_decisao_ms;
+extern volatile float lim_min_efetivo;
+extern agenda_t agenda;
+extern bool atualiza_limites(float min, float max);
 
 // Conteúdo da página HTML
 const char HTML_BODY[] =
@@ -36,6 +50,7 @@ const char HTML_BODY[] =
     "    document.getElementById('barra').style.width = data.nivel + '%';"
     "    document.getElementById('bomba').innerText = data.bomba ? 'LIGADA' : 'Desligada';"
     "    document.getElementById('bomba').style.color = data.bomba ? '#4CAF50' : '#f44336';"
+    "    document.getElementById('alarme').innerText = data.alarme + (data.silenciado ? ' (silenciado)' : '');"
     "  });"
     "}"
     "setInterval(atualizar, 1000);"
@@ -49,6 +64,7 @@ const char HTML_BODY[] =
     "<span id='nivel' style='position: absolute; top: 2px; left: 50%; transform: translateX(-50%); font-weight: bold; color:rgb(167, 179, 233);'></span>"
     "</div>"
     "<p style='font-weight: bold;'>Status da Bomba: <span id='bomba'>--</span></p>"
+    "<p style='font-weight: bold;'>Alarme: <span id='alarme'>--</span> <a href='/alarme/silenciar'>Silenciar</a></p>"
     "<div class='card-limites'>"
     "<h2>Gerenciar Limites</h2>"
     "<form action='/limites' method='get'>"
@@ -61,70 +77,948 @@ const char HTML_BODY[] =
         "</div>"
     "</div></body></html>";
 
+// /update só existe se a compilação definir os dois segredos: OTA_TOKEN
+// (cabeçalho X-Token) e OTA_CHAVE (64 dígitos hex da chave HMAC-SHA256 que
+// assina as imagens). Sem eles a rota responde 404.
+#if defined(OTA_TOKEN) != defined(OTA_CHAVE)
+#error "defina OTA_TOKEN e OTA_CHAVE juntos para habilitar /update"
+#endif
+#if defined(OTA_TOKEN)
+#define OTA_HABILITADO 1
+_Static_assert(sizeof(OTA_CHAVE) == 2 * SHA256_TAM + 1, "OTA_CHAVE deve ter 64 dígitos hexadecimais");
+#else
+#define OTA_HABILITADO 0
+#endif
+#define OTA_ATRASO_TROCA_MS 1000       // Tempo para a resposta sair antes da troca
+
+#define HTTP_POLL_INTERVALO 2  // Timer lento (500 ms) entre tentativas de envio
+#define HTTP_POLL_MAX 8        // Tentativas sem progresso até abortar a conexão
+
+#define METRICAS_CABECALHO_MAX 128  // Espaço reservado ao cabeçalho de /metricas
+
+#define TELA_MAX_ASSINANTES 2  // Conexões simultâneas em /tela/delta
+
+#define ESTADO_NUM_BUFFERS 4
+#define ESTADO_TAM 384
+
+// Resposta completa de /estado (cabeçalho + JSON), gerada uma vez por amostra
+// e compartilhada por referência entre todas as conexões
+typedef struct {
+    char dados[ESTADO_TAM];
+    uint16_t len;
+    uint16_t corpo;     // Início do JSON dentro de dados
+    uint32_t seq;       // Versão usada como ETag
+    uint8_t refs;       // Conexões que ainda estão enviando este buffer
+} estado_buffer_t;
+
+static estado_buffer_t estado_buffers[ESTADO_NUM_BUFFERS];
+static estado_buffer_t *volatile estado_atual = NULL;
+static uint32_t estado_seq = 0;
+static bool servidor_ativo = false;
+
+// Contadores de custo das requisições
+static uint32_t http_requisicoes = 0;
+static uint32_t estado_requisicoes = 0;
+static uint32_t estado_nao_modificado = 0;
+static uint32_t estado_us_total = 0;
+static uint32_t estado_publicacoes = 0;
+
+// Resposta de /tela que continua sendo gerada em http_sent
+typedef enum {
+    TELA_NENHUM,
+    TELA_PBM,    // Imagem PBM codificada página a página
+    TELA_DELTA,  // Registros com as janelas enviadas ao display
+} tela_modo_t;
+
 // Estrutura para manter o estado da resposta HTTP
 struct http_state {
-    char response[4096];
+    char response[1792];
+    const char *dados;        // Dados a enviar (response ou buffer compartilhado)
+    size_t dados_len;
+    const char *corpo;        // Corpo constante enviado sem cópia (opcional)
+    size_t corpo_len;
     size_t len;
     size_t sent;
+    size_t enfileirado;       // Bytes de dados + corpo já aceitos pelo tcp_write
+    uint8_t tentativas;       // Polls seguidos sem conseguir enfileirar
+    estado_buffer_t *estado;  // Referência retida ao buffer de /estado
+    bool upload;              // Corpo da requisição é uma imagem para /update
+    struct tcp_pcb *pcb;
+    uint8_t tela;             // tela_modo_t
+    uint8_t tela_pagina;      // Próxima página do PBM
+    bool tela_pendente;       // Janela de /tela/delta aguardando espaço no envio
+    uint8_t tela_x0, tela_x1, tela_p0, tela_p1;
 };
 
+_Static_assert(TELA_REGISTRO_CAB + WIDTH * HEIGHT / 8 <= sizeof(((struct http_state *)0)->response),
+               "registro de /tela/delta não cabe em response");
+
+// Espelho do OLED: framebuffer do display e conexões que recebem as mudanças
+static ssd1306_t *tela = NULL;
+static struct http_state *tela_assinantes[TELA_MAX_ASSINANTES];
+static uint32_t tela_seq = 0;
+static uint32_t tela_registros = 0;
+static uint32_t tela_coalescidos = 0;
+
+// Atualização de firmware: uma sessão por vez. O recv só enfileira os pbufs
+// (a janela TCP fecha até serem gravados); a flash é apagada e programada no
+// laço principal, em webserver_ota_processa
+static ota_escrita_t ota_upload;
+static struct http_state *ota_dono = NULL;
+static struct pbuf *ota_fila = NULL;     // Dados recebidos ainda não gravados
+static u16_t ota_fila_inicio = 0;        // Bytes de cabeçalho HTTP no início da fila
+static uint32_t ota_a_confirmar = 0;     // Bytes da fila ainda não passados ao tcp_recved
+static uint32_t ota_chegados = 0;        // Bytes da imagem recebidos (gravados ou na fila)
+static uint32_t ota_chegados_poll = 0;   // ota_chegados no último poll do upload
+static bool ota_gravando = false;        // Laço principal está gravando uma parte da fila
+static uint32_t ota_t_inicio_us = 0;
+static uint32_t ota_bytes = 0;
+static uint32_t ota_duracao_ms = 0;
+static ota_status_t ota_resultado = OTA_OK;
+static bool ota_pronta = false;
+static uint32_t ota_concluida_ms = 0;
+
+/**
+ * Envia a janela acumulada de um assinante de /tela/delta se couber no buffer
+ * de envio; senão ela continua crescendo até o próximo ACK. Os dados são
+ * copiados, pois o framebuffer muda no quadro seguinte.
+ */
+static void tela_delta_envia(struct http_state *hs, struct tcp_pcb *tpcb) {
+    if (!hs->tela_pendente) {
+        return;
+    }
+    if (tcp_sndbuf(tpcb) < tela_tam_registro(hs->tela_x0, hs->tela_x1, hs->tela_p0, hs->tela_p1)) {
+        return;
+    }
+    size_t len = tela_codifica_registro(tela, tela_seq, hs->tela_x0, hs->tela_x1, hs->tela_p0, hs->tela_p1,
+                                        (uint8_t *)hs->response);
+    if (tcp_write(tpcb, hs->response, len, TCP_WRITE_FLAG_COPY) != ERR_OK) {
+        return;
+    }
+    hs->tela_pendente = false;
+    tela_registros++;
+    tcp_output(tpcb);
+}
+
+// Gera o próximo trecho de /tela.pbm ou de /tela/delta conforme há espaço
+static void tela_continua(struct http_state *hs, struct tcp_pcb *tpcb) {
+    if (hs->enfileirado < hs->dados_len + hs->corpo_len) {
+        return;  // O cabeçalho ainda não entrou inteiro na fila de envio
+    }
+    if (hs->tela == TELA_DELTA) {
+        tela_delta_envia(hs, tpcb);
+        return;
+    }
+    // Quantas páginas couberem no buffer de envio, codificadas em response
+    size_t pagina_tam = tela_tam_pbm(tela) / tela->pages;
+    size_t n = 0;
+    while (hs->tela_pagina < tela->pages && n + pagina_tam <= sizeof(hs->response) &&
+           n + pagina_tam <= tcp_sndbuf(tpcb)) {
+        n += tela_codifica_pagina_pbm(tela, hs->tela_pagina, (uint8_t *)hs->response + n);
+        hs->tela_pagina++;
+    }
+    if (n && tcp_write(tpcb, hs->response, n, TCP_WRITE_FLAG_COPY) == ERR_OK) {
+        tcp_output(tpcb);
+    } else if (n) {
+        hs->tela_pagina -= n / pagina_tam;  // Sem memória: tenta de novo no próximo ACK
+    }
+}
+
+// Chamada pelo driver após cada envio ao display (laço principal)
+static void tela_enviada(const ssd1306_t *ssd, uint8_t x0, uint8_t x1, uint8_t p0, uint8_t p1) {
+    if (!servidor_ativo) {
+        return;
+    }
+    cyw43_arch_lwip_begin();
+    tela_seq++;
+    for (int i = 0; i < TELA_MAX_ASSINANTES; i++) {
+        struct http_state *hs = tela_assinantes[i];
+        if (!hs) {
+            continue;
+        }
+        if (hs->tela_pendente) {
+            // Cliente ainda não recebeu a anterior: une as janelas
+            if (x0 < hs->tela_x0) hs->tela_x0 = x0;
+            if (x1 > hs->tela_x1) hs->tela_x1 = x1;
+            if (p0 < hs->tela_p0) hs->tela_p0 = p0;
+            if (p1 > hs->tela_p1) hs->tela_p1 = p1;
+            tela_coalescidos++;
+        } else {
+            hs->tela_x0 = x0;
+            hs->tela_x1 = x1;
+            hs->tela_p0 = p0;
+            hs->tela_p1 = p1;
+            hs->tela_pendente = true;
+        }
+        tela_delta_envia(hs, hs->pcb);
+    }
+    cyw43_arch_lwip_end();
+}
+
+static int tela_num_assinantes(void) {
+    int n = 0;
+    for (int i = 0; i < TELA_MAX_ASSINANTES; i++) {
+        n += tela_assinantes[i] != NULL;
+    }
+    return n;
+}
+
+void webserver_espelha_tela(ssd1306_t *ssd) {
+    tela = ssd;
+    ssd->ao_enviar = tela_enviada;
+}
+
+static void http_libera(struct http_state *hs) {
+    if (hs == ota_dono) {
+        // Conexão caiu ou parou (http_poll) no meio do upload: sessão e
+        // dados na fila descartados
+        ota_dono = NULL;
+        if (ota_fila) {
+            pbuf_free(ota_fila);
+            ota_fila = NULL;
+        }
+        ota_a_confirmar = 0;
+    }
+    for (int i = 0; i < TELA_MAX_ASSINANTES; i++) {
+        if (tela_assinantes[i] == hs) {
+            tela_assinantes[i] = NULL;
+        }
+    }
+    if (hs->estado) {
+        hs->estado->refs--;
+    }
+    free(hs);
+}
+
+/**
+ * Enfileira o que couber da resposta (dados e depois corpo) no buffer de
+ * envio. Sem espaço ou sem segmentos (ERR_MEM) para e o restante segue no
+ * próximo ACK ou poll; outro erro é devolvido para a conexão ser abortada.
+ */
+static err_t http_escreve(struct http_state *hs, struct tcp_pcb *tpcb) {
+    size_t total = hs->dados_len + hs->corpo_len;
+    err_t err = ERR_OK;
+    while (hs->enfileirado < total) {
+        bool cabecalho = hs->enfileirado < hs->dados_len;
+        const char *origem = cabecalho ? hs->dados + hs->enfileirado
+                                       : hs->corpo + (hs->enfileirado - hs->dados_len);
+        size_t n = (cabecalho ? hs->dados_len : total) - hs->enfileirado;
+        if (n > tcp_sndbuf(tpcb)) {
+            n = tcp_sndbuf(tpcb);
+        }
+        if (n == 0) {
+            break;
+        }
+        // Só a resposta montada nesta requisição precisa ser copiada pelo lwIP
+        u8_t flags = cabecalho && hs->dados == hs->response ? TCP_WRITE_FLAG_COPY : 0;
+        if (hs->enfileirado + n < total) {
+            flags |= TCP_WRITE_FLAG_MORE;
+        }
+        err = tcp_write(tpcb, origem, (u16_t)n, flags);
+        if (err != ERR_OK) {
+            break;
+        }
+        hs->enfileirado += n;
+    }
+    tcp_output(tpcb);
+    return err == ERR_MEM ? ERR_OK : err;
+}
+
+// Libera o estado e aborta a conexão; o callback deve retornar ERR_ABRT
+static err_t http_aborta(struct http_state *hs, struct tcp_pcb *tpcb) {
+    tcp_arg(tpcb, NULL);
+    http_libera(hs);
+    tcp_abort(tpcb);
+    return ERR_ABRT;
+}
+
 // Callback chamado quando os dados são enviados com sucesso
 static err_t http_sent(void *arg, struct tcp_pcb *tpcb, u16_t len) {
     struct http_state *hs = (struct http_state *)arg;
+    if (!hs) {
+        return ERR_OK;
+    }
     hs->sent += len;
+    hs->tentativas = 0;
     if (hs->sent >= hs->len) {
+        tcp_arg(tpcb, NULL);
         tcp_close(tpcb);
-        free(hs);
+        http_libera(hs);
+        return ERR_OK;
+    }
+    if (http_escreve(hs, tpcb) != ERR_OK) {
+        return http_aborta(hs, tpcb);
+    }
+    if (hs->tela) {
+        tela_continua(hs, tpcb);
     }
     return ERR_OK;
 }
 
+/**
+ * Timer lento: retoma a resposta que não coube no envio quando não há ACK a
+ * caminho para fazê-lo; após HTTP_POLL_MAX tentativas sem progresso, desiste.
+ * No upload o progresso são bytes novos do cliente: com a fila vazia (janela
+ * aberta) e nada chegando, a sessão de OTA é descartada junto com a conexão
+ * para não ficar presa a um cliente parado.
+ */
+static err_t http_poll(void *arg, struct tcp_pcb *tpcb) {
+    struct http_state *hs = (struct http_state *)arg;
+    if (!hs) {
+        return ERR_OK;
+    }
+    if (hs->upload) {
+        if (ota_fila || ota_gravando || ota_chegados != ota_chegados_poll) {
+            ota_chegados_poll = ota_chegados;
+            hs->tentativas = 0;
+        } else if (++hs->tentativas >= HTTP_POLL_MAX) {
+            return http_aborta(hs, tpcb);
+        }
+        return ERR_OK;
+    }
+    if (hs->enfileirado >= hs->dados_len + hs->corpo_len) {
+        if (hs->tela) {
+            tela_continua(hs, tpcb);
+        }
+        return ERR_OK;
+    }
+    size_t antes = hs->enfileirado;
+    if (http_escreve(hs, tpcb) != ERR_OK) {
+        return http_aborta(hs, tpcb);
+    }
+    if (hs->enfileirado > antes) {
+        hs->tentativas = 0;
+    } else if (++hs->tentativas >= HTTP_POLL_MAX) {
+        return http_aborta(hs, tpcb);
+    }
+    if (hs->tela) {
+        tela_continua(hs, tpcb);
+    }
+    return ERR_OK;
+}
+
+// Conexão abortada pelo lwIP: o pcb já foi liberado, resta o estado
+static void http_err(void *arg, err_t err) {
+    if (arg) {
+        http_libera((struct http_state *)arg);
+    }
+}
+
+/**
+ * Serializa o estado atual em um buffer livre e o publica com nova versão,
+ * somente se o JSON mudou. Chamada pelo laço principal a cada amostra.
+ */
+void webserver_publica_estado(void) {
+    if (!servidor_ativo) {
+        return;
+    }
+    estado_buffer_t *atual = estado_atual;
+    estado_buffer_t *b = NULL;
+    for (int i = 0; i < ESTADO_NUM_BUFFERS; i++) {
+        if (&estado_buffers[i] != atual && estado_buffers[i].refs == 0) {
+            b = &estado_buffers[i];
+            break;
+        }
+    }
+    if (!b) {
+        return;  // Todos em uso: os clientes continuam com a versão anterior
+    }
+
+    // Nível em décimos, formatado sem ponto flutuante
+    int32_t decimos = (int32_t)(nivel_percentual * 10.0f + 0.5f);
+    alarme_classe_t alarme = alarme_classe_atual();
+    char json[160];
+    int json_len = snprintf(json, sizeof(json),
+                            "{\"nivel\":%ld.%ld,\"bomba\":%s,\"alarme\":\"%s\",\"silenciado\":%s}",
+                            (long)(decimos / 10), (long)(decimos % 10),
+                            bomba_ligada ? "true" : "false",
+                            alarme_nome(alarme),
+                            (alarme != ALARME_NENHUM && !alarme_soando()) ? "true" : "false");
+
+    if (atual && atual->len - atual->corpo == json_len &&
+        memcmp(atual->dados + atual->corpo, json, json_len) == 0) {
+        return;  // Nada mudou: mantém a versão (e o ETag) atual
+    }
+
+    uint32_t seq = estado_seq + 1;
+    int cab_len = snprintf(b->dados, sizeof(b->dados),
+                           "HTTP/1.1 200 OK\r\n"
+                           "Content-Type: application/json\r\n"
+                           "Content-Length: %d\r\n"
+                           "Cache-Control: no-cache\r\n"
+                           "ETag: \"%lu\"\r\n"
+                           "Connection: close\r\n\r\n",
+                           json_len, (unsigned long)seq);
+    memcpy(b->dados + cab_len, json, json_len);
+    b->corpo = cab_len;
+    b->len = cab_len + json_len;
+    b->seq = seq;
+
+    cyw43_arch_lwip_begin();
+    estado_seq = seq;
+    estado_atual = b;
+    estado_publicacoes++;
+    cyw43_arch_lwip_end();
+}
+
+// Uso dos pools do lwIP (atual, pico e falhas de alocação) em JSON
+static int formata_estatisticas_lwip(char *buf, size_t tamanho) {
+#if LWIP_STATS && MEM_STATS && MEMP_STATS
+    const struct stats_mem *seg = lwip_stats.memp[MEMP_TCP_SEG];
+    const struct stats_mem *pcb = lwip_stats.memp[MEMP_TCP_PCB];
+    const struct stats_mem *pool = lwip_stats.memp[MEMP_PBUF_POOL];
+    return snprintf(buf, tamanho,
+                    "{\"mem\":{\"tam\":%lu,\"usado\":%lu,\"max\":%lu,\"err\":%lu},"
+                    "\"tcp_seg\":{\"tam\":%lu,\"usado\":%lu,\"max\":%lu,\"err\":%lu},"
+                    "\"tcp_pcb\":{\"tam\":%lu,\"usado\":%lu,\"max\":%lu,\"err\":%lu},"
+                    "\"pbuf_pool\":{\"tam\":%lu,\"usado\":%lu,\"max\":%lu,\"err\":%lu}}",
+                    (unsigned long)lwip_stats.mem.avail, (unsigned long)lwip_stats.mem.used,
+                    (unsigned long)lwip_stats.mem.max, (unsigned long)lwip_stats.mem.err,
+                    (unsigned long)seg->avail, (unsigned long)seg->used, (unsigned long)seg->max, (unsigned long)seg->err,
+                    (unsigned long)pcb->avail, (unsigned long)pcb->used, (unsigned long)pcb->max, (unsigned long)pcb->err,
+                    (unsigned long)pool->avail, (unsigned long)pool->used, (unsigned long)pool->max, (unsigned long)pool->err);
+#else
+    return snprintf(buf, tamanho, "null");
+#endif
+}
+
+// ETag enviado pelo cliente em If-None-Match (0 se ausente)
+static uint32_t etag_cliente(const char *req) {
+    const char *h = strstr(req, "If-None-Match:");
+    if (!h) {
+        return 0;
+    }
+    h += strlen("If-None-Match:");
+    while (*h == ' ' || *h == '"' || *h == 'W' || *h == '/') {
+        h++;
+    }
+    return strtoul(h, NULL, 10);
+}
+
+// Valor de um cabeçalho da requisição (NULL se ausente)
+static const char *valor_cabecalho(const char *req, const char *nome) {
+    const char *h = strstr(req, nome);
+    if (!h) {
+        return NULL;
+    }
+    h += strlen(nome);
+    while (*h == ' ') {
+        h++;
+    }
+    return h;
+}
+
+#if OTA_HABILITADO
+// Compara o X-Token com o segredo sem encerrar na primeira diferença
+static bool token_valido(const char *valor) {
+    if (!valor) {
+        return false;
+    }
+    size_t n = strlen(OTA_TOKEN);
+    if (strcspn(valor, "\r\n") != n) {
+        return false;
+    }
+    uint8_t diferenca = 0;
+    for (size_t i = 0; i < n; i++) {
+        diferenca |= valor[i] ^ OTA_TOKEN[i];
+    }
+    return diferenca == 0;
+}
+#endif
+
+// Monta a resposta de texto simples para um status de erro
+static void resposta_texto(struct http_state *hs, const char *status, const char *texto) {
+    hs->dados_len = snprintf(hs->response, sizeof(hs->response),
+                             "HTTP/1.1 %s\r\n"
+                             "Content-Type: text/plain\r\n"
+                             "Content-Length: %d\r\n"
+                             "Connection: close\r\n\r\n%s",
+                             status, (int)strlen(texto), texto);
+}
+
+/**
+ * Envia a resposta montada em hs; a conexão fecha em http_sent. Retorna
+ * ERR_ABRT se o lwIP recusou a escrita com erro e a conexão foi abortada.
+ */
+static err_t http_envia(struct http_state *hs, struct tcp_pcb *tpcb) {
+    hs->len = hs->dados_len + hs->corpo_len;
+    hs->enfileirado = 0;
+    hs->tentativas = 0;
+
+    tcp_arg(tpcb, hs);
+    tcp_sent(tpcb, http_sent);
+    tcp_err(tpcb, http_err);
+    tcp_poll(tpcb, http_poll, HTTP_POLL_INTERVALO);
+    if (http_escreve(hs, tpcb) != ERR_OK) {
+        return http_aborta(hs, tpcb);
+    }
+    return ERR_OK;
+}
+
+#if OTA_HABILITADO
+// Chave HMAC das imagens, convertida de OTA_CHAVE na primeira sessão
+static uint8_t ota_chave[SHA256_TAM];
+static bool ota_chave_pronta = false;
+
+// Monta a resposta ao fim da sessão (sucesso ou erro) e a envia
+static void ota_responde(struct http_state *hs) {
+    ota_bytes = ota_upload.recebidos;
+    ota_duracao_ms = (time_us_32() - ota_t_inicio_us) / 1000;
+    hs->upload = false;
+    ota_dono = NULL;
+    trace(TRACE_OTA, ota_resultado, ota_bytes);
+    trace(TRACE_HTTP_FIM, TRACE_ROTA_OTA, ota_bytes);
+
+    if (ota_resultado != OTA_OK) {
+        resposta_texto(hs, "422 Unprocessable Entity", ota_status_str(ota_resultado));
+    } else {
+        ota_pronta = true;
+        ota_concluida_ms = to_ms_since_boot(get_absolute_time());
+        char json[128];
+        int json_len = snprintf(json, sizeof(json),
+                                "{\"bytes\":%lu,\"ms\":%lu,\"kbps\":%lu,\"resultado\":\"ok\"}",
+                                (unsigned long)ota_bytes, (unsigned long)ota_duracao_ms,
+                                (unsigned long)(ota_duracao_ms ? ota_bytes * 8 / ota_duracao_ms : 0));
+        hs->dados_len = snprintf(hs->response, sizeof(hs->response),
+                                 "HTTP/1.1 200 OK\r\n"
+                                 "Content-Type: application/json\r\n"
+                                 "Content-Length: %d\r\n"
+                                 "Connection: close\r\n\r\n%s",
+                                 json_len, json);
+    }
+    http_envia(hs, hs->pcb);
+}
+
+/**
+ * Põe p na fila da sessão (contexto do lwIP). Os primeiros `inicio` bytes são
+ * cabeçalho HTTP; `confirmar` é o que o tcp_recved ainda deve devolver à
+ * janela depois da gravação. Acorda o laço principal para gravar.
+ */
+static void ota_enfileira(struct pbuf *p, u16_t inicio, uint32_t confirmar) {
+    ota_chegados += p->tot_len - inicio;
+    ota_a_confirmar += confirmar;
+    if (ota_fila) {
+        pbuf_cat(ota_fila, p);
+    } else {
+        ota_fila = p;
+        ota_fila_inicio = inicio;
+    }
+    energia_acorda();
+}
+
+/**
+ * Inicia o upload de /update: exige X-Token, Content-Length e X-Assinatura
+ * (HMAC-SHA256 da imagem com a chave OTA_CHAVE, em hex). Retorna true se a
+ * sessão começou (p fica na fila); caso contrário hs recebe a resposta de erro
+ */
+static bool ota_inicia_upload(struct http_state *hs, struct tcp_pcb *tpcb, struct pbuf *p, const char *req) {
+    const char *fim_cabecalho = strstr(req, "\r\n\r\n");
+    const char *tamanho = valor_cabecalho(req, "Content-Length:");
+    const char *assinatura_hex = valor_cabecalho(req, "X-Assinatura:");
+    uint8_t assinatura[SHA256_TAM];
+    uint32_t base, capacidade;
+
+    if (!token_valido(valor_cabecalho(req, "X-Token:"))) {
+        resposta_texto(hs, "401 Unauthorized", "token invalido");
+        return false;
+    }
+    if (!fim_cabecalho || !tamanho || !assinatura_hex || !ota_hash_de_hex(assinatura_hex, assinatura)) {
+        resposta_texto(hs, "400 Bad Request", "use Content-Length e X-Assinatura (hex)");
+        return false;
+    }
+    if (ota_dono || ota_pronta || ota_gravando) {
+        resposta_texto(hs, "409 Conflict", "atualizacao em andamento");
+        return false;
+    }
+    if (!ota_chave_pronta) {
+        ota_chave_pronta = ota_hash_de_hex(OTA_CHAVE, ota_chave);
+    }
+    ota_regiao_staging(&base, &capacidade);
+    if (ota_inicia(&ota_upload, &ota_flash_pico, base, capacidade, strtoul(tamanho, NULL, 10),
+                   ota_chave, sizeof(ota_chave), assinatura) != OTA_OK) {
+        resposta_texto(hs, "413 Payload Too Large", ota_status_str(ota_upload.status));
+        return false;
+    }
+
+    hs->upload = true;
+    ota_dono = hs;
+    ota_t_inicio_us = time_us_32();
+    ota_chegados = 0;
+    ota_chegados_poll = 0;
+    ota_a_confirmar = 0;
+    tcp_arg(tpcb, hs);
+    tcp_err(tpcb, http_err);
+    tcp_poll(tpcb, http_poll, HTTP_POLL_INTERVALO);  // Cliente parado derruba a sessão
+    // O recv já devolveu p inteiro à janela: só o que chegar depois espera a gravação
+    ota_enfileira(p, (u16_t)(fim_cabecalho + 4 - req), 0);
+    return true;
+}
+
+bool webserver_ota_processa(void) {
+    cyw43_arch_lwip_begin();
+    struct pbuf *p = ota_fila;
+    u16_t inicio = ota_fila_inicio;
+    uint32_t confirmar = ota_a_confirmar;
+    struct http_state *hs = ota_dono;
+    ota_fila = NULL;
+    ota_fila_inicio = 0;
+    ota_a_confirmar = 0;
+    ota_gravando = p != NULL;
+    cyw43_arch_lwip_end();
+    if (!p) {
+        return hs != NULL;
+    }
+
+    // Apagamento e programação fora do contexto do lwIP; pbufs novos que
+    // chegarem enquanto isso vão para uma fila nova
+    for (struct pbuf *q = p; q && ota_upload.status == OTA_OK; q = q->next) {
+        if (inicio >= q->len) {
+            inicio -= q->len;
+            continue;
+        }
+        ota_escreve(&ota_upload, (const uint8_t *)q->payload + inicio, q->len - inicio);
+        inicio = 0;
+    }
+    bool fim = ota_upload.status != OTA_OK || ota_upload.recebidos >= ota_upload.tamanho;
+    if (fim) {
+        ota_resultado = ota_finaliza(&ota_upload);
+    }
+
+    cyw43_arch_lwip_begin();
+    pbuf_free(p);
+    ota_gravando = false;
+    // A conexão pode ter caído durante a gravação: sessão já descartada
+    if (hs && ota_dono == hs) {
+        tcp_recved(hs->pcb, (u16_t)confirmar);  // No máximo TCP_WND
+        if (fim) {
+            ota_responde(hs);
+        }
+    }
+    bool ativa = ota_dono != NULL;
+    cyw43_arch_lwip_end();
+    return ativa;
+}
+#else
+bool webserver_ota_processa(void) {
+    return false;
+}
+#endif
+
+// Imagem recebida e verificada há tempo suficiente para a resposta ter saído
+bool webserver_ota_pronta(uint32_t agora_ms, uint32_t *tamanho) {
+    if (!ota_pronta || agora_ms - ota_concluida_ms < OTA_ATRASO_TROCA_MS) {
+        return false;
+    }
+    *tamanho = ota_bytes;
+    return true;
+}
+
 // Função principal que processa as requisições HTTP
 static err_t http_recv(void *arg, struct tcp_pcb *tpcb, struct pbuf *p, err_t err) {
     if (!p) {
+        struct http_state *hs = (struct http_state *)arg;
+        if (hs && !hs->upload && hs->tela != TELA_DELTA && hs->sent < hs->len) {
+            // Cliente fechou só a escrita: a resposta ainda aponta para o
+            // buffer de /estado (ou para o corpo) sem cópia, então hs e a
+            // referência ficam até http_sent ver tudo confirmado ou http_err
+            return ERR_OK;
+        }
+#if OTA_HABILITADO
+        if (hs && hs->upload && ota_chegados >= ota_upload.tamanho) {
+            return ERR_OK;  // Imagem inteira na fila: a resposta sai após a gravação
+        }
+#endif
+        if (hs) {
+            tcp_arg(tpcb, NULL);
+            http_libera(hs);
+        }
         tcp_close(tpcb);
         return ERR_OK;
     }
 
-    char *req = (char *)p->payload;
+    // Segmentos seguintes de uma conexão já atendida: só o upload os consome
+    if (arg) {
+        struct http_state *atual = (struct http_state *)arg;
+#if OTA_HABILITADO
+        if (atual->upload) {
+            ota_enfileira(p, 0, p->tot_len);  // Janela devolvida após a gravação
+            return ERR_OK;
+        }
+#endif
+        (void)atual;
+        tcp_recved(tpcb, p->tot_len);
+        pbuf_free(p);
+        return ERR_OK;
+    }
+
+    // Sem memória o segmento é recusado intacto: com ERR_MEM o lwIP guarda p
+    // (refused_data) e o entrega de novo, então nem p nem a janela são tocados
     struct http_state *hs = malloc(sizeof(struct http_state));
+    if (!hs) {
+        return ERR_MEM;
+    }
+
+    uint32_t t_inicio = time_us_32();
+    http_requisicoes++;
+    uint16_t rota = TRACE_ROTA_PAGINA;
+
+    // Cópia terminada em zero do início da requisição (linha e cabeçalhos)
+    char req[512];
+    u16_t req_len = pbuf_copy_partial(p, req, sizeof(req) - 1, 0);
+    req[req_len] = '\0';
+    tcp_recved(tpcb, p->tot_len);
     hs->sent = 0;
+    hs->enfileirado = 0;
+    hs->tentativas = 0;
+    hs->dados = hs->response;
+    hs->corpo = NULL;
+    hs->corpo_len = 0;
+    hs->estado = NULL;
+    hs->upload = false;
+    hs->pcb = tpcb;
+    hs->tela = TELA_NENHUM;
+    hs->tela_pendente = false;
 
-    if (strstr(req, "GET /limites")) {
+    if (strstr(req, "POST /update")) {
+        rota = TRACE_ROTA_OTA;
+        trace(TRACE_HTTP_INICIO, rota, 0);
+#if OTA_HABILITADO
+        if (ota_inicia_upload(hs, tpcb, p, req)) {
+            return ERR_OK;  // p fica na fila da sessão
+        }
+#else
+        resposta_texto(hs, "404 Not Found", "atualizacao desabilitada nesta compilacao");
+#endif
+    } else if (strstr(req, "GET /limites")) {
+        rota = TRACE_ROTA_LIMITES;
+        trace(TRACE_HTTP_INICIO, rota, 0);
         char *min_str = strstr(req, "min=");
         char *max_str = strstr(req, "max=");
-        if (min_str && max_str) {
-            sscanf(min_str, "min=%f", &lim_min);
-            sscanf(max_str, "max=%f", &lim_max);
+        float min, max;
+        if (min_str && max_str &&
+            sscanf(min_str, "min=%f", &min) == 1 && sscanf(max_str, "max=%f", &max) == 1 &&
+            atualiza_limites(min, max)) {
+            const char *redir_hdr = "HTTP/1.1 302 Found\r\nLocation: /\r\nContent-Length: 0\r\nConnection: close\r\n\r\n";
+            hs->dados_len = snprintf(hs->response, sizeof(hs->response), redir_hdr);
+        } else {
+            const char *erro = "Limites invalidos: use 0 <= min < max <= 100";
+            hs->dados_len = snprintf(hs->response, sizeof(hs->response),
+                                     "HTTP/1.1 400 Bad Request\r\n"
+                                     "Content-Type: text/plain\r\n"
+                                     "Content-Length: %d\r\n"
+                                     "Connection: close\r\n\r\n%s",
+                                     (int)strlen(erro), erro);
         }
-        const char *redir_hdr = "HTTP/1.1 302 Found\r\nLocation: /\r\n\r\n";
-        hs->len = snprintf(hs->response, sizeof(hs->response), redir_hdr);
+
+    } else if (strstr(req, "GET /alarme/silenciar")) {
+        rota = TRACE_ROTA_ALARME;
+        trace(TRACE_HTTP_INICIO, rota, 0);
+        silenciar_alarme = true;
+        const char *redir_hdr = "HTTP/1.1 302 Found\r\nLocation: /\r\nContent-Length: 0\r\nConnection: close\r\n\r\n";
+        hs->dados_len = snprintf(hs->response, sizeof(hs->response), redir_hdr);
 
     } else if (strstr(req, "GET /estado")) {
-        char json_payload[128];
-        int json_len = snprintf(json_payload, sizeof(json_payload),
-                                  "{\"nivel\":%.1f,\"bomba\":%s}",
-                                  nivel_percentual, bomba_ligada ? "true" : "false");
+        rota = TRACE_ROTA_ESTADO;
+        trace(TRACE_HTTP_INICIO, rota, 0);
+        estado_buffer_t *b = estado_atual;
+        estado_requisicoes++;
+        if (!b) {
+            hs->dados_len = snprintf(hs->response, sizeof(hs->response),
+                                     "HTTP/1.1 503 Service Unavailable\r\n"
+                                     "Content-Length: 0\r\n"
+                                     "Connection: close\r\n\r\n");
+        } else if (etag_cliente(req) == b->seq) {
+            estado_nao_modificado++;
+            hs->dados_len = snprintf(hs->response, sizeof(hs->response),
+                                     "HTTP/1.1 304 Not Modified\r\n"
+                                     "ETag: \"%lu\"\r\n"
+                                     "Connection: close\r\n\r\n",
+                                     (unsigned long)b->seq);
+        } else {
+            // Envia o buffer compartilhado sem copiar; liberado ao fim do envio
+            b->refs++;
+            hs->estado = b;
+            hs->dados = b->dados;
+            hs->dados_len = b->len;
+        }
+        estado_us_total += time_us_32() - t_inicio;
+    } else if (strstr(req, "GET /metricas")) {
+        rota = TRACE_ROTA_METRICAS;
+        trace(TRACE_HTTP_INICIO, rota, 0);
+        const wifi_metricas_t *wm = wifi_metricas();
+        const diagnostico_metricas_t *dm = diagnostico_metricas();
+        char lwip_json[384];
+        formata_estatisticas_lwip(lwip_json, sizeof(lwip_json));
+        const energia_metricas_t *em = energia_metricas();
+        // JSON gerado direto em hs->response, após espaço para o cabeçalho,
+        // para não ocupar a pilha do contexto do lwIP
+        char *json_payload = hs->response + METRICAS_CABECALHO_MAX;
+        int json_len = snprintf(json_payload, sizeof(hs->response) - METRICAS_CABECALHO_MAX,
+                                  "{\"t_primeira_decisao_ms\":%lu,\"lwip\":%s,"
+                                  "\"http\":{\"requisicoes\":%lu,\"estado_requisicoes\":%lu,"
+                                  "\"estado_304\":%lu,\"estado_us_medio\":%lu,\"estado_publicacoes\":%lu},"
+                                  "\"alarmes\":{\"atual\":\"%s\",\"disparos_nivel_baixo\":%lu,"
+                                  "\"disparos_nivel_alto\":%lu,\"disparos_falha_sensor\":%lu,"
+                                  "\"disparos_bomba_seco\":%lu},"
+                                  "\"diagnostico\":{\"falhas\":%lu,\"deteccoes\":%lu,"
+                                  "\"t_fora_faixa_ms\":%lu,\"t_estagnado_ms\":%lu,"
+                                  "\"t_taxa_ms\":%lu,\"t_bomba_seco_ms\":%lu},"
+                                  "\"wifi\":{\"estado\":\"%s\",\"tentativas\":%lu,"
+                                  "\"t_primeira_conexao_ms\":%lu,\"reconexoes\":%lu,"
+                                  "\"latencia_reconexao_ms\":%lu,\"latencia_reconexao_max_ms\":%lu},"
+                                  "\"energia\":{\"ciclo_trabalho_pm\":%lu,\"ciclos\":%lu,\"despertares\":%lu,"
+                                  "\"apagamentos\":%lu,\"trocas_clock\":%lu,\"clk_sys_mhz\":%lu},"
+                                  "\"ota\":{\"boot\":\"%s\",\"resultado\":\"%s\",\"bytes\":%lu,"
+                                  "\"ms\":%lu,\"kbps\":%lu},"
+                                  "\"tela\":{\"assinantes\":%d,\"quadros\":%lu,\"registros\":%lu,"
+                                  "\"coalescidos\":%lu},"
+                                  "\"agenda\":{\"hora_semana\":%d,\"barata\":%s,\"reserva\":%.1f,"
+                                  "\"lim_min_efetivo\":%.1f,\"horas_aprendidas\":%u}}",
+                                  (unsigned long)t_primeira_decisao_ms, lwip_json,
+                                  (unsigned long)http_requisicoes, (unsigned long)estado_requisicoes,
+                                  (unsigned long)estado_nao_modificado,
+                                  (unsigned long)(estado_requisicoes ? estado_us_total / estado_requisicoes : 0),
+                                  (unsigned long)estado_publicacoes,
+                                  alarme_nome(alarme_classe_atual()),
+                                  (unsigned long)alarme_disparos(ALARME_NIVEL_BAIXO),
+                                  (unsigned long)alarme_disparos(ALARME_NIVEL_ALTO),
+                                  (unsigned long)alarme_disparos(ALARME_FALHA_SENSOR),
+                                  (unsigned long)alarme_disparos(ALARME_BOMBA_SECO),
+                                  (unsigned long)diagnostico_falhas(), (unsigned long)dm->deteccoes,
+                                  (unsigned long)dm->t_fora_faixa_ms, (unsigned long)dm->t_estagnado_ms,
+                                  (unsigned long)dm->t_taxa_ms, (unsigned long)dm->t_bomba_seco_ms,
+                                  wifi_estado_str(),
+                                  (unsigned long)wm->tentativas, (unsigned long)wm->t_primeira_conexao_ms,
+                                  (unsigned long)wm->reconexoes, (unsigned long)wm->latencia_reconexao_ms,
+                                  (unsigned long)wm->latencia_reconexao_max_ms,
+                                  (unsigned long)energia_ciclo_trabalho_pm(), (unsigned long)em->ciclos,
+                                  (unsigned long)em->despertares, (unsigned long)em->apagamentos,
+                                  (unsigned long)em->trocas_clock,
+                                  (unsigned long)(clock_get_hz(clk_sys) / 1000000),
+                                  ota_estado_boot_str(), ota_status_str(ota_resultado),
+                                  (unsigned long)ota_bytes, (unsigned long)ota_duracao_ms,
+                                  (unsigned long)(ota_duracao_ms ? ota_bytes * 8 / ota_duracao_ms : 0),
+                                  tela_num_assinantes(), (unsigned long)tela_seq,
+                                  (unsigned long)tela_registros, (unsigned long)tela_coalescidos,
+                                  agenda.hora,
+                                  agenda.hora >= 0 && agenda_hora_barata(&agenda, (uint8_t)agenda.hora) ? "true" : "false",
+                                  agenda_reserva(&agenda), lim_min_efetivo,
+                                  agenda_horas_aprendidas(&agenda));
 
-        hs->len = snprintf(hs->response, sizeof(hs->response),
+        if (json_len >= (int)sizeof(hs->response) - METRICAS_CABECALHO_MAX) {
+            json_len = sizeof(hs->response) - METRICAS_CABECALHO_MAX - 1;
+        }
+        int cab_len = snprintf(hs->response, METRICAS_CABECALHO_MAX,
                           "HTTP/1.1 200 OK\r\n"
                           "Content-Type: application/json\r\n"
                           "Content-Length: %d\r\n"
-                          "Connection: close\r\n\r\n%s",
-                          json_len, json_payload);
+                          "Connection: close\r\n\r\n",
+                          json_len);
+        memmove(hs->response + cab_len, json_payload, json_len);
+        hs->dados_len = cab_len + json_len;
+    } else if (strstr(req, "GET /trace")) {
+        // Cabeçalho com o instante da captura; os anéis vão sem cópia direto
+        // da RAM, e o decodificador descarta o que for posterior à captura
+        rota = TRACE_ROTA_TRACE;
+        trace(TRACE_HTTP_INICIO, rota, 0);
+        hs->corpo = (const char *)trace_aneis;
+        hs->corpo_len = sizeof(trace_aneis);
+        hs->dados_len = snprintf(hs->response, sizeof(hs->response),
+                        "HTTP/1.1 200 OK\r\n"
+                        "Content-Type: application/octet-stream\r\n"
+                        "Content-Length: %d\r\n"
+                        "Cache-Control: no-store\r\n"
+                        "Connection: close\r\n\r\n",
+                        (int)(TRACE_CABECALHO_TAM + hs->corpo_len));
+        hs->dados_len += trace_cabecalho((uint8_t *)hs->response + hs->dados_len);
+    } else if (strstr(req, "GET /tela")) {
+        rota = TRACE_ROTA_TELA;
+        trace(TRACE_HTTP_INICIO, rota, 0);
+        int livre = -1;
+        for (int i = 0; i < TELA_MAX_ASSINANTES && livre < 0; i++) {
+            if (!tela_assinantes[i]) {
+                livre = i;
+            }
+        }
+        if (!tela) {
+            resposta_texto(hs, "503 Service Unavailable", "Display indisponivel");
+        } else if (strstr(req, "GET /tela/delta")) {
+            if (livre < 0) {
+                resposta_texto(hs, "503 Service Unavailable", "Limite de assinantes atingido");
+            } else {
+                // Fluxo sem fim: o primeiro registro é o quadro inteiro
+                tela_assinantes[livre] = hs;
+                hs->tela = TELA_DELTA;
+                hs->tela_x0 = 0;
+                hs->tela_x1 = tela->width - 1;
+                hs->tela_p0 = 0;
+                hs->tela_p1 = tela->pages - 1;
+                hs->tela_pendente = true;
+                hs->dados_len = snprintf(hs->response, sizeof(hs->response),
+                                "HTTP/1.1 200 OK\r\n"
+                                "Content-Type: application/octet-stream\r\n"
+                                "X-Largura: %d\r\n"
+                                "X-Altura: %d\r\n"
+                                "Cache-Control: no-store\r\n"
+                                "Connection: close\r\n\r\n",
+                                tela->width, tela->height);
+            }
+        } else if (strstr(req, "GET /tela.pbm")) {
+            // Codificada em trechos a partir de http_sent, sem cópia do quadro
+            hs->tela = TELA_PBM;
+            hs->tela_pagina = 0;
+            char pbm_cab[16];
+            int pbm_len = tela_cabecalho_pbm(tela, pbm_cab, sizeof(pbm_cab));
+            hs->dados_len = snprintf(hs->response, sizeof(hs->response),
+                            "HTTP/1.1 200 OK\r\n"
+                            "Content-Type: image/x-portable-bitmap\r\n"
+                            "Content-Length: %d\r\n"
+                            "Cache-Control: no-store\r\n"
+                            "Connection: close\r\n\r\n%s",
+                            pbm_len + (int)tela_tam_pbm(tela), pbm_cab);
+        } else {
+            // Framebuffer bruto sem cópia: colunas de 8 pixels, página a página;
+            // um desenho durante o envio pode aparecer pela metade
+            hs->corpo = (const char *)tela->ram_buffer + 1;
+            hs->corpo_len = tela->bufsize - 1;
+            hs->dados_len = snprintf(hs->response, sizeof(hs->response),
+                            "HTTP/1.1 200 OK\r\n"
+                            "Content-Type: application/octet-stream\r\n"
+                            "Content-Length: %d\r\n"
+                            "X-Largura: %d\r\n"
+                            "X-Altura: %d\r\n"
+                            "Cache-Control: no-store\r\n"
+                            "Connection: close\r\n\r\n",
+                            (int)hs->corpo_len, tela->width, tela->height);
+        }
     } else {
-        hs->len = snprintf(hs->response, sizeof(hs->response),
+        trace(TRACE_HTTP_INICIO, rota, 0);
+        // Página constante em flash: só o cabeçalho é montado, o corpo vai sem cópia
+        hs->corpo = HTML_BODY;
+        hs->corpo_len = sizeof(HTML_BODY) - 1;
+        hs->dados_len = snprintf(hs->response, sizeof(hs->response),
                         "HTTP/1.1 200 OK\r\n"
                         "Content-Type: text/html\r\n"
                         "Content-Length: %d\r\n"
-                        "Connection: close\r\n\r\n%s",
-                        (int)strlen(HTML_BODY), HTML_BODY);
+                        "Connection: close\r\n\r\n",
+                        (int)hs->corpo_len);
+    }
+    if (http_envia(hs, tpcb) != ERR_OK) {
+        pbuf_free(p);
+        return ERR_ABRT;
     }
 
-    tcp_arg(tpcb, hs);
-    tcp_sent(tpcb, http_sent);
-    tcp_write(tpcb, hs->response, hs->len, TCP_WRITE_FLAG_COPY);
-    tcp_output(tpcb);
+    // /tela.pbm e /tela/delta seguem em http_sent a cada ACK; o fim registra
+    // o tamanho total (no fluxo de /tela/delta, só o cabeçalho)
+    if (hs->tela == TELA_PBM) {
+        hs->len += tela_tam_pbm(tela);
+    } else if (hs->tela == TELA_DELTA) {
+        hs->len = SIZE_MAX;  // Só termina quando o cliente fecha
+    }
+    trace(TRACE_HTTP_FIM, rota, hs->tela == TELA_DELTA ? hs->dados_len : hs->len);
+    if (hs->tela) {
+        tela_continua(hs, tpcb);
+    }
 
     pbuf_free(p);
     return ERR_OK;
@@ -146,23 +1040,11 @@ static void start_http_server(void) {
 }
 
 
-// Função de inicialização principal do webserver
+// Inicia o listener HTTP; a conexão Wi-Fi é gerenciada em segundo plano por wifi.c
 bool webserver_init(void) {
-    if (cyw43_arch_init()) {
-        printf("Falha para iniciar o cyw43\n");
-        return false;
-    }
-
-    cyw43_arch_enable_sta_mode();
-
-    printf("Conectando ao Wi-Fi: %s\n", WIFI_SSID);
-    if (cyw43_arch_wifi_connect_timeout_ms(WIFI_SSID, WIFI_PASS, CYW43_AUTH_WPA2_AES_PSK, 15000)) {
-        printf("Falha para conectar ao Wi-Fi\n");
-        cyw43_arch_deinit();
-        return false;
-    }
-    
-    printf("Conectado com sucesso!\n");
+    cyw43_arch_lwip_begin();
     start_http_server();
+    cyw43_arch_lwip_end();
+    servidor_ativo = true;
     return true;
-}
\ No newline at end of file
+}
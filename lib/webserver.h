@@ -2,7 +2,17 @@
 #define WEBSERVER_H
 
 #include <stdbool.h> 
+#include <stdint.h>
+
+#include "ssd1306.h"
 
 bool webserver_init(void);
+void webserver_publica_estado(void);
+// Grava na flash o que chegou de /update (laço principal, fora do lwIP);
+// true enquanto houver uma sessão de upload aberta
+bool webserver_ota_processa(void);
+bool webserver_ota_pronta(uint32_t agora_ms, uint32_t *tamanho);
+// Serve o framebuffer do display em /tela e as mudanças em /tela/delta
+void webserver_espelha_tela(ssd1306_t *ssd);
 
 #endif // WEBSERVER_H
\ No newline at end of file
@@ -0,0 +1,225 @@
+#include <stdio.h>
+
+#include "pico/cyw43_arch.h"
+#include "lwip/netif.h"
+#include "lwip/apps/sntp.h"
+#include "hardware/sync.h"
+
+#include "wifi.h"
+#include "trace.h"
+
+#define WIFI_SSID "Sua Rede"
+#define WIFI_PASS "Sua senha"
+
+#define WIFI_TIMEOUT_MS     15000   // Tempo máximo de uma tentativa de conexão
+#define WIFI_BACKOFF_MIN_MS 1000    // Primeiro intervalo entre tentativas
+#define WIFI_BACKOFF_MAX_MS 60000   // Teto do backoff exponencial
+#define WIFI_SERVIDOR_NTP   "pool.ntp.org"
+
+static wifi_estado_t estado = WIFI_DESLIGADO;
+static wifi_metricas_t metricas;
+static uint32_t inicio_tentativa_ms = 0;
+static uint32_t proxima_tentativa_ms = 0;
+static uint32_t backoff_ms = WIFI_BACKOFF_MIN_MS;
+static uint32_t t_queda_ms = 0;        // Momento da perda do enlace (0 = sem queda pendente)
+static volatile bool enlace_mudou = false;
+static bool economia = false;          // Modo de economia de energia do rádio desejado
+static bool sntp_iniciado = false;
+// Última resposta do SNTP: segundos UTC e o instante local em que chegou
+static volatile uint32_t hora_epoca_s = 0;
+static volatile uint32_t hora_ref_ms = 0;
+
+// Callbacks do lwIP: apenas sinalizam, o tratamento ocorre em wifi_poll
+static void netif_link_callback(struct netif *netif) {
+    enlace_mudou = true;
+}
+
+static void netif_status_callback(struct netif *netif) {
+    enlace_mudou = true;
+}
+
+// Agenda nova tentativa dobrando o intervalo até o teto
+static void agenda_nova_tentativa(uint32_t agora_ms) {
+    cyw43_wifi_leave(&cyw43_state, CYW43_ITF_STA);
+    proxima_tentativa_ms = agora_ms + backoff_ms;
+    backoff_ms = backoff_ms * 2 > WIFI_BACKOFF_MAX_MS ? WIFI_BACKOFF_MAX_MS : backoff_ms * 2;
+    estado = WIFI_AGUARDANDO;
+    trace(TRACE_WIFI, estado, metricas.tentativas);
+}
+
+// Dispara uma tentativa de associação sem bloquear; uma recusa imediata
+// conta como tentativa falha e também dobra o backoff
+static void inicia_tentativa(uint32_t agora_ms) {
+    metricas.tentativas++;
+    inicio_tentativa_ms = agora_ms;
+    if (cyw43_arch_wifi_connect_async(WIFI_SSID, WIFI_PASS, CYW43_AUTH_WPA2_AES_PSK)) {
+        agenda_nova_tentativa(agora_ms);
+        return;
+    }
+    estado = WIFI_CONECTANDO;
+    trace(TRACE_WIFI, estado, metricas.tentativas);
+}
+
+// Aplica o modo de economia do cyw43; só tem efeito com o enlace ativo
+static void aplica_economia(void) {
+    cyw43_arch_lwip_begin();
+    cyw43_wifi_pm(&cyw43_state, economia ? CYW43_AGGRESSIVE_PM : CYW43_DEFAULT_PM);
+    cyw43_arch_lwip_end();
+}
+
+// Hora de parede por SNTP; o lwIP mantém a consulta periódica entre quedas
+static void inicia_sntp(void) {
+    if (sntp_iniciado) {
+        return;
+    }
+    cyw43_arch_lwip_begin();
+    sntp_setoperatingmode(SNTP_OPMODE_POLL);
+    sntp_setservername(0, WIFI_SERVIDOR_NTP);
+    sntp_init();
+    cyw43_arch_lwip_end();
+    sntp_iniciado = true;
+}
+
+static void conexao_estabelecida(uint32_t agora_ms) {
+    estado = WIFI_CONECTADO;
+    aplica_economia();
+    inicia_sntp();
+    enlace_mudou = false;
+    backoff_ms = WIFI_BACKOFF_MIN_MS;
+    metricas.t_ultima_conexao_ms = agora_ms;
+    if (metricas.t_primeira_conexao_ms == 0) {
+        metricas.t_primeira_conexao_ms = agora_ms;
+    }
+    if (t_queda_ms) {
+        metricas.reconexoes++;
+        metricas.latencia_reconexao_ms = agora_ms - t_queda_ms;
+        if (metricas.latencia_reconexao_ms > metricas.latencia_reconexao_max_ms) {
+            metricas.latencia_reconexao_max_ms = metricas.latencia_reconexao_ms;
+        }
+        t_queda_ms = 0;
+    }
+    trace(TRACE_WIFI, estado, metricas.tentativas);
+}
+
+// Inicializa o chip e dispara a primeira tentativa; não espera a associação
+bool wifi_init(void) {
+    if (cyw43_arch_init()) {
+        printf("Falha para iniciar o cyw43\n");
+        return false;
+    }
+
+    cyw43_arch_enable_sta_mode();
+
+    cyw43_arch_lwip_begin();
+    netif_set_link_callback(&cyw43_state.netif[CYW43_ITF_STA], netif_link_callback);
+    netif_set_status_callback(&cyw43_state.netif[CYW43_ITF_STA], netif_status_callback);
+    cyw43_arch_lwip_end();
+
+    inicia_tentativa(to_ms_since_boot(get_absolute_time()));
+    return true;
+}
+
+// Avança a máquina de estados; deve ser chamada a cada iteração do laço principal
+void wifi_poll(uint32_t agora_ms) {
+    if (estado == WIFI_DESLIGADO) {
+        return;
+    }
+
+    int status;
+    switch (estado) {
+        case WIFI_CONECTANDO:
+            status = cyw43_tcpip_link_status(&cyw43_state, CYW43_ITF_STA);
+            if (status == CYW43_LINK_UP) {
+                conexao_estabelecida(agora_ms);
+            } else if (status < 0 || agora_ms - inicio_tentativa_ms > WIFI_TIMEOUT_MS) {
+                agenda_nova_tentativa(agora_ms);
+            }
+            break;
+
+        case WIFI_CONECTADO:
+            // Conectado, só consulta o driver quando o lwIP sinalizar mudança no enlace
+            if (!enlace_mudou) {
+                break;
+            }
+            enlace_mudou = false;
+            status = cyw43_tcpip_link_status(&cyw43_state, CYW43_ITF_STA);
+            if (status != CYW43_LINK_UP) {
+                t_queda_ms = agora_ms;
+                inicia_tentativa(agora_ms);
+            }
+            break;
+
+        case WIFI_AGUARDANDO:
+            if ((int32_t)(agora_ms - proxima_tentativa_ms) >= 0) {
+                inicia_tentativa(agora_ms);
+            }
+            break;
+
+        default:
+            break;
+    }
+}
+
+wifi_estado_t wifi_estado(void) {
+    return estado;
+}
+
+const char *wifi_estado_str(void) {
+    switch (estado) {
+        case WIFI_CONECTANDO: return "conectando";
+        case WIFI_CONECTADO:  return "conectado";
+        case WIFI_AGUARDANDO: return "aguardando";
+        default:              return "desligado";
+    }
+}
+
+const wifi_metricas_t *wifi_metricas(void) {
+    return &metricas;
+}
+
+// Formata o IP atual da interface STA
+void wifi_ip_str(char *buf, int tamanho) {
+    uint8_t *ip = (uint8_t *)&(cyw43_state.netif[CYW43_ITF_STA].ip_addr.addr);
+    snprintf(buf, tamanho, "%d.%d.%d.%d", ip[0], ip[1], ip[2], ip[3]);
+}
+
+// Próximo instante em que wifi_poll tem algo a fazer (tentativa agendada);
+// nos demais estados basta a cadência normal do laço
+uint32_t wifi_proximo_prazo(uint32_t agora_ms, uint32_t padrao_ms) {
+    if (estado == WIFI_AGUARDANDO && (int32_t)(proxima_tentativa_ms - (agora_ms + padrao_ms)) < 0) {
+        return proxima_tentativa_ms;
+    }
+    return agora_ms + padrao_ms;
+}
+
+// Economia agressiva do rádio (mais latência, menos corrente) ou o padrão do driver
+void wifi_economia(bool ativa) {
+    if (ativa == economia) {
+        return;
+    }
+    economia = ativa;
+    if (estado == WIFI_CONECTADO) {
+        aplica_economia();
+    }
+}
+
+// Chamada pelo lwIP (SNTP_SET_SYSTEM_TIME em lwipopts.h) a cada resposta
+void wifi_hora_sntp(uint32_t segundos) {
+    uint32_t estado_irq = save_and_disable_interrupts();
+    hora_epoca_s = segundos;
+    hora_ref_ms = to_ms_since_boot(get_absolute_time());
+    restore_interrupts(estado_irq);
+}
+
+// Segundos UTC em agora_ms, extrapolados da última sincronização
+bool wifi_hora(uint32_t agora_ms, uint32_t *epoca_s) {
+    uint32_t estado_irq = save_and_disable_interrupts();
+    uint32_t epoca = hora_epoca_s;
+    uint32_t ref = hora_ref_ms;
+    restore_interrupts(estado_irq);
+    if (epoca == 0) {
+        return false;
+    }
+    *epoca_s = epoca + (agora_ms - ref) / 1000;
+    return true;
+}
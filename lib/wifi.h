@@ -0,0 +1,36 @@
+#ifndef WIFI_H
+#define WIFI_H
+
+#include <stdbool.h>
+#include <stdint.h>
+
+// Estados da máquina de conexão Wi-Fi
+typedef enum {
+    WIFI_DESLIGADO,    // Chip cyw43 não inicializado
+    WIFI_CONECTANDO,   // Associação e DHCP em andamento
+    WIFI_CONECTADO,    // Enlace ativo com IP atribuído
+    WIFI_AGUARDANDO    // Aguardando o backoff para nova tentativa
+} wifi_estado_t;
+
+// Métricas de conexão (tempos em ms desde o boot)
+typedef struct {
+    uint32_t tentativas;
+    uint32_t reconexoes;
+    uint32_t t_primeira_conexao_ms;
+    uint32_t t_ultima_conexao_ms;
+    uint32_t latencia_reconexao_ms;
+    uint32_t latencia_reconexao_max_ms;
+} wifi_metricas_t;
+
+bool wifi_init(void);
+void wifi_poll(uint32_t agora_ms);
+wifi_estado_t wifi_estado(void);
+const char *wifi_estado_str(void);
+const wifi_metricas_t *wifi_metricas(void);
+void wifi_ip_str(char *buf, int tamanho);
+uint32_t wifi_proximo_prazo(uint32_t agora_ms, uint32_t padrao_ms);
+void wifi_economia(bool ativa);
+void wifi_hora_sntp(uint32_t segundos);
+bool wifi_hora(uint32_t agora_ms, uint32_t *epoca_s);
+
+#endif // WIFI_H
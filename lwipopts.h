@@ -35,10 +35,22 @@
 #define LWIP_NETIF_LINK_CALLBACK    1
 #define LWIP_NETIF_HOSTNAME         1
 #define LWIP_NETCONN                0
-#define MEM_STATS                   0
 #define SYS_STATS                   0
-#define MEMP_STATS                  0
 #define LINK_STATS                  0
+
+// Estatísticas de memória (pico de uso dos pools), expostas em /metricas
+// para dimensionar MEM_SIZE e MEMP_NUM_* com tools/carga_http.py
+#ifndef WEB_ESTATISTICAS_LWIP
+#define WEB_ESTATISTICAS_LWIP       1
+#endif
+#if WEB_ESTATISTICAS_LWIP
+#define LWIP_STATS                  1
+#define MEM_STATS                   1
+#define MEMP_STATS                  1
+#else
+#define MEM_STATS                   0
+#define MEMP_STATS                  0
+#endif
 // #define ETH_PAD_SIZE                2
 #define LWIP_CHKSUM_ALGORITHM       3
 #define LWIP_DHCP                   1
@@ -48,12 +60,20 @@
 #define LWIP_DNS                    1
 #define LWIP_TCP_KEEPALIVE          1
 #define LWIP_NETIF_TX_SINGLE_PBUF   1
+
+// Hora de parede por SNTP (lib/wifi.c), usada pela agenda de tarifas
+#define SNTP_SERVER_DNS             1
+#define SNTP_STARTUP_DELAY          0
+#define SNTP_SET_SYSTEM_TIME(seg)   wifi_hora_sntp(seg)
+#define MEMP_NUM_SYS_TIMEOUT        (LWIP_NUM_SYS_TIMEOUT_INTERNAL + 1)
+// Protótipo ao lado da macro, como nos pico-examples: o sntp.c só inclui o lwipopts.h
+#include <stdint.h>
+void wifi_hora_sntp(uint32_t segundos);
 #define DHCP_DOES_ARP_CHECK         0
 #define LWIP_DHCP_DOES_ACD_CHECK    0
 
 #ifndef NDEBUG
 #define LWIP_DEBUG                  1
-#define LWIP_STATS                  1
 #define LWIP_STATS_DISPLAY          1
 #endif
 
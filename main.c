@@ -10,10 +10,23 @@
 #include "hardware/pwm.h"
 #include "hardware/pio.h"
 #include "hardware/clocks.h"
+#include "hardware/watchdog.h"
+#include "hardware/sync.h"
 #include "lib/ssd1306.h"
 #include "lib/font.h"
 #include "ws2812.pio.h"
 #include "lib/webserver.h" 
+#include "lib/wifi.h"
+#include "lib/alarme.h"
+#include "lib/diagnostico.h"
+#include "lib/ui.h"
+#include "lib/fonte_digitos.h"
+#include "lib/modbus.h"
+#include "lib/trace.h"
+#include "lib/controle.h"
+#include "lib/energia.h"
+#include "lib/ota.h"
+#include "lib/agenda.h"
 
 // ===== DEFINIÇÕES DE HARDWARE =====
 #define I2C_PORT i2c1
@@ -36,27 +49,130 @@
 #define VOLUME_MIN 1.5f
 #define LEITURA_ADC_MIN 2680f
 #define LEITURA_ADC_MAX 2040f
+#define TEMPO_TELA_MS 5000       // Tempo de cada tela na rotação
+#define TEMPO_TELA_IP_MS 3000    // Tempo da tela de rede após cada conexão
+#define PERIODO_HISTORICO_MS 5000
+#define PERIODO_ALARME_MS 10
+#define PERIODO_ALARME_OCIOSO_MS 250 // Cadência do sequenciador sem alarme soando
+#define PWM_DIV_BUZZER 100           // clkdiv do buzzer; a base segue o clk_sys atual
+#define PERIODO_AMOSTRA_MS 500           // Cadência do laço com a interface ativa
+#define PERIODO_AMOSTRA_ECONOMIA_MS 2000 // Cadência com a interface apagada
+#define TEMPO_INATIVIDADE_MS 60000       // Sem interação até apagar OLED e matriz
+#define WS2812_FREQ 800000
+#define WATCHDOG_BOOT_MS 8000    // Cobre a inicialização dos periféricos e da rede (máximo ~8,3 s)
+#define WATCHDOG_TIMEOUT_MS 3000
+#define WATCHDOG_MARGEM_MS 1000  // Reservado ao trabalho de uma iteração entre o sono e a alimentação
+#define DORME_MAX_MS (WATCHDOG_TIMEOUT_MS - WATCHDOG_MARGEM_MS)
+_Static_assert(PERIODO_AMOSTRA_ECONOMIA_MS <= DORME_MAX_MS, "amostragem mais lenta que o watchdog permite");
+#define OTA_PASSO_MS 20          // Sono entre gravações da fila do /update
+#define PERIODO_PERFIL_MS (6u * 3600u * 1000u) // Perfil da agenda na flash: ~1500 apagamentos por ano
+
+// Tarefas críticas que precisam se apresentar antes de alimentar o watchdog
+#define TAREFA_CONTROLE (1u << 0)
+#define TAREFA_DISPLAY  (1u << 1)
+#define TAREFA_REDE     (1u << 2)
+#define TAREFA_ALARME   (1u << 3)
+#define TAREFAS_CRITICAS (TAREFA_CONTROLE | TAREFA_DISPLAY | TAREFA_REDE | TAREFA_ALARME)
 
 
 // ===== VARIÁVEIS GLOBAIS =====
 volatile float lim_min = LIM_MIN_PADRAO;
 volatile float lim_max = LIM_MAX_PADRAO;
 volatile float nivel_percentual = 0;
+volatile uint16_t leitura_adc = 0;
 volatile bool bomba_ligada = false;
-volatile bool resetar_limites = false;
+volatile bool botao_a_pressionado = false;  // Sinalizado pela IRQ, tratado no laço
+volatile bool silenciar_alarme = false;
 volatile uint32_t ultimo_tempo_A = 0;
+volatile uint32_t t_primeira_decisao_ms = 0;
+volatile float lim_min_efetivo = LIM_MIN_PADRAO;  // lim_min elevado pela agenda de tarifas
+agenda_t agenda;
+static controle_t controle = {.lim_min_efetivo = LIM_MIN_PADRAO};
+static repeating_timer_t timer_alarme;
+static volatile uint16_t freq_buzzer = 0;  // Frequência programada no PWM (0 = mudo)
+static volatile uint32_t tarefas_ok = 0;
+
+// ===== INTERFACE DO DISPLAY =====
+enum { TELA_NIVEL, TELA_HISTORICO, TELA_REDE, TELA_ALARMES, NUM_TELAS };
+
+static const uint8_t ICONES_WIFI[][8] = {
+    {0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00},  // Desconectado
+    {0x04, 0x12, 0x49, 0x6D, 0x49, 0x12, 0x04, 0x00},  // Conectado
+};
+static const uint8_t ICONES_ALARME[][8] = {
+    {0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00},  // Sem alarme
+    {0x40, 0x7C, 0x7E, 0xFF, 0x7E, 0x7C, 0x40, 0x00},  // Sino
+};
+
+static const char *const TXT_NIVEL = "Nível de Água:";
+static const char *const TXT_ADC = "ADC:";
+static const char *const TXT_HISTORICO = "Histórico";
+static const char *const TXT_REDE = "Rede:";
+static const char *const TXT_IP = "IP:";
+static const char *const TXT_ALARMES = "Alarmes:";
+
+static int32_t ui_nivel, ui_adc, ui_icone_wifi, ui_icone_alarme;
+static const char *ui_bomba = "";
+static const char *ui_wifi = "";
+static const char *ui_ip = "";
+static const char *ui_alarme = "";
+static const char *ui_alarme_estado = "";
+static char ip_str[16];
+static ui_historico_t historico_nivel;
+
+// Fonte de texto com 12 px de altura (acentos e descendentes); dígitos grandes com 15 px
+static ui_widget_t widgets_nivel[] = {
+    {.tipo = UI_ROTULO, .x = 4,   .y = 0,  .largura = 112, .altura = 12, .fonte = {.texto = &TXT_NIVEL}},
+    {.tipo = UI_ICONE,  .x = 120, .y = 2,  .largura = 8,   .altura = 8,  .fonte = {.valor = &ui_icone_wifi}, .extra = {.icones = ICONES_WIFI}},
+    {.tipo = UI_VALOR,  .x = 0,   .y = 16, .largura = 64,  .altura = 16, .fonte = {.valor = &ui_nivel}, .extra = {.sufixo = "%"},
+     .tipografia = &fonte_digitos, .centralizado = true},
+    {.tipo = UI_BARRA,  .x = 66,  .y = 20, .largura = 58,  .altura = 8,  .fonte = {.valor = &ui_nivel}},
+    {.tipo = UI_ROTULO, .x = 4,   .y = 37, .largura = 28,  .altura = 12, .fonte = {.texto = &TXT_ADC}},
+    {.tipo = UI_VALOR,  .x = 36,  .y = 37, .largura = 40,  .altura = 12, .fonte = {.valor = &ui_adc}},
+    {.tipo = UI_ROTULO, .x = 4,   .y = 52, .largura = 124, .altura = 12, .fonte = {.texto = &ui_bomba}},
+};
+static ui_widget_t widgets_historico[] = {
+    {.tipo = UI_ROTULO,  .x = 4, .y = 0,  .largura = 72,  .altura = 12, .fonte = {.texto = &TXT_HISTORICO}},
+    {.tipo = UI_GRAFICO, .x = 4, .y = 14, .largura = 120, .altura = 50, .fonte = {.historico = &historico_nivel}},
+};
+static ui_widget_t widgets_rede[] = {
+    {.tipo = UI_ROTULO, .x = 4, .y = 0,  .largura = 40,  .altura = 12, .fonte = {.texto = &TXT_REDE}},
+    {.tipo = UI_ROTULO, .x = 4, .y = 16, .largura = 120, .altura = 12, .fonte = {.texto = &ui_wifi}},
+    {.tipo = UI_ROTULO, .x = 4, .y = 34, .largura = 24,  .altura = 12, .fonte = {.texto = &TXT_IP}},
+    {.tipo = UI_ROTULO, .x = 0, .y = 50, .largura = 128, .altura = 12, .fonte = {.texto = &ui_ip}, .centralizado = true},
+};
+static ui_widget_t widgets_alarmes[] = {
+    {.tipo = UI_ROTULO, .x = 4,   .y = 0,  .largura = 64,  .altura = 12, .fonte = {.texto = &TXT_ALARMES}},
+    {.tipo = UI_ICONE,  .x = 112, .y = 2,  .largura = 8,   .altura = 8,  .fonte = {.valor = &ui_icone_alarme}, .extra = {.icones = ICONES_ALARME}},
+    {.tipo = UI_ROTULO, .x = 4,   .y = 20, .largura = 120, .altura = 12, .fonte = {.texto = &ui_alarme}},
+    {.tipo = UI_ROTULO, .x = 4,   .y = 38, .largura = 120, .altura = 12, .fonte = {.texto = &ui_alarme_estado}},
+};
+static const ui_tela_t telas[NUM_TELAS] = {
+    [TELA_NIVEL]     = {widgets_nivel, count_of(widgets_nivel)},
+    [TELA_HISTORICO] = {widgets_historico, count_of(widgets_historico)},
+    [TELA_REDE]      = {widgets_rede, count_of(widgets_rede)},
+    [TELA_ALARMES]   = {widgets_alarmes, count_of(widgets_alarmes)},
+};
+static ui_t ui;
 
 // ===== PROTÓTIPOS DE FUNÇÕES =====
 void irq_callback(uint gpio, uint32_t events);
 void inicializar_hardware(void);
 void inicializar_display(ssd1306_t *ssd);
-void inicializar_webserver(ssd1306_t *ssd);
+void inicializar_rede(void);
+bool atualiza_limites(float min, float max);
 void ws2812_put_pixel(uint32_t pixel_grb);
 uint32_t urgb_u32(uint8_t r, uint8_t g, uint8_t b);
-void atualiza_matriz(float nivel_percentual);
-void alerta_buzzer(float nivel_percentual);
-void controla_bomba(float nivel);
-void atualiza_display(ssd1306_t *ssd, uint16_t adc_value);
+void atualiza_matriz(float nivel_percentual, bool acesa);
+bool alarme_timer_callback(repeating_timer_t *rt);
+void avalia_alarmes(float nivel_percentual);
+void controla_bomba(uint32_t agora_ms, uint16_t adc_value);
+void salva_perfil_agenda(uint32_t agora_ms);
+void checkin_tarefa(uint32_t tarefa);
+bool alimenta_watchdog(void);
+void atualiza_display(uint16_t adc_value, bool visivel);
+void reconfigura_perifericos(void);
+void aplica_modo_energia(ssd1306_t *ssd, bool interface_ativa);
 
 // ===== IMPLEMENTAÇÃO DAS FUNÇÕES =====
 
@@ -71,8 +187,10 @@ void irq_callback(uint gpio, uint32_t events) {
         return;
     }
     
-    if (gpio == BUTTON_A && (tempo_atual - ultimo_tempo_A > DEBOUNCE_TIME)) {       
-        resetar_limites = true;
+    if (gpio == BUTTON_A && (tempo_atual - ultimo_tempo_A > DEBOUNCE_TIME)) {
+        // Só registra o toque (e acorda o laço); o efeito é decidido fora da IRQ
+        botao_a_pressionado = true;
+        energia_atividade();
         ultimo_tempo_A = tempo_atual;
     }
 }
@@ -82,6 +200,7 @@ void irq_callback(uint gpio, uint32_t events) {
  */
 void inicializar_hardware(void) {
     stdio_init_all();
+    energia_init(TEMPO_INATIVIDADE_MS);
     
     // Configuração dos botões
     gpio_init(BUTTON_A);
@@ -116,16 +235,31 @@ void inicializar_hardware(void) {
     gpio_set_function(BUZZER, GPIO_FUNC_PWM);
     
     uint slice_num = pwm_gpio_to_slice_num(BUZZER);
-    pwm_set_clkdiv(slice_num, 100.0f);
+    pwm_set_clkdiv(slice_num, PWM_DIV_BUZZER);
     pwm_set_wrap(slice_num, 2500);  // 125MHz / 100 / 2500 = 500Hz
     pwm_set_chan_level(slice_num, PWM_CHAN_B, 0);
     pwm_set_enabled(slice_num, true);
 
+    // Sequenciador de alarmes em timer próprio, independente do laço principal
+    alarme_init();
+    add_repeating_timer_ms(PERIODO_ALARME_MS, alarme_timer_callback, NULL, &timer_alarme);
+
     // Configuração da matriz de LEDs WS2812
     PIO pio = pio0;
     int sm = 0;
     uint offset = pio_add_program(pio, &ws2812_program);
-    ws2812_program_init(pio, sm, offset, MATRIX_PIN, 800000, false);
+    ws2812_program_init(pio, sm, offset, MATRIX_PIN, WS2812_FREQ, false);
+}
+
+/**
+ * Reajusta os periféricos cuja temporização deriva de clk_sys/clk_peri
+ * após uma troca de clock
+ */
+void reconfigura_perifericos(void) {
+    i2c_set_baudrate(I2C_PORT, 400 * 1000);
+    pio_sm_set_clkdiv(pio0, 0, (float)clock_get_hz(clk_sys) /
+                      (WS2812_FREQ * (ws2812_T1 + ws2812_T2 + ws2812_T3)));
+    freq_buzzer = UINT16_MAX;  // Força o timer do alarme a recalcular o wrap
 }
 
 /**
@@ -136,35 +270,73 @@ void inicializar_display(ssd1306_t *ssd) {
     ssd1306_config(ssd);
     ssd1306_fill(ssd, false);
     ssd1306_send_data(ssd);
+    ui_init(&ui, ssd, telas, NUM_TELAS);
 }
 
 /**
- * Inicializa o servidor web e mostra informações no display
+ * Mapa Modbus. Input: 0 = ADC bruto, 1 = nível x10, 2 = bomba, 3 = alarme,
+ * 4 = falhas do diagnóstico. Holding: 0 = lim_min x10, 1 = lim_max x10.
  */
-void inicializar_webserver(ssd1306_t *ssd) {
-    ssd1306_fill(ssd, false);
-    ssd1306_draw_string(ssd, "Conectando WiFi", 6, 22);
-    ssd1306_send_data(ssd);
+static uint8_t modbus_le_input(uint16_t registrador, uint16_t *valor) {
+    switch (registrador) {
+        case 0: *valor = leitura_adc; break;
+        case 1: *valor = (uint16_t)(nivel_percentual * 10.0f + 0.5f); break;
+        case 2: *valor = bomba_ligada; break;
+        case 3: *valor = alarme_classe_atual(); break;
+        case 4: *valor = (uint16_t)diagnostico_falhas(); break;
+        default: return MODBUS_EXC_ENDERECO_ILEGAL;
+    }
+    return 0;
+}
 
-    if (!webserver_init()) {
-        printf("Falha ao iniciar o servidor web.\n");
-        ssd1306_fill(ssd, false);
-        ssd1306_draw_string(ssd, "WiFi: FALHA", 8, 22);
-        ssd1306_send_data(ssd);
-        while(true); // Para execução em caso de falha
+static uint8_t modbus_le_holding(uint16_t registrador, uint16_t *valor) {
+    switch (registrador) {
+        case 0: *valor = (uint16_t)(lim_min * 10.0f + 0.5f); break;
+        case 1: *valor = (uint16_t)(lim_max * 10.0f + 0.5f); break;
+        default: return MODBUS_EXC_ENDERECO_ILEGAL;
     }
-    
-    // Obtém e exibe o IP
-    uint8_t *ip = (uint8_t *)&(cyw43_state.netif[0].ip_addr.addr);
-    char ip_str[24];
-    snprintf(ip_str, sizeof(ip_str), "%d.%d.%d.%d", ip[0], ip[1], ip[2], ip[3]);
-    printf("IP: %s\n", ip_str);
+    return 0;
+}
 
-    ssd1306_fill(ssd, false);
-    ssd1306_draw_string(ssd, "IP:", 8, 6);
-    ssd1306_draw_string(ssd, ip_str, 8, 22);
-    ssd1306_send_data(ssd);
-    sleep_ms(3000); // Mostra o IP por 3 segundos
+static uint8_t modbus_escreve_holding(uint16_t primeiro, const uint16_t *valores, uint16_t quantidade) {
+    float limites[2] = {lim_min, lim_max};
+    for (uint16_t i = 0; i < quantidade; i++) {
+        limites[primeiro + i] = valores[i] / 10.0f;
+    }
+    return atualiza_limites(limites[0], limites[1]) ? 0 : MODBUS_EXC_VALOR_ILEGAL;
+}
+
+static const modbus_mapa_t mapa_modbus = {
+    .num_input = 5,
+    .num_holding = 2,
+    .le_input = modbus_le_input,
+    .le_holding = modbus_le_holding,
+    .escreve_holding = modbus_escreve_holding,
+};
+
+/**
+ * Inicia o Wi-Fi em segundo plano e o servidor web, sem bloquear o controle
+ */
+void inicializar_rede(void) {
+    if (!wifi_init()) {
+        printf("Falha ao iniciar o Wi-Fi, seguindo apenas com o controle local.\n");
+        return;
+    }
+    webserver_init();
+    modbus_tcp_init(&mapa_modbus);
+}
+
+/**
+ * Valida e aplica novos limites; caminho único para a web e o Modbus
+ */
+bool atualiza_limites(float min, float max) {
+    if (!(min >= 0.0f && max <= 100.0f && min < max)) {
+        return false;
+    }
+    lim_min = min;
+    lim_max = max;
+    trace(TRACE_LIMITES, (uint16_t)(min * 10.0f), (uint32_t)(max * 10.0f));
+    return true;
 }
 
 /**
@@ -184,13 +356,17 @@ uint32_t urgb_u32(uint8_t r, uint8_t g, uint8_t b) {
 /**
  * Atualiza a matriz de LEDs baseada no nível percentual
  */
-void atualiza_matriz(float nivel_percentual) {
+void atualiza_matriz(float nivel_percentual, bool acesa) {
+    static uint32_t frame_anterior[NUM_LEDS];
+    static bool enviado = false;
     uint32_t frame[NUM_LEDS] = {0};  // Buffer com 25 LEDs apagados
     uint32_t cor_azul = urgb_u32(0, 0, 8);
     uint32_t cor_vermelha = urgb_u32(8, 0, 0);
 
     // Define quais LEDs acender baseado no nível
-    if (nivel_percentual >= 20.0 && nivel_percentual <= 30.0) {
+    if (!acesa) {
+        // Interface apagada: mantém o frame zerado
+    } else if (nivel_percentual >= 20.0 && nivel_percentual <= 30.0) {
         // Primeira linha (0-4) - vermelha (nível baixo)
         for (int i = 0; i <= 4; i++) {
             frame[i] = cor_vermelha;
@@ -233,6 +409,13 @@ void atualiza_matriz(float nivel_percentual) {
         }
     }
 
+    // Só reenvia quando o desenho muda; a matriz mantém o último frame
+    if (enviado && memcmp(frame, frame_anterior, sizeof(frame)) == 0) {
+        return;
+    }
+    memcpy(frame_anterior, frame, sizeof(frame));
+    enviado = true;
+
     // Envia o frame completo para a matriz WS2812
     for (int i = 0; i < NUM_LEDS; i++) {
         ws2812_put_pixel(frame[i]);
@@ -241,60 +424,198 @@ void atualiza_matriz(float nivel_percentual) {
 }
 
 /**
- * Controla o buzzer baseado no nível de água
+ * Avança o padrão do alarme e ajusta a frequência do buzzer (contexto de IRQ)
  */
-void alerta_buzzer(float nivel_percentual) {
-    uint slice_num = pwm_gpio_to_slice_num(BUZZER);
-    static int contador = 0;
-    contador++;
+bool alarme_timer_callback(repeating_timer_t *rt) {
+    uint16_t freq = alarme_tick(to_ms_since_boot(get_absolute_time()));
 
-    // Buzzer intermitente quando fora dos limites
-    if (nivel_percentual < lim_min || nivel_percentual > lim_max) {
-        if (contador % 4 < 2) {
-            pwm_set_chan_level(slice_num, PWM_CHAN_B, 1250);  // Liga buzzer
+    if (freq != freq_buzzer) {
+        uint slice_num = pwm_gpio_to_slice_num(BUZZER);
+        if (freq) {
+            uint16_t wrap = clock_get_hz(clk_sys) / PWM_DIV_BUZZER / freq - 1;
+            pwm_set_wrap(slice_num, wrap);
+            pwm_set_chan_level(slice_num, PWM_CHAN_B, wrap / 2);  // Liga buzzer
         } else {
-            pwm_set_chan_level(slice_num, PWM_CHAN_B, 0);     // Desliga buzzer
+            pwm_set_chan_level(slice_num, PWM_CHAN_B, 0);         // Desliga buzzer
         }
-    } else {
-        pwm_set_chan_level(slice_num, PWM_CHAN_B, 0);         // Buzzer desligado
+        freq_buzzer = freq;
     }
+    // Sem alarme soando o sequenciador só precisa notar a próxima ativação
+    rt->delay_us = (alarme_soando() ? PERIODO_ALARME_MS : PERIODO_ALARME_OCIOSO_MS) * 1000;
+    checkin_tarefa(TAREFA_ALARME);
+    return true;
 }
 
 /**
- * Controla a bomba baseada nos limites configurados
+ * Ativa os alarmes de nível conforme os limites configurados
  */
-void controla_bomba(float nivel) {
-    if (nivel < lim_min && !bomba_ligada) {
-        gpio_put(RELAY_PIN, 0);  // Liga a bomba
-        bomba_ligada = true;
-    } else if (nivel > lim_max && bomba_ligada) {
-        gpio_put(RELAY_PIN, 1);  // Desliga a bomba
-        bomba_ligada = false;
+void avalia_alarmes(float nivel_percentual) {
+    static alarme_classe_t classe_anterior = ALARME_NENHUM;
+    alarme_ativa(ALARME_NIVEL_BAIXO, nivel_percentual < lim_min);
+    alarme_ativa(ALARME_NIVEL_ALTO, nivel_percentual > lim_max);
+    alarme_classe_t classe = alarme_classe_atual();
+    if (classe != classe_anterior) {
+        trace(TRACE_ALARME, classe, 0);
+        classe_anterior = classe;
     }
 }
 
 /**
- * Atualiza as informações no display OLED
+ * Diagnóstico, agenda e decisão da bomba para uma leitura (controle_amostra,
+ * o mesmo passo do tools/reproduz.c) e os efeitos no hardware
  */
-void atualiza_display(ssd1306_t *ssd, uint16_t adc_value) {
-    char buffer_adc[20];
-    char buffer_nivel[10];
-    
-    sprintf(buffer_nivel, "%1.0f%%", nivel_percentual);
-    sprintf(buffer_adc, "ADC: %d", adc_value);
-    
-    ssd1306_fill(ssd, false);
-    ssd1306_draw_string(ssd, "Nivel de Agua:", 8, 6); 
-    ssd1306_draw_string(ssd, buffer_nivel, 8, 22); 
-    ssd1306_draw_string(ssd, buffer_adc, 8, 41);
-    ssd1306_draw_string(ssd, bomba_ligada ? "Bomba: LIGADA" : "Bomba: DESLIGADA", 8, 52);  
-    ssd1306_send_data(ssd);
+void controla_bomba(uint32_t agora_ms, uint16_t adc_value) {
+    // Aprende o consumo por hora da semana só quando há hora de parede (SNTP);
+    // em falha a bomba fica desligada e em tarifa barata o mínimo sobe
+    uint32_t epoca_s;
+    bool tem_hora = wifi_hora(agora_ms, &epoca_s);
+    bool mudou = controle_amostra(&controle, &agenda, agora_ms, adc_value, tem_hora ? &epoca_s : NULL,
+                                  lim_min, lim_max);
+    nivel_percentual = controle.nivel;
+    lim_min_efetivo = controle.lim_min_efetivo;
+    bomba_ligada = controle.bomba_ligada;
+
+    static uint32_t falhas_anteriores = 0;
+    if (controle.falhas != falhas_anteriores) {
+        trace(TRACE_DIAGNOSTICO, controle.falhas, adc_value);
+        falhas_anteriores = controle.falhas;
+    }
+    alarme_ativa(ALARME_FALHA_SENSOR, controle.falhas & DIAG_FALHAS_SENSOR);
+    alarme_ativa(ALARME_BOMBA_SECO, controle.falhas & DIAG_BOMBA_SECO);
+
+    if (mudou) {
+        gpio_put(RELAY_PIN, controle.bomba_ligada ? 0 : 1);  // Relé ativo em nível baixo
+        trace(TRACE_BOMBA, controle.bomba_ligada, (uint32_t)(controle.nivel * 10.0f));
+    }
+}
+
+/**
+ * Grava o perfil aprendido da agenda no setor de dados da flash, no máximo
+ * a cada PERIODO_PERFIL_MS e só se mudou; um reinício perde no máximo esse
+ * intervalo de aprendizado
+ */
+void salva_perfil_agenda(uint32_t agora_ms) {
+    static uint32_t t_ultimo_ms = 0;
+    static uint8_t perfil[AGENDA_PERFIL_TAM];
+    if (agora_ms - t_ultimo_ms < PERIODO_PERFIL_MS) {
+        return;
+    }
+    t_ultimo_ms = agora_ms;
+    agenda_perfil_serializa(&agenda, perfil);
+    if (memcmp(perfil, ota_dados_aplicacao(), sizeof(perfil)) != 0) {
+        ota_grava_dados_aplicacao(perfil, sizeof(perfil));
+    }
+}
+
+/**
+ * Registra que uma tarefa crítica executou neste ciclo. Chamada também pela
+ * IRQ do timer do alarme: a leitura-modificação-escrita roda com as
+ * interrupções desligadas para que nenhum bit se perca
+ */
+void checkin_tarefa(uint32_t tarefa) {
+    uint32_t estado = save_and_disable_interrupts();
+    tarefas_ok |= tarefa;
+    restore_interrupts(estado);
+}
+
+/**
+ * Alimenta o watchdog somente quando todas as tarefas críticas se apresentaram;
+ * retorna true se alimentou (iteração saudável)
+ */
+bool alimenta_watchdog(void) {
+    uint32_t estado = save_and_disable_interrupts();
+    bool todas = (tarefas_ok & TAREFAS_CRITICAS) == TAREFAS_CRITICAS;
+    if (todas) {
+        tarefas_ok &= ~TAREFAS_CRITICAS;  // Só os bits conferidos
+    }
+    restore_interrupts(estado);
+    if (todas) {
+        watchdog_update();
+    }
+    return todas;
+}
+
+/**
+ * Atualiza os valores vinculados à interface e redesenha o que mudou
+ */
+void atualiza_display(uint16_t adc_value, bool visivel) {
+    static uint32_t t_troca_tela = 0;
+    static uint32_t t_historico = 0;
+    static uint32_t ultima_conexao = 0;
+    uint32_t agora = to_ms_since_boot(get_absolute_time());
+    const wifi_metricas_t *wm = wifi_metricas();
+
+    ui_nivel = (int32_t)(nivel_percentual + 0.5f);
+    ui_adc = adc_value;
+    ui_bomba = bomba_ligada ? "Bomba: LIGADA" : "Bomba: DESLIGADA";
+
+    ui_icone_wifi = wifi_estado() == WIFI_CONECTADO;
+    ui_wifi = wifi_estado_str();
+    if (wifi_estado() == WIFI_CONECTADO) {
+        wifi_ip_str(ip_str, sizeof(ip_str));
+        ui_ip = ip_str;
+    } else {
+        ui_ip = "--";
+    }
+
+    alarme_classe_t alarme = alarme_classe_atual();
+    ui_icone_alarme = alarme != ALARME_NENHUM;
+    ui_alarme = alarme_nome(alarme);
+    ui_alarme_estado = alarme == ALARME_NENHUM ? "" : (alarme_soando() ? "Soando" : "Silenciado");
+
+    if (agora - t_historico >= PERIODO_HISTORICO_MS) {
+        ui_historico_adiciona(&historico_nivel, ui_nivel);
+        t_historico = agora;
+    }
+
+    // Após cada conexão mostra a tela de rede; depois segue a rotação normal
+    if (wm->t_ultima_conexao_ms != ultima_conexao) {
+        ultima_conexao = wm->t_ultima_conexao_ms;
+        ui_mostra_tela(&ui, TELA_REDE);
+        t_troca_tela = agora - (TEMPO_TELA_MS - TEMPO_TELA_IP_MS);
+    } else if (agora - t_troca_tela >= TEMPO_TELA_MS) {
+        ui_proxima_tela(&ui);
+        t_troca_tela = agora;
+    }
+
+    // Apagado, só os valores são atualizados; o que mudou é desenhado ao acender
+    if (visivel) {
+        ui_renderiza(&ui);
+    }
+}
+
+/**
+ * Com a interface apagada, desliga o OLED, reduz clk_sys e põe o rádio em
+ * economia; tudo é revertido na primeira interação ou alarme
+ */
+void aplica_modo_energia(ssd1306_t *ssd, bool interface_ativa) {
+    static bool ativa = true;
+    if (interface_ativa == ativa) {
+        return;
+    }
+    ativa = interface_ativa;
+
+    ssd1306_command(ssd, SET_DISP | (ativa ? 0x01 : 0x00));
+    // A troca de clock não pode ocorrer no meio de uma transação do cyw43
+    cyw43_arch_lwip_begin();
+    bool mudou = energia_clock_reduzido(!ativa);
+    cyw43_arch_lwip_end();
+    if (mudou) {
+        reconfigura_perifericos();
+    }
+    wifi_economia(!ativa);
 }
 
 // ===== FUNÇÃO PRINCIPAL =====
 int main() {
     uint16_t adc_value_x;    
-    float volume_atual = 0.0f;
+    bool gravando = false;
+
+    // Antes de qualquer periférico: uma imagem em teste conta o boot (ou
+    // reverte) e o watchdog já cobre uma inicialização que trave
+    ota_boot_verifica();
+    watchdog_enable(WATCHDOG_BOOT_MS, true);
+
     // Inicialização do hardware
     inicializar_hardware();
     
@@ -302,41 +623,129 @@ int main() {
     ssd1306_t ssd;
     inicializar_display(&ssd);
     
-    // Inicialização do servidor web
-    inicializar_webserver(&ssd);
+    // Inicialização da rede em segundo plano
+    inicializar_rede();
+    webserver_espelha_tela(&ssd);
     
     adc_select_input(2); 
 
+    trace(TRACE_BOOT, watchdog_caused_reboot(), 0);
+    diagnostico_init(NULL);
+    agenda_init(&agenda, agenda_tarifa_branca, agenda_tarifa_branca_num, AGENDA_FUSO_PADRAO_S);
+    // Perfil aprendido antes do reinício; setor apagado ou de outra versão
+    // deixa a agenda vazia, aprendendo do zero
+    agenda_perfil_carrega(&agenda, ota_dados_aplicacao(), OTA_SETOR_TAM);
+    // Prazo do laço a partir da primeira iteração
+    watchdog_enable(WATCHDOG_TIMEOUT_MS, true);
+    bool ota_confirmada = false;
+
+    bool interface_acesa = true;  // Estado da interface na iteração anterior
+
     // Loop principal
     while (true) {
+        uint32_t inicio_ms = to_ms_since_boot(get_absolute_time());
+
         // Poll do WiFi
         cyw43_arch_poll();
+        wifi_poll(inicio_ms);
+        checkin_tarefa(TAREFA_REDE);
         
-        // Reset dos limites se solicitado pelo botão A
-        if (resetar_limites) {
-            lim_min = LIM_MIN_PADRAO;
-            lim_max = LIM_MAX_PADRAO;
-            resetar_limites = false;
+        // Botão A: com alarme soando apenas o silencia; com a interface
+        // apagada apenas a acende; senão restaura os limites padrão
+        if (botao_a_pressionado) {
+            botao_a_pressionado = false;
+            if (alarme_soando()) {
+                silenciar_alarme = true;
+            } else if (interface_acesa) {
+                lim_min = LIM_MIN_PADRAO;
+                lim_max = LIM_MAX_PADRAO;
+            }
         }
 
-        // Leitura do ADC e cálculo do nível percentual
-        adc_value_x = adc_read();
-        volume_atual = 1.5f + (6.3f * ((float)(adc_value_x - 2680) / -640.0f));
-        nivel_percentual = ((volume_atual - 1.5f) / 6.3f) * 100;
+        // Reconhecimento do alarme pelo botão A ou pela web
+        // (gravado para que o reprodutor aplique o mesmo rearme)
+        uint32_t agora_ms = to_ms_since_boot(get_absolute_time());
+        if (silenciar_alarme) {
+            controle_reconhece();
+            silenciar_alarme = false;
+            if (gravando) {
+                printf("NVL ACK %lu\n", (unsigned long)agora_ms);
+            }
+        }
 
-        // Controle da bomba
-        controla_bomba(nivel_percentual);
+        // Leitura do ADC; nível, diagnóstico e decisão num só passo
+        adc_value_x = adc_read();
+        leitura_adc = adc_value_x;
+        if (gravando) {
+            printf("NVL %lu %u\n", (unsigned long)agora_ms, adc_value_x);
+        }
+        controla_bomba(agora_ms, adc_value_x);
+        checkin_tarefa(TAREFA_CONTROLE);
+        if (t_primeira_decisao_ms == 0) {
+            t_primeira_decisao_ms = to_ms_since_boot(get_absolute_time());
+        }
         
+        // OLED e matriz apagam após inatividade; um alarme soando os reacende
+        bool interface_ativa = energia_interface_ativa(agora_ms) || alarme_soando();
+        interface_acesa = interface_ativa;
+        aplica_modo_energia(&ssd, interface_ativa);
+
         // Atualização do display
-        atualiza_display(&ssd, adc_value_x);
+        atualiza_display(adc_value_x, interface_ativa);
+        checkin_tarefa(TAREFA_DISPLAY);
         
         // Atualização da matriz de LEDs
-        atualiza_matriz(nivel_percentual);
-        
-        // Controle do buzzer de alerta
-        //alerta_buzzer(nivel_percentual);
+        atualiza_matriz(nivel_percentual, interface_ativa);
         
-        sleep_ms(500);
+        // Alarmes de nível (o buzzer é tocado pelo timer do alarme)
+        avalia_alarmes(nivel_percentual);
+
+        // Publica o estado para os clientes web (serializado uma vez por amostra)
+        webserver_publica_estado();
+
+        // Imagem recebida por /update: troca as regiões e reinicia
+        uint32_t tamanho_ota;
+        if (webserver_ota_pronta(agora_ms, &tamanho_ota)) {
+            ota_troca_e_reinicia(tamanho_ota);
+        }
+        salva_perfil_agenda(agora_ms);
+
+        // Comandos pela USB: 't' despeja o rastreamento, 'g' liga/desliga a
+        // gravação das leituras brutas para tools/reproduz.c
+        int comando = getchar_timeout_us(0);
+        if (comando == 't') {
+            trace_despeja_usb();
+        } else if (comando == 'g') {
+            gravando = !gravando;
+        }
+        trace_despeja_usb_passo();
+
+        // Dorme até a próxima amostra ou tentativa de Wi-Fi; um botão acorda
+        // antes. O watchdog é alimentado logo antes e o sono nunca passa de
+        // DORME_MAX_MS, deixando a margem para a iteração seguinte
+        uint32_t periodo = interface_ativa ? PERIODO_AMOSTRA_MS : PERIODO_AMOSTRA_ECONOMIA_MS;
+        uint32_t prazo = wifi_proximo_prazo(inicio_ms, periodo);
+        bool saudavel = alimenta_watchdog();
+        uint32_t agora_sono = to_ms_since_boot(get_absolute_time());
+        if ((int32_t)(prazo - (agora_sono + DORME_MAX_MS)) > 0) {
+            prazo = agora_sono + DORME_MAX_MS;
+        }
+
+        // Imagem nova confirmada só depois da primeira iteração saudável
+        if (saudavel && !ota_confirmada) {
+            ota_confirma();
+            ota_confirmada = true;
+        }
+
+        // Upload por /update em andamento: a fila recebida pelo lwIP é
+        // gravada aqui, fora do contexto de IRQ, em passos curtos até o prazo
+        while (webserver_ota_processa() && (int32_t)(prazo - agora_sono) > OTA_PASSO_MS) {
+            energia_prazo(agora_sono + OTA_PASSO_MS);
+            energia_dorme();
+            agora_sono = to_ms_since_boot(get_absolute_time());
+        }
+        energia_prazo(prazo);
+        energia_dorme();
     }
     
     return 0;
@@ -0,0 +1,23 @@
+#ifndef BANCADA_H
+#define BANCADA_H
+
+// Relógios para as medições no host. Os números absolutos são do PC; o que
+// vale é a comparação entre variantes medidas no mesmo processo.
+
+#include <stdint.h>
+#include <time.h>
+
+static inline uint64_t bancada_ns(void) {
+    struct timespec t;
+    clock_gettime(CLOCK_MONOTONIC, &t);
+    return (uint64_t)t.tv_sec * 1000000000u + (uint64_t)t.tv_nsec;
+}
+
+// Tempo de CPU do processo, sem o tempo em que ele esperou
+static inline uint64_t bancada_cpu_ns(void) {
+    struct timespec t;
+    clock_gettime(CLOCK_PROCESS_CPUTIME_ID, &t);
+    return (uint64_t)t.tv_sec * 1000000000u + (uint64_t)t.tv_nsec;
+}
+
+#endif // BANCADA_H
@@ -0,0 +1,166 @@
+/**
+ * Tempo de CPU por requisição de /estado no servidor real (buffer publicado
+ * uma vez por amostra e enviado sem cópia; 304 com If-None-Match) contra uma
+ * réplica do tratador anterior, que formatava o JSON com %.1f e copiava a
+ * resposta inteira a cada requisição. As duas variantes passam pelo mesmo
+ * lwIP simulado; "recv" é só o callback, "ciclo" inclui conexão, envio, ACK
+ * e fechamento.
+ *
+ * Uso: bench_http [requisicoes]
+ */
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "alarme.h"
+#include "bancada.h"
+#include "servidor_host.h"
+#include "teste.h"
+#include "webserver.h"
+
+#define PORTA_ANTES 8080
+
+// ===== Tratador de /estado antes do buffer compartilhado =====
+
+struct antes_estado {
+    char response[1792];
+    size_t len;
+    size_t sent;
+};
+
+static err_t antes_sent(void *arg, struct tcp_pcb *tpcb, u16_t len) {
+    struct antes_estado *hs = arg;
+    hs->sent += len;
+    if (hs->sent >= hs->len) {
+        tcp_arg(tpcb, NULL);
+        tcp_close(tpcb);
+        free(hs);
+    }
+    return ERR_OK;
+}
+
+static err_t antes_recv(void *arg, struct tcp_pcb *tpcb, struct pbuf *p, err_t err) {
+    (void)arg;
+    (void)err;
+    if (!p) {
+        return ERR_OK;
+    }
+    char req[512];
+    u16_t req_len = pbuf_copy_partial(p, req, sizeof(req) - 1, 0);
+    req[req_len] = '\0';
+    tcp_recved(tpcb, p->tot_len);
+
+    struct antes_estado *hs = malloc(sizeof(struct antes_estado));
+    hs->sent = 0;
+    if (strstr(req, "GET /limites") || strstr(req, "GET /alarme/silenciar")) {
+        hs->len = 0;
+    } else if (strstr(req, "GET /estado")) {
+        alarme_classe_t alarme = alarme_classe_atual();
+        char json_payload[160];
+        int json_len = snprintf(json_payload, sizeof(json_payload),
+                                "{\"nivel\":%.1f,\"bomba\":%s,\"alarme\":\"%s\",\"silenciado\":%s}",
+                                nivel_percentual, bomba_ligada ? "true" : "false",
+                                alarme_nome(alarme),
+                                (alarme != ALARME_NENHUM && !alarme_soando()) ? "true" : "false");
+        hs->len = snprintf(hs->response, sizeof(hs->response),
+                           "HTTP/1.1 200 OK\r\n"
+                           "Content-Type: application/json\r\n"
+                           "Content-Length: %d\r\n"
+                           "Connection: close\r\n\r\n%s",
+                           json_len, json_payload);
+    }
+    tcp_arg(tpcb, hs);
+    tcp_sent(tpcb, antes_sent);
+    tcp_write(tpcb, hs->response, hs->len, TCP_WRITE_FLAG_COPY);
+    tcp_output(tpcb);
+    pbuf_free(p);
+    return ERR_OK;
+}
+
+static err_t antes_accept(void *arg, struct tcp_pcb *newpcb, err_t err) {
+    (void)arg;
+    (void)err;
+    tcp_recv(newpcb, antes_recv);
+    return ERR_OK;
+}
+
+// ===== Medição =====
+
+typedef struct {
+    uint64_t recv_ns;
+    uint64_t ciclo_ns;
+    size_t bytes;
+} medida_t;
+
+static char resp[4096];
+
+static medida_t mede(uint16_t porta, const char *req, int requisicoes) {
+    medida_t m = {0};
+    size_t req_len = strlen(req);
+    for (int i = 0; i < requisicoes; i++) {
+        uint64_t t0 = bancada_cpu_ns();
+        struct tcp_pcb *pcb = lwip_host_conecta(porta);
+        uint64_t t1 = bancada_cpu_ns();
+        lwip_host_envia(pcb, req, req_len);
+        uint64_t t2 = bancada_cpu_ns();
+        size_t n = 0, lidos;
+        while ((lidos = lwip_host_recebe(pcb, resp + n, sizeof(resp) - n)) > 0) {
+            n += lidos;
+            lwip_host_confirma(pcb, lidos);
+        }
+        lwip_host_libera(pcb);
+        uint64_t t3 = bancada_cpu_ns();
+        m.recv_ns += t2 - t1;
+        m.ciclo_ns += t3 - t0;
+        m.bytes += n;
+    }
+    return m;
+}
+
+static void relata(const char *nome, medida_t m, int requisicoes, double referencia) {
+    double recv = (double)m.recv_ns / requisicoes;
+    printf("%-34s recv %7.0f ns  ciclo %7.0f ns  %4zu bytes  recv %4.1fx\n", nome, recv,
+           (double)m.ciclo_ns / requisicoes, m.bytes / requisicoes, referencia / recv);
+}
+
+int main(int argc, char **argv) {
+    int requisicoes = argc > 1 ? atoi(argv[1]) : 100000;
+    alarme_init();
+    servidor_host_inicia();
+    struct tcp_pcb *escuta = tcp_new();
+    tcp_bind(escuta, IP_ADDR_ANY, PORTA_ANTES);
+    escuta = tcp_listen(escuta);
+    tcp_accept(escuta, antes_accept);
+
+    nivel_percentual = 42.5f;
+    int publicacoes = requisicoes / 10;
+    uint64_t t0 = bancada_cpu_ns();
+    for (int i = 0; i < publicacoes; i++) {
+        // Alterna o valor para que toda publicação gere um buffer novo
+        nivel_percentual = (i & 1) ? 42.5f : 42.6f;
+        webserver_publica_estado();
+    }
+    double publica_ns = (double)(bancada_cpu_ns() - t0) / (publicacoes ? publicacoes : 1);
+
+    const char *req = "GET /estado HTTP/1.1\r\nHost: pico\r\n\r\n";
+    servidor_host_requisicao(80, req, false, resp, sizeof(resp));
+    const char *etag = strstr(resp, "ETag: \"");
+    char req_304[160];
+    snprintf(req_304, sizeof(req_304), "GET /estado HTTP/1.1\r\nHost: pico\r\nIf-None-Match: \"%lu\"\r\n\r\n",
+             etag ? strtoul(etag + 7, NULL, 10) : 0ul);
+
+    medida_t antes = mede(PORTA_ANTES, req, requisicoes);
+    medida_t depois = mede(80, req, requisicoes);
+    medida_t nao_modificado = mede(80, req_304, requisicoes);
+    double ref = (double)antes.recv_ns / requisicoes;
+
+    printf("%d requisições por variante; CPU do processo por requisição\n", requisicoes);
+    relata("antes (%.1f + cópia)", antes, requisicoes, ref);
+    relata("/estado 200 (buffer compartilhado)", depois, requisicoes, ref);
+    relata("/estado 304 (If-None-Match)", nao_modificado, requisicoes, ref);
+    printf("publicação por amostra: %.0f ns\n", publica_ns);
+
+    CHECA(antes.bytes > 0 && depois.bytes > 0 && nao_modificado.bytes > 0);
+    CHECA_IGUAL(lwip_stats.mem.used, 0);
+    return TESTE_FIM();
+}
@@ -0,0 +1,187 @@
+/**
+ * Driver SSD1306 em modelo (lib/ssd1306.hpp pela API em C) contra uma
+ * réplica do driver C anterior, que desenhava tudo por ssd1306_pixel e
+ * montava a janela suja num buffer estático do tamanho do quadro. As duas
+ * variantes desenham a mesma sequência e enviam ao SSD1306 emulado; o teste
+ * confere que framebuffer e GDDRAM ficam iguais e imprime o tempo por
+ * operação e o custo no barramento (I2C a 400 kHz).
+ *
+ * Uso: bench_ssd1306 [repeticoes]
+ */
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "bancada.h"
+#include "font.h"
+#include "painel_host.h"
+#include "ssd1306.h"
+#include "teste.h"
+
+// ===== Driver anterior (lib/ssd1306.c antes do modelo) =====
+
+static uint8_t antes_buffer[WIDTH * HEIGHT / 8 + 1] = {0x40};
+static uint8_t antes_sujo[WIDTH * HEIGHT / 8 + 1];
+
+static void antes_comando(uint8_t c) {
+    const uint8_t pacote[2] = {0x80, c};
+    i2c_write_blocking(i2c1, 0x3C, pacote, 2, false);
+}
+
+static void antes_pixel(uint8_t x, uint8_t y, bool valor) {
+    uint16_t index = (y >> 3) + (x << 3) + 1;
+    uint8_t pixel = (y & 0b111);
+    if (valor)
+        antes_buffer[index] |= (1 << pixel);
+    else
+        antes_buffer[index] &= ~(1 << pixel);
+}
+
+static void antes_fill(bool valor) {
+    for (uint8_t y = 0; y < HEIGHT; ++y)
+        for (uint8_t x = 0; x < WIDTH; ++x)
+            antes_pixel(x, y, valor);
+}
+
+static void antes_rect(uint8_t top, uint8_t left, uint8_t width, uint8_t height, bool valor, bool fill) {
+    for (uint8_t x = left; x < left + width; ++x) {
+        antes_pixel(x, top, valor);
+        antes_pixel(x, top + height - 1, valor);
+    }
+    for (uint8_t y = top; y < top + height; ++y) {
+        antes_pixel(left, y, valor);
+        antes_pixel(left + width - 1, y, valor);
+    }
+    if (fill)
+        for (uint8_t x = left + 1; x < left + width - 1; ++x)
+            for (uint8_t y = top + 1; y < top + height - 1; ++y)
+                antes_pixel(x, y, valor);
+}
+
+static void antes_draw_string(const char *s, uint8_t x, uint8_t y) {
+    for (; *s && x + 8 < WIDTH; s++, x += 8) {
+        uint16_t index = (*s >= ' ' && *s <= '~') ? (*s - ' ') * 8 : 0;
+        for (uint8_t i = 0; i < 8; ++i)
+            for (uint8_t j = 0; j < 8; ++j)
+                antes_pixel(x + i, y + j, font[index + i] & (1 << j));
+    }
+}
+
+static void antes_envia_janela(uint8_t x0, uint8_t x1, uint8_t p0, uint8_t p1) {
+    size_t len = 1;
+    antes_sujo[0] = 0x40;
+    for (uint16_t x = x0; x <= x1; ++x)
+        for (uint8_t p = p0; p <= p1; ++p)
+            antes_sujo[len++] = antes_buffer[1 + x * (HEIGHT / 8) + p];
+    antes_comando(0x21);
+    antes_comando(x0);
+    antes_comando(x1);
+    antes_comando(0x22);
+    antes_comando(p0);
+    antes_comando(p1);
+    i2c_write_blocking(i2c1, 0x3C, antes_sujo, len, false);
+}
+
+// ===== Medição =====
+
+static ssd1306_t ssd;
+
+typedef enum { LIMPA, RETANGULO, TEXTO, JANELA, NUM_OPERACOES } operacao_t;
+
+static const char *const NOMES[NUM_OPERACOES] = {
+    "fill (quadro inteiro)",
+    "rect cheio 100x20",
+    "draw_string 15 caracteres",
+    "janela 124x2 páginas (I2C)",
+};
+
+// Uma operação em uma das variantes; i varia a posição e o conteúdo
+static void executa(operacao_t op, bool antes, int i) {
+    static const char *const TEXTO_BENCH = "Nivel: 42% ok! ";
+    uint8_t y = (uint8_t)(8 + (i & 7));
+    switch (op) {
+        case LIMPA:
+            antes ? antes_fill(i & 1) : ssd1306_fill(&ssd, i & 1);
+            break;
+        case RETANGULO:
+            antes ? antes_rect(y, 10, 100, 20, !(i & 1), true) : ssd1306_rect(&ssd, y, 10, 100, 20, !(i & 1), true);
+            break;
+        case TEXTO:
+            antes ? antes_draw_string(TEXTO_BENCH, 0, y) : ssd1306_draw_string(&ssd, TEXTO_BENCH, 0, y);
+            break;
+        case JANELA:
+            if (antes) {
+                antes_envia_janela(0, 123, 2, 3);
+            } else {
+                ssd1306_mark_dirty(&ssd, 0, 16, 124, 16);
+                ssd1306_send_dirty(&ssd);
+            }
+            break;
+        default:
+            break;
+    }
+}
+
+typedef struct {
+    double ns;
+    uint32_t transacoes, bytes;
+} medida_t;
+
+static medida_t mede(operacao_t op, bool antes, int repeticoes) {
+    painel_host_zera_contadores();
+    uint64_t t0 = bancada_cpu_ns();
+    for (int i = 0; i < repeticoes; i++) {
+        executa(op, antes, i);
+    }
+    medida_t m = {(double)(bancada_cpu_ns() - t0) / repeticoes, painel_host.transacoes / repeticoes, 0};
+    // Comandos vão em pares (0x80, c); dados com um byte de controle por transação
+    m.bytes = (2 * painel_host.comandos + (painel_host.transacoes - painel_host.comandos) + painel_host.bytes_dados) /
+              repeticoes;
+    return m;
+}
+
+// Tempo no barramento a 400 kHz: 9 bits por byte mais endereço, START e STOP
+static double i2c_us(medida_t m) {
+    return (m.bytes * 9.0 + m.transacoes * 11.0) / 400e3 * 1e6;
+}
+
+int main(int argc, char **argv) {
+    int repeticoes = argc > 1 ? atoi(argv[1]) : 20000;
+    painel_host_reinicia();
+    ssd1306_init(&ssd, WIDTH, HEIGHT, false, 0x3C, i2c1);
+    ssd1306_config(&ssd);
+
+    printf("%d repetições; CPU do processo por operação\n", repeticoes);
+    printf("%-28s %12s %12s %7s  %s\n", "", "anterior", "modelo", "", "barramento (anterior -> modelo)");
+    for (operacao_t op = 0; op < NUM_OPERACOES; op++) {
+        medida_t a = mede(op, true, repeticoes);
+        medida_t d = mede(op, false, repeticoes);
+        printf("%-28s %9.1f ns %9.1f ns %6.1fx", NOMES[op], a.ns, d.ns, a.ns / d.ns);
+        if (op == JANELA) {
+            printf("  %lu -> %lu transações, %lu -> %lu bytes, %.0f -> %.0f us",
+                   (unsigned long)a.transacoes, (unsigned long)d.transacoes, (unsigned long)a.bytes,
+                   (unsigned long)d.bytes, i2c_us(a), i2c_us(d));
+        }
+        printf("\n");
+    }
+
+    // Mesma sequência nas duas variantes: framebuffers e GDDRAM iguais
+    for (operacao_t op = 0; op < JANELA; op++) {
+        for (int i = 0; i < 3; i++) {
+            executa(op, true, i);
+            executa(op, false, i);
+        }
+    }
+    CHECA(memcmp(antes_buffer + 1, ssd.ram_buffer + 1, sizeof(antes_buffer) - 1) == 0);
+    antes_envia_janela(0, 123, 1, 4);
+    static uint8_t gddram_antes[PAINEL_HOST_LARGURA][PAINEL_HOST_PAGINAS];
+    memcpy(gddram_antes, painel_host.gddram, sizeof(gddram_antes));
+    memset(painel_host.gddram, 0, sizeof(painel_host.gddram));
+    ssd1306_mark_dirty(&ssd, 0, 8, 124, 32);
+    ssd1306_send_dirty(&ssd);
+    CHECA(memcmp(gddram_antes, painel_host.gddram, sizeof(gddram_antes)) == 0);
+    ssd1306_send_data(&ssd);
+    CHECA(painel_host_igual(ssd.ram_buffer + 1, ssd.width, ssd.pages));
+
+    return TESTE_FIM();
+}
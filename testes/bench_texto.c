@@ -0,0 +1,129 @@
+/**
+ * Vazão de glifos do caminho de texto: texto_desenha com os atlas gerados
+ * (cópia de colunas por página) contra a fonte 8x8 fixa pelo driver e contra
+ * a referência por pixel da versão original (ssd1306_draw_char chamava
+ * ssd1306_pixel 64 vezes por caractere).
+ *
+ * Uso: bench_texto [repeticoes]
+ */
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "bancada.h"
+#include "font.h"
+#include "fonte_digitos.h"
+#include "fonte_texto.h"
+#include "painel_host.h"
+#include "teste.h"
+
+static const char *const FRASES[] = {
+    "Nível de Água:",
+    "Bomba: DESLIGADA",
+    "Ação não é exceção",
+    "192.168.100.254",
+};
+
+static ssd1306_t ssd;
+
+// Caractere 8x8 como era desenhado antes dos atlas, pixel a pixel
+static void char_por_pixel(char c, uint8_t x, uint8_t y) {
+    uint16_t index = (c >= ' ' && c <= '~') ? (c - ' ') * 8 : 0;
+    for (uint8_t i = 0; i < 8; ++i) {
+        uint8_t line = font[index + i];
+        for (uint8_t j = 0; j < 8; ++j) {
+            ssd1306_pixel(&ssd, x + i, y + j, line & (1 << j));
+        }
+    }
+}
+
+static void string_por_pixel(const char *s, uint8_t x, uint8_t y) {
+    for (; *s && x + 8 <= ssd.width; s++, x += 8) {
+        char_por_pixel(*s, x, y);
+    }
+}
+
+static uint32_t soma_framebuffer(void) {
+    uint32_t soma = 0;
+    for (size_t i = 1; i < ssd.bufsize; i++) {
+        soma = soma * 31 + ssd.ram_buffer[i];
+    }
+    return soma;
+}
+
+// Glifos do atlas numa frase UTF-8 (para normalizar o tempo)
+static uint32_t glifos_texto(const char *s) {
+    uint32_t n = 0;
+    while (texto_utf8_proximo(&s)) {
+        n++;
+    }
+    return n;
+}
+
+typedef enum { ATLAS_TEXTO, FIXA_8X8, POR_PIXEL } variante_t;
+
+static double mede(variante_t v, int repeticoes, uint32_t *glifos) {
+    *glifos = 0;
+    uint64_t t0 = bancada_ns();
+    for (int r = 0; r < repeticoes; r++) {
+        // y alterna entre alinhado à página e atravessando duas páginas
+        uint8_t y = (r & 1) ? 3 : 16;
+        for (size_t i = 0; i < count_of(FRASES); i++) {
+            switch (v) {
+                case ATLAS_TEXTO:
+                    texto_desenha(&ssd, &fonte_texto, FRASES[i], 0, y + 12 * (i & 1));
+                    *glifos += glifos_texto(FRASES[i]);
+                    break;
+                case FIXA_8X8:
+                    ssd1306_draw_string(&ssd, FRASES[i], 0, y + 12 * (i & 1));
+                    *glifos += strlen(FRASES[i]);  // Um glifo por byte, quebrando a linha
+                    break;
+                case POR_PIXEL:
+                    string_por_pixel(FRASES[i], 0, y + 12 * (i & 1));
+                    *glifos += strlen(FRASES[i]) < 16 ? strlen(FRASES[i]) : 16;
+                    break;
+            }
+        }
+    }
+    return (double)(bancada_ns() - t0);
+}
+
+static double mede_digitos(int repeticoes, uint32_t *glifos) {
+    static const char *const VALORES[] = {"0%", "42%", "100%", "7%"};
+    *glifos = 0;
+    uint64_t t0 = bancada_ns();
+    for (int r = 0; r < repeticoes; r++) {
+        const char *s = VALORES[r & 3];
+        texto_desenha(&ssd, &fonte_digitos, s, 10, (r & 1) ? 16 : 19);
+        *glifos += glifos_texto(s);
+    }
+    return (double)(bancada_ns() - t0);
+}
+
+static void relata(const char *nome, double ns, uint32_t glifos, double referencia) {
+    printf("%-38s %7.1f ns/glifo  %10.0f glifos/s  %5.1fx\n", nome, ns / glifos,
+           glifos * 1e9 / ns, referencia / (ns / glifos));
+}
+
+int main(int argc, char **argv) {
+    int repeticoes = argc > 1 ? atoi(argv[1]) : 20000;
+    painel_host_reinicia();
+    ssd1306_init(&ssd, WIDTH, HEIGHT, false, 0x3C, i2c1);
+
+    uint32_t g_pixel, g_fixa, g_atlas, g_digitos;
+    double t_pixel = mede(POR_PIXEL, repeticoes, &g_pixel);
+    double t_fixa = mede(FIXA_8X8, repeticoes, &g_fixa);
+    double t_atlas = mede(ATLAS_TEXTO, repeticoes, &g_atlas);
+    double t_digitos = mede_digitos(repeticoes, &g_digitos);
+    double ref = t_pixel / g_pixel;
+
+    printf("%d repetições; vazão relativa à referência por pixel\n", repeticoes);
+    relata("8x8 por pixel (original)", t_pixel, g_pixel, ref);
+    relata("8x8 por coluna (ssd1306_draw_string)", t_fixa, g_fixa, ref);
+    relata("fonte_texto (atlas, UTF-8, kerning)", t_atlas, g_atlas, ref);
+    relata("fonte_digitos (atlas 15 px)", t_digitos, g_digitos, ref);
+    printf("soma do framebuffer: %08x\n", soma_framebuffer());
+
+    CHECA(g_atlas > 0 && g_digitos > 0);
+    return TESTE_FIM();
+}
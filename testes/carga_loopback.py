@@ -0,0 +1,66 @@
+#!/usr/bin/env python3
+"""
+Roda o tools/carga_http.py contra o servidor do firmware no host
+(servidor_loopback) e falha se houver erro de transporte ou de alocação
+no lwIP simulado. Imprime o relatório da carga e o pico dos pools.
+
+Uso: carga_loopback.py <servidor_loopback> <carga_http.py> [porta] [argumentos da carga...]
+"""
+
+import json
+import socket
+import subprocess
+import sys
+import time
+
+
+def espera_porta(porta, limite_s=5.0):
+    fim = time.monotonic() + limite_s
+    while time.monotonic() < fim:
+        try:
+            socket.create_connection(("127.0.0.1", porta), 0.2).close()
+            return True
+        except OSError:
+            time.sleep(0.05)
+    return False
+
+
+def main():
+    servidor, carga, porta = sys.argv[1], sys.argv[2], int(sys.argv[3]) if len(sys.argv) > 3 else 8080
+    extra = sys.argv[4:] or ["-c", "8", "-d", "3"]
+    proc = subprocess.Popen([servidor, str(porta)], stdout=subprocess.PIPE, text=True)
+    try:
+        # A sonda de conexão não envia nada: o servidor a trata como cliente que fechou
+        if not espera_porta(porta):
+            print("servidor_loopback não abriu a porta %d" % porta)
+            return 1
+        saida = subprocess.run([sys.executable, carga, "127.0.0.1", "-p", str(porta), "--json"] + extra,
+                               check=True, capture_output=True, text=True).stdout
+    finally:
+        proc.terminate()
+        final = proc.communicate(timeout=10)[0]
+    relatorio = json.loads(saida)
+    print(json.dumps({k: relatorio[k] for k in ("concorrencia", "requisicoes", "req_por_s", "latencia_ms",
+                                                "erros", "status")}, ensure_ascii=False))
+    print(final.strip())
+
+    lwip = relatorio.get("lwip") or {}
+    falhas = []
+    if relatorio["requisicoes"] == 0:
+        falhas.append("nenhuma requisição atendida")
+    transporte = {k: v for k, v in relatorio["erros"].items() if not k.startswith("http_")}
+    if transporte:
+        falhas.append("erros de transporte: %s" % transporte)
+    if not isinstance(lwip, dict):
+        falhas.append("sem estatísticas do lwIP: %s" % lwip)
+    else:
+        for pool in ("mem", "tcp_seg", "pbuf_pool"):
+            if lwip[pool]["err"]:
+                falhas.append("falhas de alocação em %s: %d" % (pool, lwip[pool]["err"]))
+    for f in falhas:
+        print("falhou: " + f)
+    return 1 if falhas else 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
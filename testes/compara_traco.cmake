@@ -0,0 +1,15 @@
+# Roda o reprodutor numa gravação de traces/ e compara o resumo com o
+# esperado; qualquer diferença falha o teste mostrando as duas saídas.
+#   cmake -DREPRODUZ=... -DTRACO=traces/x.nvl -DARGS="--epoca 0" -DESPERADO=traces/x.esperado -P compara_traco.cmake
+separate_arguments(argumentos UNIX_COMMAND "${ARGS}")
+execute_process(COMMAND ${REPRODUZ} ${argumentos} ${TRACO}
+                OUTPUT_VARIABLE obtido
+                RESULT_VARIABLE resultado)
+if(NOT resultado EQUAL 0)
+    message(FATAL_ERROR "reproduz terminou com ${resultado}")
+endif()
+file(READ ${ESPERADO} esperado)
+if(NOT obtido STREQUAL esperado)
+    message(FATAL_ERROR "Resumo diferente de ${ESPERADO}\n--- esperado\n${esperado}--- obtido\n${obtido}"
+                        "Se a mudança for intencional: tools/gera_tracos.py --reproduz <build>/reproduz")
+endif()
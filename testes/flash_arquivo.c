@@ -0,0 +1,101 @@
+#include <string.h>
+
+#include "flash_arquivo.h"
+
+bool flash_arquivo_abre(flash_arquivo_t *fa, const char *caminho, uint32_t tamanho) {
+    memset(fa, 0, sizeof(*fa));
+    fa->bit_preso = -1;
+    fa->f = caminho ? fopen(caminho, "w+b") : tmpfile();
+    if (!fa->f) {
+        return false;
+    }
+    fa->tamanho = tamanho;
+    uint8_t apagado[OTA_SETOR_TAM];
+    memset(apagado, 0xFF, sizeof(apagado));
+    for (uint32_t i = 0; i < tamanho; i += OTA_SETOR_TAM) {
+        if (fwrite(apagado, 1, OTA_SETOR_TAM, fa->f) != OTA_SETOR_TAM) {
+            return false;
+        }
+    }
+    return fflush(fa->f) == 0;
+}
+
+void flash_arquivo_fecha(flash_arquivo_t *fa) {
+    if (fa->f) {
+        fclose(fa->f);
+        fa->f = NULL;
+    }
+}
+
+ota_flash_t flash_arquivo_backend(flash_arquivo_t *fa) {
+    return (ota_flash_t){
+        .ctx = fa,
+        .apaga = flash_arquivo_apaga,
+        .programa = flash_arquivo_programa,
+        .le = flash_arquivo_le,
+    };
+}
+
+static bool dentro(const flash_arquivo_t *fa, uint32_t offset, uint32_t len) {
+    return offset <= fa->tamanho && len <= fa->tamanho - offset;
+}
+
+// Conta a operação e diz se é a que deve falhar
+static bool falha_injetada(flash_arquivo_t *fa) {
+    return fa->falha_na_operacao && fa->apagamentos + fa->programacoes == fa->falha_na_operacao;
+}
+
+bool flash_arquivo_apaga(void *ctx, uint32_t offset, uint32_t len) {
+    flash_arquivo_t *fa = ctx;
+    fa->apagamentos++;
+    if (falha_injetada(fa) || !dentro(fa, offset, len) || offset % OTA_SETOR_TAM || len % OTA_SETOR_TAM) {
+        return false;
+    }
+    uint8_t apagado[OTA_SETOR_TAM];
+    memset(apagado, 0xFF, sizeof(apagado));
+    fseek(fa->f, offset, SEEK_SET);
+    for (uint32_t i = 0; i < len; i += OTA_SETOR_TAM) {
+        if (fwrite(apagado, 1, OTA_SETOR_TAM, fa->f) != OTA_SETOR_TAM) {
+            return false;
+        }
+    }
+    return fflush(fa->f) == 0;
+}
+
+bool flash_arquivo_programa(void *ctx, uint32_t offset, const uint8_t *dados, uint32_t len) {
+    flash_arquivo_t *fa = ctx;
+    fa->programacoes++;
+    if (falha_injetada(fa) || !dentro(fa, offset, len) || offset % FLASH_ARQUIVO_PAGINA ||
+        len % FLASH_ARQUIVO_PAGINA) {
+        return false;
+    }
+    uint8_t pagina[FLASH_ARQUIVO_PAGINA];
+    for (uint32_t i = 0; i < len; i += FLASH_ARQUIVO_PAGINA) {
+        fseek(fa->f, offset + i, SEEK_SET);
+        if (fread(pagina, 1, sizeof(pagina), fa->f) != sizeof(pagina)) {
+            return false;
+        }
+        for (uint32_t j = 0; j < FLASH_ARQUIVO_PAGINA; j++) {
+            uint8_t novo = pagina[j] & dados[i + j];  // NOR: só 1 -> 0
+            int64_t bit = ((int64_t)offset + i + j) * 8;
+            if (fa->bit_preso >= bit && fa->bit_preso < bit + 8) {
+                novo |= (uint8_t)(1u << (fa->bit_preso - bit));
+            }
+            pagina[j] = novo;
+        }
+        fseek(fa->f, offset + i, SEEK_SET);
+        if (fwrite(pagina, 1, sizeof(pagina), fa->f) != sizeof(pagina)) {
+            return false;
+        }
+    }
+    return fflush(fa->f) == 0;
+}
+
+bool flash_arquivo_le(void *ctx, uint32_t offset, uint8_t *dados, uint32_t len) {
+    flash_arquivo_t *fa = ctx;
+    if (!dentro(fa, offset, len)) {
+        return false;
+    }
+    fseek(fa->f, offset, SEEK_SET);
+    return fread(dados, 1, len, fa->f) == len;
+}
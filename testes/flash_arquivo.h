@@ -0,0 +1,36 @@
+#ifndef FLASH_ARQUIVO_H
+#define FLASH_ARQUIVO_H
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdio.h>
+
+#include "ota.h"
+
+// Flash NOR simulada num arquivo, para ota.c e /update no host: apagar leva
+// setores alinhados a 0xFF e programar só zera bits (páginas de 256 bytes
+// alinhadas), de modo que programar sem apagar antes aparece na releitura.
+// Falhas injetáveis: operação que retorna erro e bit preso em 1.
+
+#define FLASH_ARQUIVO_PAGINA 256
+
+typedef struct {
+    FILE *f;
+    uint32_t tamanho;
+    uint32_t apagamentos;
+    uint32_t programacoes;
+    uint32_t falha_na_operacao;  // Apagar/programar número N falha (0 = nunca)
+    int64_t bit_preso;           // Bit (offset * 8 + bit) que não programa (-1 = nenhum)
+} flash_arquivo_t;
+
+// Cria a flash apagada; caminho NULL usa um arquivo temporário
+bool flash_arquivo_abre(flash_arquivo_t *fa, const char *caminho, uint32_t tamanho);
+void flash_arquivo_fecha(flash_arquivo_t *fa);
+// Backend para ota_inicia com ctx = fa
+ota_flash_t flash_arquivo_backend(flash_arquivo_t *fa);
+
+bool flash_arquivo_apaga(void *ctx, uint32_t offset, uint32_t len);
+bool flash_arquivo_programa(void *ctx, uint32_t offset, const uint8_t *dados, uint32_t len);
+bool flash_arquivo_le(void *ctx, uint32_t offset, uint8_t *dados, uint32_t len);
+
+#endif // FLASH_ARQUIVO_H
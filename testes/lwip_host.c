@@ -0,0 +1,510 @@
+#include <stdlib.h>
+#include <string.h>
+
+#include "lwip_host.h"
+
+// Custo no heap do lwIP (MEM_SIZE) de cada segmento: pbuf + cabeçalhos
+// Ethernet/IP/TCP, mais os dados quando copiados (alinhado a MEM_ALIGNMENT)
+#define SEG_CABECALHO (16 + 14 + 20 + 20)
+#define ALINHA(n) (((n) + MEM_ALIGNMENT - 1) & ~(MEM_ALIGNMENT - 1))
+
+struct lwip_host_seg {
+    struct lwip_host_seg *proximo;
+    const uint8_t *dados;  // Cópia própria ou memória da aplicação (sem cópia)
+    uint8_t *copia;
+    u16_t len;
+    u16_t custo_mem;
+};
+
+struct stats_ lwip_stats;
+static struct stats_mem memp_stats[MEMP_MAX];
+static struct tcp_pcb *pcbs = NULL;
+
+static bool aloca(struct stats_mem *s, uint32_t n) {
+    if (s->used + n > s->avail) {
+        s->err++;
+        return false;
+    }
+    s->used += n;
+    if (s->used > s->max) {
+        s->max = s->used;
+    }
+    return true;
+}
+
+static void devolve(struct stats_mem *s, uint32_t n) {
+    s->used -= n;
+}
+
+void lwip_host_reinicia(void) {
+    while (pcbs) {
+        struct tcp_pcb *p = pcbs;
+        pcbs = p->proximo;
+        free(p->entrada);
+        free(p);
+    }
+    memset(&lwip_stats, 0, sizeof(lwip_stats));
+    memset(memp_stats, 0, sizeof(memp_stats));
+    lwip_stats.mem.avail = MEM_SIZE;
+    memp_stats[MEMP_TCP_PCB].avail = MEMP_NUM_TCP_PCB;
+    memp_stats[MEMP_TCP_SEG].avail = MEMP_NUM_TCP_SEG;
+    memp_stats[MEMP_PBUF_POOL].avail = PBUF_POOL_SIZE;
+    for (int i = 0; i < MEMP_MAX; i++) {
+        lwip_stats.memp[i] = &memp_stats[i];
+    }
+}
+
+// ===== pbuf =====
+
+static struct pbuf *pbuf_pool(const uint8_t *dados, u16_t len) {
+    if (!aloca(&memp_stats[MEMP_PBUF_POOL], 1)) {
+        return NULL;
+    }
+    struct pbuf *p = malloc(sizeof(struct pbuf) + len);
+    p->next = NULL;
+    p->payload = p + 1;
+    p->tot_len = p->len = len;
+    p->ref = 1;
+    p->do_pool = 1;
+    memcpy(p->payload, dados, len);
+    return p;
+}
+
+u8_t pbuf_free(struct pbuf *p) {
+    u8_t liberados = 0;
+    while (p && --p->ref == 0) {
+        struct pbuf *proximo = p->next;
+        if (p->do_pool) {
+            devolve(&memp_stats[MEMP_PBUF_POOL], 1);
+        }
+        free(p);
+        liberados++;
+        p = proximo;
+    }
+    return liberados;
+}
+
+void pbuf_ref(struct pbuf *p) {
+    p->ref++;
+}
+
+void pbuf_cat(struct pbuf *head, struct pbuf *tail) {
+    struct pbuf *p = head;
+    for (; p->next; p = p->next) {
+        p->tot_len += tail->tot_len;
+    }
+    p->tot_len += tail->tot_len;
+    p->next = tail;
+}
+
+u16_t pbuf_copy_partial(const struct pbuf *p, void *dataptr, u16_t len, u16_t offset) {
+    u16_t copiados = 0;
+    for (; p && copiados < len; p = p->next) {
+        if (offset >= p->len) {
+            offset -= p->len;
+            continue;
+        }
+        u16_t n = p->len - offset;
+        if (n > len - copiados) {
+            n = len - copiados;
+        }
+        memcpy((uint8_t *)dataptr + copiados, (const uint8_t *)p->payload + offset, n);
+        copiados += n;
+        offset = 0;
+    }
+    return copiados;
+}
+
+// Como no lwIP: descarta `size` bytes do início, liberando os pbufs esgotados
+struct pbuf *pbuf_free_header(struct pbuf *q, u16_t size) {
+    while (q && size >= q->len) {
+        struct pbuf *proximo = q->next;
+        size -= q->len;
+        q->next = NULL;
+        pbuf_free(q);
+        q = proximo;
+    }
+    if (q && size) {
+        q->payload = (uint8_t *)q->payload + size;
+        q->len -= size;
+        for (struct pbuf *r = q; r; r = r->next) {
+            r->tot_len -= size;
+        }
+    }
+    return q;
+}
+
+// ===== pcb =====
+
+static struct tcp_pcb *pcb_novo(void) {
+    if (!aloca(&memp_stats[MEMP_TCP_PCB], 1)) {
+        return NULL;
+    }
+    struct tcp_pcb *pcb = calloc(1, sizeof(struct tcp_pcb));
+    pcb->janela = TCP_WND;
+    pcb->proximo = pcbs;
+    pcbs = pcb;
+    return pcb;
+}
+
+static void descarta_fila(struct tcp_pcb *pcb) {
+    while (pcb->fila) {
+        struct lwip_host_seg *s = pcb->fila;
+        pcb->fila = s->proximo;
+        devolve(&lwip_stats.mem, s->custo_mem);
+        devolve(&memp_stats[MEMP_TCP_SEG], 1);
+        free(s->copia);
+        free(s);
+    }
+    pcb->na_fila = pcb->em_voo = 0;
+    pcb->snd_queuelen = 0;
+}
+
+// Fim da conexão do ponto de vista do lwIP: o pcb volta ao pool
+static void encerra(struct tcp_pcb *pcb) {
+    if (pcb->encerrado) {
+        return;
+    }
+    descarta_fila(pcb);
+    if (pcb->recusado) {
+        pbuf_free(pcb->recusado);
+        pcb->recusado = NULL;
+    }
+    pcb->encerrado = true;
+    devolve(&memp_stats[MEMP_TCP_PCB], 1);
+}
+
+struct tcp_pcb *tcp_new(void) {
+    return pcb_novo();
+}
+
+err_t tcp_bind(struct tcp_pcb *pcb, const void *ip, u16_t porta) {
+    (void)ip;
+    pcb->porta = porta;
+    return ERR_OK;
+}
+
+struct tcp_pcb *tcp_listen(struct tcp_pcb *pcb) {
+    pcb->escutando = true;
+    return pcb;
+}
+
+void tcp_accept(struct tcp_pcb *pcb, tcp_accept_fn accept) {
+    pcb->accept = accept;
+}
+
+void tcp_arg(struct tcp_pcb *pcb, void *arg) {
+    pcb->callback_arg = arg;
+}
+
+void tcp_recv(struct tcp_pcb *pcb, tcp_recv_fn recv) {
+    pcb->recv = recv;
+}
+
+void tcp_sent(struct tcp_pcb *pcb, tcp_sent_fn sent) {
+    pcb->sent = sent;
+}
+
+void tcp_err(struct tcp_pcb *pcb, tcp_err_fn err) {
+    pcb->errf = err;
+}
+
+void tcp_poll(struct tcp_pcb *pcb, tcp_poll_fn poll, u8_t interval) {
+    pcb->poll = poll;
+    pcb->pollinterval = interval;
+}
+
+/**
+ * Enfileira como o lwIP: recusa com ERR_MEM se não houver espaço no buffer de
+ * envio, na fila de segmentos, no pool de segmentos ou no heap. Cada trecho
+ * de até TCP_MSS vira um segmento; os dados sem cópia só são lidos quando
+ * transmitidos (lwip_host_recebe).
+ */
+err_t tcp_write(struct tcp_pcb *pcb, const void *dados, u16_t len, u8_t flags) {
+    if (pcb->fechado || pcb->encerrado) {
+        return ERR_CONN;
+    }
+    if (len == 0) {
+        return ERR_OK;
+    }
+    if (len > tcp_sndbuf(pcb)) {
+        return ERR_MEM;
+    }
+    u16_t segs = (len + TCP_MSS - 1) / TCP_MSS;
+    if (pcb->snd_queuelen + segs > TCP_SND_QUEUELEN) {
+        return ERR_MEM;
+    }
+    bool copia = flags & TCP_WRITE_FLAG_COPY;
+    uint32_t custo = 0;
+    for (uint32_t feito = 0; feito < len; feito += TCP_MSS) {
+        u16_t n = len - feito < TCP_MSS ? len - feito : TCP_MSS;
+        custo += ALINHA(SEG_CABECALHO + (copia ? n : 0));
+    }
+    if (!aloca(&memp_stats[MEMP_TCP_SEG], segs)) {
+        return ERR_MEM;
+    }
+    if (!aloca(&lwip_stats.mem, custo)) {
+        devolve(&memp_stats[MEMP_TCP_SEG], segs);
+        return ERR_MEM;
+    }
+
+    struct lwip_host_seg **fim = &pcb->fila;
+    while (*fim) {
+        fim = &(*fim)->proximo;
+    }
+    for (uint32_t feito = 0; feito < len; feito += TCP_MSS) {
+        u16_t n = len - feito < TCP_MSS ? len - feito : TCP_MSS;
+        struct lwip_host_seg *s = calloc(1, sizeof(*s));
+        s->len = n;
+        s->custo_mem = ALINHA(SEG_CABECALHO + (copia ? n : 0));
+        if (copia) {
+            s->copia = malloc(n);
+            memcpy(s->copia, (const uint8_t *)dados + feito, n);
+            s->dados = s->copia;
+        } else {
+            s->dados = (const uint8_t *)dados + feito;
+        }
+        *fim = s;
+        fim = &s->proximo;
+    }
+    pcb->na_fila += len;
+    pcb->snd_queuelen += segs;
+    return ERR_OK;
+}
+
+err_t tcp_output(struct tcp_pcb *pcb) {
+    (void)pcb;
+    return ERR_OK;
+}
+
+void tcp_recved(struct tcp_pcb *pcb, u16_t len) {
+    pcb->janela += len;
+    if (pcb->janela > TCP_WND) {
+        pcb->janela = TCP_WND;
+    }
+}
+
+// Fecha: o que está na fila ainda sai, e o pcb só volta ao pool após o ACK
+err_t tcp_close(struct tcp_pcb *pcb) {
+    if (pcb->escutando) {
+        encerra(pcb);
+        return ERR_OK;
+    }
+    pcb->fechado = true;
+    if (pcb->na_fila == 0) {
+        encerra(pcb);
+    }
+    return ERR_OK;
+}
+
+void tcp_abort(struct tcp_pcb *pcb) {
+    if (pcb->encerrado) {
+        return;
+    }
+    encerra(pcb);
+    if (pcb->errf) {
+        pcb->errf(pcb->callback_arg, ERR_ABRT);
+    }
+}
+
+// ===== Lado do cliente =====
+
+struct tcp_pcb *lwip_host_conecta(u16_t porta) {
+    struct tcp_pcb *escuta = pcbs;
+    while (escuta && !(escuta->escutando && !escuta->encerrado && escuta->porta == porta)) {
+        escuta = escuta->proximo;
+    }
+    if (!escuta) {
+        return NULL;
+    }
+    struct tcp_pcb *pcb = pcb_novo();
+    if (!pcb) {
+        return NULL;
+    }
+    pcb->porta = porta;
+    pcb->callback_arg = escuta->callback_arg;
+    if (escuta->accept(escuta->callback_arg, pcb, ERR_OK) != ERR_OK) {
+        return NULL;  // A aplicação abortou o pcb (ERR_ABRT)
+    }
+    return pcb;
+}
+
+// Chama o recv; false se a aplicação recusou (ERR_MEM e afins) ou abortou
+static bool entrega(struct tcp_pcb *pcb, struct pbuf *p) {
+    if (!pcb->recv) {
+        // Sem callback o lwIP consome e descarta (tcp_recv_null)
+        if (p) {
+            tcp_recved(pcb, p->tot_len);
+            pbuf_free(p);
+        }
+        return true;
+    }
+    err_t r = pcb->recv(pcb->callback_arg, pcb, p, ERR_OK);
+    if (r == ERR_ABRT || pcb->encerrado) {
+        return false;
+    }
+    if (r != ERR_OK && p) {
+        pcb->recusado = p;
+        return false;
+    }
+    return true;
+}
+
+void lwip_host_processa(struct tcp_pcb *pcb) {
+    if (pcb->encerrado || pcb->fechado) {
+        return;
+    }
+    if (pcb->recusado) {
+        struct pbuf *p = pcb->recusado;
+        pcb->recusado = NULL;
+        if (!entrega(pcb, p)) {
+            return;
+        }
+    }
+    while (pcb->entrada_len && pcb->janela && !pcb->fechado) {
+        // Um pbuf do pool por segmento recebido; sem pool o pacote se perde
+        size_t total = pcb->entrada_len < pcb->janela ? pcb->entrada_len : pcb->janela;
+        if (total > 0xFFFF - TCP_MSS) {
+            total = 0xFFFF - TCP_MSS;
+        }
+        struct pbuf *cadeia = NULL;
+        size_t feito = 0;
+        while (feito < total) {
+            u16_t n = total - feito < TCP_MSS ? (u16_t)(total - feito) : TCP_MSS;
+            struct pbuf *q = pbuf_pool(pcb->entrada + feito, n);
+            if (!q) {
+                break;
+            }
+            if (cadeia) {
+                pbuf_cat(cadeia, q);
+            } else {
+                cadeia = q;
+            }
+            feito += n;
+        }
+        if (!cadeia) {
+            return;
+        }
+        pcb->janela -= feito;
+        pcb->entrada_len -= feito;
+        memmove(pcb->entrada, pcb->entrada + feito, pcb->entrada_len);
+        if (!entrega(pcb, cadeia)) {
+            return;
+        }
+    }
+    if (pcb->fin_remoto && !pcb->fin_entregue && pcb->entrada_len == 0 && !pcb->fechado) {
+        pcb->fin_entregue = true;
+        entrega(pcb, NULL);
+    }
+}
+
+void lwip_host_envia(struct tcp_pcb *pcb, const void *dados, size_t len) {
+    pcb->entrada = realloc(pcb->entrada, pcb->entrada_len + len);
+    memcpy(pcb->entrada + pcb->entrada_len, dados, len);
+    pcb->entrada_len += len;
+    lwip_host_processa(pcb);
+}
+
+void lwip_host_fin(struct tcp_pcb *pcb) {
+    pcb->fin_remoto = true;
+    lwip_host_processa(pcb);
+}
+
+void lwip_host_rst(struct tcp_pcb *pcb) {
+    if (pcb->encerrado) {
+        return;
+    }
+    encerra(pcb);
+    if (pcb->errf) {
+        pcb->errf(pcb->callback_arg, ERR_RST);
+    }
+}
+
+size_t lwip_host_recebe(struct tcp_pcb *pcb, void *buf, size_t max) {
+    size_t n = 0;
+    uint32_t pular = pcb->em_voo;
+    for (struct lwip_host_seg *s = pcb->fila; s && n < max; s = s->proximo) {
+        if (pular >= s->len) {
+            pular -= s->len;
+            continue;
+        }
+        size_t parte = s->len - pular;
+        if (parte > max - n) {
+            parte = max - n;
+        }
+        memcpy((uint8_t *)buf + n, s->dados + pular, parte);
+        n += parte;
+        pular = 0;
+    }
+    pcb->em_voo += n;
+    return n;
+}
+
+void lwip_host_confirma(struct tcp_pcb *pcb, size_t n) {
+    if (pcb->encerrado) {
+        return;
+    }
+    if (n > pcb->em_voo) {
+        n = pcb->em_voo;
+    }
+    size_t resta = n;
+    while (resta && pcb->fila) {
+        struct lwip_host_seg *s = pcb->fila;
+        if (resta < s->len) {
+            // ACK parcial: o segmento encolhe, a memória só volta inteira
+            s->dados += resta;
+            s->len -= resta;
+            break;
+        }
+        resta -= s->len;
+        pcb->fila = s->proximo;
+        pcb->snd_queuelen--;
+        devolve(&lwip_stats.mem, s->custo_mem);
+        devolve(&memp_stats[MEMP_TCP_SEG], 1);
+        free(s->copia);
+        free(s);
+    }
+    pcb->em_voo -= n;
+    pcb->na_fila -= n;
+    while (n && pcb->sent && !pcb->encerrado) {
+        u16_t parte = n > 0xFFFF ? 0xFFFF : (u16_t)n;
+        n -= parte;
+        pcb->sent(pcb->callback_arg, pcb, parte);
+    }
+    if (pcb->fechado && pcb->na_fila == 0) {
+        encerra(pcb);
+    }
+}
+
+void lwip_host_tick(void) {
+    for (struct tcp_pcb *pcb = pcbs; pcb; pcb = pcb->proximo) {
+        if (pcb->encerrado || pcb->escutando) {
+            continue;
+        }
+        lwip_host_processa(pcb);
+        if (pcb->poll && !pcb->encerrado && ++pcb->poll_ticks >= pcb->pollinterval) {
+            pcb->poll_ticks = 0;
+            pcb->poll(pcb->callback_arg, pcb);
+        }
+    }
+}
+
+size_t lwip_host_pendentes(const struct tcp_pcb *pcb) {
+    return pcb->entrada_len + (pcb->recusado ? pcb->recusado->tot_len : 0);
+}
+
+bool lwip_host_encerrado(const struct tcp_pcb *pcb) {
+    return pcb->encerrado;
+}
+
+void lwip_host_libera(struct tcp_pcb *pcb) {
+    lwip_host_rst(pcb);
+    for (struct tcp_pcb **p = &pcbs; *p; p = &(*p)->proximo) {
+        if (*p == pcb) {
+            *p = pcb->proximo;
+            break;
+        }
+    }
+    free(pcb->entrada);
+    free(pcb);
+}
@@ -0,0 +1,42 @@
+#ifndef LWIP_HOST_H
+#define LWIP_HOST_H
+
+#include <stdbool.h>
+#include <stddef.h>
+
+#include "lwip/stats.h"
+#include "lwip/tcp.h"
+
+// Lado do "cliente" do lwIP simulado: o teste abre conexões, entrega bytes
+// como se chegassem da rede, lê o que o servidor transmitiu e confirma (ACK)
+// quando quiser. Os callbacks da aplicação rodam na thread do teste, como no
+// contexto de IRQ do firmware. Os pools seguem o lwipopts.h (MEM_SIZE,
+// MEMP_NUM_TCP_SEG, PBUF_POOL_SIZE, MEMP_NUM_TCP_PCB) e as falhas de alocação
+// aparecem em lwip_stats como no alvo.
+
+void lwip_host_reinicia(void);
+// Abre uma conexão na porta; NULL sem listener ou sem pcb livre (SYN descartado)
+struct tcp_pcb *lwip_host_conecta(u16_t porta);
+// Bytes enviados pelo cliente: enfileirados e entregues ao recv conforme a
+// janela, o pool de pbufs e os dados recusados permitem
+void lwip_host_envia(struct tcp_pcb *pcb, const void *dados, size_t len);
+// Cliente fecha a escrita (FIN): recv recebe p == NULL depois dos dados
+void lwip_host_fin(struct tcp_pcb *pcb);
+// Cliente reinicia a conexão (RST): errf recebe ERR_RST
+void lwip_host_rst(struct tcp_pcb *pcb);
+// Transmite o que está na fila (lendo agora os dados sem cópia); retorna os bytes
+size_t lwip_host_recebe(struct tcp_pcb *pcb, void *buf, size_t max);
+// ACK de n bytes já transmitidos: libera segmentos e chama sent
+void lwip_host_confirma(struct tcp_pcb *pcb, size_t n);
+// Timer lento (500 ms): reentrega dados recusados e chama poll
+void lwip_host_tick(void);
+// Tenta de novo a entrega pendente de uma conexão
+void lwip_host_processa(struct tcp_pcb *pcb);
+// Bytes do cliente ainda não entregues ao recv (fila + recusados)
+size_t lwip_host_pendentes(const struct tcp_pcb *pcb);
+// Conexão terminou (fechada e toda confirmada, abortada ou reiniciada)
+bool lwip_host_encerrado(const struct tcp_pcb *pcb);
+// Descarta o pcb encerrado (o teste não pode mais usá-lo)
+void lwip_host_libera(struct tcp_pcb *pcb);
+
+#endif // LWIP_HOST_H
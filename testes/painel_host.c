@@ -0,0 +1,141 @@
+#include <stdio.h>
+#include <string.h>
+
+#include "hardware/i2c.h"
+#include "painel_host.h"
+
+struct i2c_inst {
+    int id;
+};
+
+static struct i2c_inst i2c1_host = {1};
+i2c_inst_t *i2c1 = &i2c1_host;
+
+painel_host_t painel_host;
+
+// Comando em andamento e quantos argumentos ainda faltam
+static uint8_t cmd_atual;
+static uint8_t cmd_args[2];
+static uint8_t cmd_faltam;
+static uint8_t cmd_lidos;
+
+void painel_host_reinicia(void) {
+    memset(&painel_host, 0, sizeof(painel_host));
+    painel_host.x1 = PAINEL_HOST_LARGURA - 1;
+    painel_host.p1 = PAINEL_HOST_PAGINAS - 1;
+    cmd_faltam = 0;
+}
+
+void painel_host_zera_contadores(void) {
+    painel_host.transacoes = 0;
+    painel_host.bytes_dados = 0;
+    painel_host.comandos = 0;
+}
+
+static uint8_t argumentos(uint8_t c) {
+    switch (c) {
+        case 0x21: case 0x22:
+            return 2;
+        case 0x20: case 0x81: case 0x8D: case 0xA8: case 0xD3:
+        case 0xD5: case 0xD9: case 0xDA: case 0xDB:
+            return 1;
+        default:
+            return 0;
+    }
+}
+
+static void executa(void) {
+    painel_host_t *p = &painel_host;
+    switch (cmd_atual) {
+        case 0x20:
+            p->modo = cmd_args[0] & 3;
+            break;
+        case 0x21:
+            p->x0 = p->x = cmd_args[0] & 0x7F;
+            p->x1 = cmd_args[1] & 0x7F;
+            break;
+        case 0x22:
+            p->p0 = p->p = cmd_args[0] & 7;
+            p->p1 = cmd_args[1] & 7;
+            break;
+    }
+}
+
+static void comando(uint8_t c) {
+    painel_host.comandos++;
+    if (cmd_faltam) {
+        cmd_args[cmd_lidos++] = c;
+        if (--cmd_faltam == 0) {
+            executa();
+        }
+        return;
+    }
+    cmd_atual = c;
+    cmd_lidos = 0;
+    cmd_faltam = argumentos(c);
+}
+
+// Grava um byte e avança como o controlador, voltando ao início da janela
+static void dado(uint8_t b) {
+    painel_host_t *p = &painel_host;
+    p->gddram[p->x][p->p] = b;
+    p->bytes_dados++;
+    if (p->modo == 1) {
+        if (p->p++ == p->p1) {
+            p->p = p->p0;
+            p->x = p->x == p->x1 ? p->x0 : p->x + 1;
+        }
+    } else {
+        if (p->x++ == p->x1) {
+            p->x = p->x0;
+            p->p = p->p == p->p1 ? p->p0 : p->p + 1;
+        }
+    }
+}
+
+int i2c_write_blocking(i2c_inst_t *i2c, uint8_t endereco, const uint8_t *src, size_t len, bool nostop) {
+    (void)i2c;
+    (void)endereco;
+    (void)nostop;
+    painel_host.transacoes++;
+    if (len >= 2 && src[0] == 0x80) {
+        comando(src[1]);
+    } else if (len >= 1 && src[0] == 0x40) {
+        for (size_t i = 1; i < len; i++) {
+            dado(src[i]);
+        }
+    }
+    return (int)len;
+}
+
+bool painel_host_igual(const uint8_t *dados, uint8_t largura, uint8_t paginas) {
+    for (uint8_t x = 0; x < largura; x++) {
+        if (memcmp(painel_host.gddram[x], dados + (size_t)x * paginas, paginas) != 0) {
+            return false;
+        }
+    }
+    return true;
+}
+
+bool painel_host_pbm(const char *arquivo, uint8_t largura, uint8_t altura) {
+    FILE *f = fopen(arquivo, "wb");
+    if (!f) {
+        return false;
+    }
+    fprintf(f, "P4\n%u %u\n", largura, altura);
+    for (uint8_t y = 0; y < altura; y++) {
+        uint8_t byte = 0;
+        for (uint8_t x = 0; x < largura; x++) {
+            // Bit 1 no PBM é preto: pixel aceso sai branco, como no display
+            byte = (uint8_t)(byte << 1) | (~painel_host.gddram[x][y >> 3] >> (y & 7) & 1);
+            if ((x & 7) == 7) {
+                fputc(byte, f);
+                byte = 0;
+            }
+        }
+        if (largura & 7) {
+            fputc(byte << (8 - (largura & 7)), f);
+        }
+    }
+    return fclose(f) == 0;
+}
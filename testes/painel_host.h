@@ -0,0 +1,35 @@
+#ifndef PAINEL_HOST_H
+#define PAINEL_HOST_H
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+// SSD1306 emulado atrás de i2c_write_blocking: interpreta os comandos de
+// janela e modo e grava os dados na GDDRAM como o controlador, para que o
+// teste confira o que o display mostraria, e não só o framebuffer.
+
+#define PAINEL_HOST_LARGURA 128
+#define PAINEL_HOST_PAGINAS 8
+
+typedef struct {
+    uint8_t gddram[PAINEL_HOST_LARGURA][PAINEL_HOST_PAGINAS];
+    uint8_t modo;               // 0 horizontal, 1 vertical
+    uint8_t x0, x1, p0, p1;     // Janela ativa
+    uint8_t x, p;               // Próxima posição de escrita
+    uint32_t transacoes;        // Escritas no barramento
+    uint32_t bytes_dados;       // Bytes de dados (sem o byte de controle)
+    uint32_t comandos;
+} painel_host_t;
+
+extern painel_host_t painel_host;
+
+void painel_host_reinicia(void);
+// Zera só os contadores, para medir um quadro
+void painel_host_zera_contadores(void);
+// Compara a GDDRAM com um framebuffer em modo vertical (sem o byte 0x40)
+bool painel_host_igual(const uint8_t *dados, uint8_t largura, uint8_t paginas);
+// Grava a GDDRAM como PBM binário (P4), aceso = branco; false se falhar
+bool painel_host_pbm(const char *arquivo, uint8_t largura, uint8_t altura);
+
+#endif // PAINEL_HOST_H
@@ -0,0 +1,13 @@
+#ifndef HARDWARE_CLOCKS_H
+#define HARDWARE_CLOCKS_H
+
+#include "pico/stdlib.h"
+
+enum clock_index { clk_sys = 5 };
+
+static inline uint32_t clock_get_hz(enum clock_index clk) {
+    (void)clk;
+    return 125000000;
+}
+
+#endif // HARDWARE_CLOCKS_H
@@ -0,0 +1,20 @@
+#ifndef HARDWARE_I2C_H
+#define HARDWARE_I2C_H
+
+#include "pico/stdlib.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// Implementado por testes/painel_host.c, que emula o SSD1306 no barramento
+typedef struct i2c_inst i2c_inst_t;
+extern i2c_inst_t *i2c1;
+
+int i2c_write_blocking(i2c_inst_t *i2c, uint8_t endereco, const uint8_t *src, size_t len, bool nostop);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // HARDWARE_I2C_H
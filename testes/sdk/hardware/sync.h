@@ -0,0 +1,15 @@
+#ifndef HARDWARE_SYNC_H
+#define HARDWARE_SYNC_H
+
+#include "pico/stdlib.h"
+
+// No host não há interrupções: as seções críticas não fazem nada
+static inline uint32_t save_and_disable_interrupts(void) {
+    return 0;
+}
+
+static inline void restore_interrupts(uint32_t estado) {
+    (void)estado;
+}
+
+#endif // HARDWARE_SYNC_H
@@ -0,0 +1,20 @@
+#ifndef LWIP_ERR_H
+#define LWIP_ERR_H
+
+#include <stdint.h>
+
+// Códigos do lwIP usados pelo firmware (mesmos valores de lwip/err.h)
+typedef int8_t err_t;
+
+#define ERR_OK    0
+#define ERR_MEM  -1
+#define ERR_BUF  -2
+#define ERR_VAL  -6
+#define ERR_USE  -8
+#define ERR_CONN -11
+#define ERR_ABRT -13
+#define ERR_RST  -14
+#define ERR_CLSD -15
+#define ERR_ARG  -16
+
+#endif // LWIP_ERR_H
@@ -0,0 +1,12 @@
+#ifndef LWIP_MEMP_H
+#define LWIP_MEMP_H
+
+// Pools acompanhados pelo lwIP simulado
+typedef enum {
+    MEMP_TCP_PCB,
+    MEMP_TCP_SEG,
+    MEMP_PBUF_POOL,
+    MEMP_MAX
+} memp_t;
+
+#endif // LWIP_MEMP_H
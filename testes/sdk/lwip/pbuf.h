@@ -0,0 +1,28 @@
+#ifndef LWIP_PBUF_H
+#define LWIP_PBUF_H
+
+#include <stdint.h>
+
+#include "lwip/err.h"
+
+typedef uint8_t u8_t;
+typedef uint16_t u16_t;
+typedef uint32_t u32_t;
+
+// pbuf do lwIP simulado (testes/lwip_host.c); só os campos públicos do original
+struct pbuf {
+    struct pbuf *next;
+    void *payload;
+    u16_t tot_len;
+    u16_t len;
+    u8_t ref;
+    u8_t do_pool;  // Conta no PBUF_POOL das estatísticas
+};
+
+u8_t pbuf_free(struct pbuf *p);
+void pbuf_ref(struct pbuf *p);
+void pbuf_cat(struct pbuf *head, struct pbuf *tail);
+u16_t pbuf_copy_partial(const struct pbuf *p, void *dataptr, u16_t len, u16_t offset);
+struct pbuf *pbuf_free_header(struct pbuf *q, u16_t size);
+
+#endif // LWIP_PBUF_H
@@ -0,0 +1,31 @@
+#ifndef LWIP_STATS_H
+#define LWIP_STATS_H
+
+#include <stdint.h>
+
+#include "lwip/memp.h"
+
+// Os contadores do lwIP simulado seguem a forma de lwip/stats.h para que o
+// mesmo código de /metricas os leia
+#undef LWIP_STATS
+#undef MEM_STATS
+#undef MEMP_STATS
+#define LWIP_STATS 1
+#define MEM_STATS  1
+#define MEMP_STATS 1
+
+struct stats_mem {
+    uint32_t avail;
+    uint32_t used;
+    uint32_t max;
+    uint32_t err;
+};
+
+struct stats_ {
+    struct stats_mem mem;
+    struct stats_mem *memp[MEMP_MAX];
+};
+
+extern struct stats_ lwip_stats;
+
+#endif // LWIP_STATS_H
@@ -0,0 +1,84 @@
+#ifndef LWIP_TCP_H
+#define LWIP_TCP_H
+
+// API raw de TCP do lwIP, implementada por testes/lwip_host.c sobre filas em
+// memória. Os limites (TCP_MSS, TCP_SND_BUF, MEM_SIZE, MEMP_NUM_TCP_SEG...)
+// vêm do lwipopts.h do firmware, para que a simulação esgote os mesmos pools.
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#include "lwipopts.h"
+#include "lwip/err.h"
+#include "lwip/pbuf.h"
+
+#ifndef MEMP_NUM_TCP_PCB
+#define MEMP_NUM_TCP_PCB 5  // Padrão de lwip/opt.h
+#endif
+
+#define IP_ADDR_ANY NULL
+
+#define TCP_WRITE_FLAG_COPY 0x01
+#define TCP_WRITE_FLAG_MORE 0x02
+
+struct tcp_pcb;
+struct lwip_host_seg;
+
+typedef err_t (*tcp_accept_fn)(void *arg, struct tcp_pcb *newpcb, err_t err);
+typedef err_t (*tcp_recv_fn)(void *arg, struct tcp_pcb *tpcb, struct pbuf *p, err_t err);
+typedef err_t (*tcp_sent_fn)(void *arg, struct tcp_pcb *tpcb, u16_t len);
+typedef err_t (*tcp_poll_fn)(void *arg, struct tcp_pcb *tpcb);
+typedef void (*tcp_err_fn)(void *arg, err_t err);
+
+struct tcp_pcb {
+    void *callback_arg;
+    tcp_accept_fn accept;
+    tcp_recv_fn recv;
+    tcp_sent_fn sent;
+    tcp_poll_fn poll;
+    tcp_err_fn errf;
+    u8_t pollinterval;
+    u8_t poll_ticks;
+
+    u16_t porta;
+    bool escutando;
+    bool fechado;       // tcp_close chamado: envia o que falta e encerra
+    bool encerrado;     // Tudo confirmado após o fechamento, ou abortado
+    bool fin_remoto;    // Cliente fechou a escrita
+    bool fin_entregue;  // recv já recebeu o p == NULL
+
+    // Envio: segmentos na ordem; os primeiros `em_voo` bytes já saíram
+    struct lwip_host_seg *fila;
+    uint32_t na_fila;
+    uint32_t em_voo;
+    u16_t snd_queuelen;
+
+    // Recepção
+    uint32_t janela;        // Quanto o cliente ainda pode enviar
+    struct pbuf *recusado;  // Dados que o recv devolveu sem consumir
+    uint8_t *entrada;       // Enviado pelo cliente e ainda não entregue
+    size_t entrada_len;
+
+    struct tcp_pcb *proximo;  // Lista de todos os pcbs
+    void *usuario;            // Livre para o driver do teste
+};
+
+struct tcp_pcb *tcp_new(void);
+err_t tcp_bind(struct tcp_pcb *pcb, const void *ip, u16_t porta);
+struct tcp_pcb *tcp_listen(struct tcp_pcb *pcb);
+void tcp_accept(struct tcp_pcb *pcb, tcp_accept_fn accept);
+void tcp_arg(struct tcp_pcb *pcb, void *arg);
+void tcp_recv(struct tcp_pcb *pcb, tcp_recv_fn recv);
+void tcp_sent(struct tcp_pcb *pcb, tcp_sent_fn sent);
+void tcp_err(struct tcp_pcb *pcb, tcp_err_fn err);
+void tcp_poll(struct tcp_pcb *pcb, tcp_poll_fn poll, u8_t interval);
+err_t tcp_write(struct tcp_pcb *pcb, const void *dados, u16_t len, u8_t flags);
+err_t tcp_output(struct tcp_pcb *pcb);
+void tcp_recved(struct tcp_pcb *pcb, u16_t len);
+err_t tcp_close(struct tcp_pcb *pcb);
+void tcp_abort(struct tcp_pcb *pcb);
+
+#define tcp_sndbuf(pcb) ((u16_t)((pcb)->na_fila >= TCP_SND_BUF ? 0 : TCP_SND_BUF - (pcb)->na_fila))
+
+#endif // LWIP_TCP_H
@@ -0,0 +1,10 @@
+#ifndef PICO_CYW43_ARCH_H
+#define PICO_CYW43_ARCH_H
+
+#include "pico/stdlib.h"
+
+// No host o lwIP simulado roda na mesma thread: a trava não faz nada
+static inline void cyw43_arch_lwip_begin(void) {}
+static inline void cyw43_arch_lwip_end(void) {}
+
+#endif // PICO_CYW43_ARCH_H
@@ -0,0 +1,36 @@
+#ifndef PICO_STDLIB_H
+#define PICO_STDLIB_H
+
+// Substituto mínimo do SDK para compilar os módulos sem hardware no host
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+typedef unsigned int uint;
+typedef uint64_t absolute_time_t;
+
+#define count_of(a) (sizeof(a) / sizeof((a)[0]))
+
+static inline uint get_core_num(void) {
+    return 0;
+}
+
+// Relógio do host (testes/sdk_host.c): monotônico desde o início do processo,
+// mais o que o teste avançar com sdk_host_avanca_us
+uint64_t time_us_64(void);
+void sdk_host_avanca_us(uint64_t us);
+
+static inline uint32_t time_us_32(void) {
+    return (uint32_t)time_us_64();
+}
+
+static inline absolute_time_t get_absolute_time(void) {
+    return time_us_64();
+}
+
+static inline uint32_t to_ms_since_boot(absolute_time_t t) {
+    return (uint32_t)(t / 1000);
+}
+
+#endif // PICO_STDLIB_H
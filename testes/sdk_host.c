@@ -0,0 +1,20 @@
+#include <time.h>
+
+#include "pico/stdlib.h"
+
+static uint64_t avanco_us = 0;
+
+uint64_t time_us_64(void) {
+    static uint64_t inicio_us = 0;
+    struct timespec t;
+    clock_gettime(CLOCK_MONOTONIC, &t);
+    uint64_t agora = (uint64_t)t.tv_sec * 1000000u + (uint64_t)t.tv_nsec / 1000u;
+    if (!inicio_us) {
+        inicio_us = agora;
+    }
+    return agora - inicio_us + avanco_us;
+}
+
+void sdk_host_avanca_us(uint64_t us) {
+    avanco_us += us;
+}
@@ -0,0 +1,100 @@
+#include <string.h>
+
+#include "energia.h"
+#include "ota.h"
+#include "servidor_host.h"
+#include "webserver.h"
+#include "wifi.h"
+
+// ===== Globais de main.c =====
+
+volatile float lim_min = 20.0f;
+volatile float lim_max = 80.0f;
+volatile float nivel_percentual = 0;
+volatile bool bomba_ligada = false;
+volatile bool silenciar_alarme = false;
+volatile uint32_t t_primeira_decisao_ms = 0;
+volatile float lim_min_efetivo = 20.0f;
+agenda_t agenda;
+
+bool atualiza_limites(float min, float max) {
+    if (!(min >= 0.0f && max <= 100.0f && min < max)) {
+        return false;
+    }
+    lim_min = min;
+    lim_max = max;
+    return true;
+}
+
+// ===== Módulos presos ao hardware =====
+
+static const wifi_metricas_t wifi_zerado;
+static const energia_metricas_t energia_zerado;
+
+const wifi_metricas_t *wifi_metricas(void) {
+    return &wifi_zerado;
+}
+
+const char *wifi_estado_str(void) {
+    return "conectado";
+}
+
+const energia_metricas_t *energia_metricas(void) {
+    return &energia_zerado;
+}
+
+void energia_acorda(void) {
+}
+
+uint32_t energia_ciclo_trabalho_pm(void) {
+    return 1000;
+}
+
+flash_arquivo_t servidor_host_flash;
+
+const ota_flash_t ota_flash_pico = {
+    .ctx = &servidor_host_flash,
+    .apaga = flash_arquivo_apaga,
+    .programa = flash_arquivo_programa,
+    .le = flash_arquivo_le,
+};
+
+void ota_regiao_staging(uint32_t *base, uint32_t *capacidade) {
+    *base = SERVIDOR_HOST_FLASH_TAM / 2;
+    *capacidade = SERVIDOR_HOST_FLASH_TAM / 2;
+}
+
+const char *ota_estado_boot_str(void) {
+    return "normal";
+}
+
+// ===== Cliente =====
+
+void servidor_host_inicia(void) {
+    flash_arquivo_abre(&servidor_host_flash, NULL, SERVIDOR_HOST_FLASH_TAM);
+    lwip_host_reinicia();
+    webserver_init();
+}
+
+int servidor_host_requisicao(uint16_t porta, const char *req, bool fin, char *resp, size_t max) {
+    struct tcp_pcb *pcb = lwip_host_conecta(porta);
+    if (!pcb) {
+        return -1;
+    }
+    lwip_host_envia(pcb, req, strlen(req));
+    if (fin) {
+        lwip_host_fin(pcb);
+    }
+    size_t n = 0;
+    while (!lwip_host_encerrado(pcb)) {
+        size_t lidos = lwip_host_recebe(pcb, resp + n, max - 1 - n);
+        if (lidos == 0) {
+            break;  // Nada a transmitir e o servidor não fechou
+        }
+        n += lidos;
+        lwip_host_confirma(pcb, lidos);
+    }
+    resp[n] = '\0';
+    lwip_host_libera(pcb);
+    return (int)n;
+}
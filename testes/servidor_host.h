@@ -0,0 +1,38 @@
+#ifndef SERVIDOR_HOST_H
+#define SERVIDOR_HOST_H
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#include "agenda.h"
+#include "flash_arquivo.h"
+#include "lwip_host.h"
+
+// lib/webserver.c real sobre o lwIP simulado: este módulo define o que o
+// servidor importa de main.c (limites, nível, bomba, agenda) e substitui os
+// módulos presos ao hardware (wifi, energia, flash interna).
+
+extern volatile float lim_min;
+extern volatile float lim_max;
+extern volatile float nivel_percentual;
+extern volatile bool bomba_ligada;
+extern volatile bool silenciar_alarme;
+extern volatile float lim_min_efetivo;
+extern agenda_t agenda;
+
+// Flash simulada num arquivo temporário; a metade superior é o staging do /update
+#define SERVIDOR_HOST_FLASH_TAM (2u * 1024 * 1024)
+extern flash_arquivo_t servidor_host_flash;
+
+// Reinicia o lwIP simulado e sobe o servidor na porta 80 (uma vez por processo)
+void servidor_host_inicia(void);
+
+/**
+ * Requisição completa: conecta na porta, envia `req`, fecha a escrita se
+ * `fin` e lê a resposta confirmando tudo até o servidor fechar. Retorna os
+ * bytes lidos (terminados em zero em `resp`) ou -1 se a conexão foi recusada.
+ */
+int servidor_host_requisicao(uint16_t porta, const char *req, bool fin, char *resp, size_t max);
+
+#endif // SERVIDOR_HOST_H
@@ -0,0 +1,215 @@
+/**
+ * Servidor HTTP do firmware exposto em 127.0.0.1 para o tools/carga_http.py:
+ * cada conexão do sistema vira um pcb do lwIP simulado, os bytes lidos do
+ * socket são entregues ao recv e o que o servidor transmite vai para o
+ * socket. O ACK de cada trecho só chega ao lwIP depois do RTT simulado, de
+ * modo que segmentos e heap ficam ocupados como num enlace Wi-Fi, e uma
+ * conexão sem pcb livre espera como um SYN descartado. Ao sair imprime o
+ * pico dos pools (o mesmo JSON de /metricas).
+ *
+ * Uso: servidor_loopback [porta] [rtt_ms] [duracao_s]
+ */
+#include <arpa/inet.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <netinet/in.h>
+#include <poll.h>
+#include <signal.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+#include "alarme.h"
+#include "bancada.h"
+#include "servidor_host.h"
+#include "webserver.h"
+
+#define MAX_CONEXOES 64
+#define MAX_ACKS 64
+#define AMOSTRA_MS 500  // Período do laço de controle (publicação e timer lento)
+
+typedef struct {
+    int fd;
+    struct tcp_pcb *pcb;  // NULL enquanto espera um pcb livre
+    bool fim_cliente;
+    bool esperou;         // Já contada entre as que esperaram por pcb
+    uint8_t saida[TCP_SND_BUF];  // Transmitido pelo lwIP e ainda não escrito
+    size_t saida_len, saida_pos;
+    struct {
+        uint64_t prazo_us;
+        size_t n;
+    } acks[MAX_ACKS];
+    uint8_t acks_ini, acks_num;
+} conexao_t;
+
+static conexao_t conexoes[MAX_CONEXOES];
+static volatile sig_atomic_t parar = 0;
+static uint32_t recusadas = 0;
+
+static void ao_sinal(int s) {
+    (void)s;
+    parar = 1;
+}
+
+static uint64_t agora_us(void) {
+    return bancada_ns() / 1000;
+}
+
+static void fecha(conexao_t *c, bool reinicia) {
+    if (c->pcb) {
+        if (reinicia) {
+            lwip_host_rst(c->pcb);
+        }
+        lwip_host_libera(c->pcb);
+    }
+    close(c->fd);
+    memset(c, 0, sizeof(*c));
+    c->fd = -1;
+}
+
+static void aceita(int escuta) {
+    int fd;
+    while ((fd = accept(escuta, NULL, NULL)) >= 0) {
+        conexao_t *c = NULL;
+        for (int i = 0; i < MAX_CONEXOES && !c; i++) {
+            if (conexoes[i].fd < 0) {
+                c = &conexoes[i];
+            }
+        }
+        if (!c) {
+            close(fd);
+            continue;
+        }
+        fcntl(fd, F_SETFL, O_NONBLOCK);
+        c->fd = fd;
+    }
+}
+
+// Um passo da conexão; false se ela terminou
+static bool atende(conexao_t *c, uint64_t agora, uint64_t rtt_us) {
+    if (!c->pcb) {
+        c->pcb = lwip_host_conecta(80);
+        if (!c->pcb) {
+            recusadas += !c->esperou;
+            c->esperou = true;
+            return true;  // Como um SYN sem resposta: o cliente espera
+        }
+    }
+
+    uint8_t buf[2048];
+    while (!c->fim_cliente) {
+        ssize_t n = read(c->fd, buf, sizeof(buf));
+        if (n > 0) {
+            lwip_host_envia(c->pcb, buf, (size_t)n);
+        } else if (n == 0) {
+            c->fim_cliente = true;
+            lwip_host_fin(c->pcb);
+        } else if (errno == EAGAIN || errno == EWOULDBLOCK) {
+            break;
+        } else {
+            return false;
+        }
+        if (lwip_host_encerrado(c->pcb)) {
+            break;
+        }
+    }
+
+    // ACKs cujo RTT já passou
+    while (c->acks_num && c->acks[c->acks_ini].prazo_us <= agora) {
+        lwip_host_confirma(c->pcb, c->acks[c->acks_ini].n);
+        c->acks_ini = (c->acks_ini + 1) % MAX_ACKS;
+        c->acks_num--;
+    }
+
+    if (c->saida_pos == c->saida_len && c->acks_num < MAX_ACKS) {
+        c->saida_len = lwip_host_recebe(c->pcb, c->saida, sizeof(c->saida));
+        c->saida_pos = 0;
+    }
+    if (c->saida_pos < c->saida_len) {
+        ssize_t n = write(c->fd, c->saida + c->saida_pos, c->saida_len - c->saida_pos);
+        if (n < 0 && errno != EAGAIN && errno != EWOULDBLOCK) {
+            return false;
+        }
+        if (n > 0) {
+            c->saida_pos += (size_t)n;
+            uint8_t i = (c->acks_ini + c->acks_num) % MAX_ACKS;
+            c->acks[i].prazo_us = agora + rtt_us;
+            c->acks[i].n = (size_t)n;
+            c->acks_num++;
+        }
+    }
+
+    // Fechada pelo servidor e toda confirmada
+    if (lwip_host_encerrado(c->pcb) && c->saida_pos == c->saida_len) {
+        shutdown(c->fd, SHUT_WR);
+        fecha(c, false);
+    }
+    return true;
+}
+
+int main(int argc, char **argv) {
+    int porta = argc > 1 ? atoi(argv[1]) : 8080;
+    uint64_t rtt_us = (argc > 2 ? atoi(argv[2]) : 20) * 1000ull;
+    uint64_t duracao_us = (argc > 3 ? atoi(argv[3]) : 0) * 1000000ull;
+
+    signal(SIGTERM, ao_sinal);
+    signal(SIGINT, ao_sinal);
+    signal(SIGPIPE, SIG_IGN);
+    for (int i = 0; i < MAX_CONEXOES; i++) {
+        conexoes[i].fd = -1;
+    }
+
+    int escuta = socket(AF_INET, SOCK_STREAM, 0);
+    int um = 1;
+    setsockopt(escuta, SOL_SOCKET, SO_REUSEADDR, &um, sizeof(um));
+    struct sockaddr_in end = {.sin_family = AF_INET, .sin_port = htons(porta)};
+    end.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+    if (bind(escuta, (struct sockaddr *)&end, sizeof(end)) < 0 || listen(escuta, 64) < 0) {
+        perror("servidor_loopback");
+        return 1;
+    }
+    fcntl(escuta, F_SETFL, O_NONBLOCK);
+
+    alarme_init();
+    servidor_host_inicia();
+    printf("Escutando em 127.0.0.1:%d, RTT simulado %llu ms\n", porta, (unsigned long long)(rtt_us / 1000));
+    fflush(stdout);
+
+    uint64_t inicio = agora_us(), proxima_amostra = inicio;
+    uint32_t amostra = 0;
+    while (!parar && (!duracao_us || agora_us() - inicio < duracao_us)) {
+        struct pollfd pfd = {.fd = escuta, .events = POLLIN};
+        poll(&pfd, 1, 1);
+        aceita(escuta);
+
+        uint64_t agora = agora_us();
+        if (agora >= proxima_amostra) {
+            // Laço de controle: nível oscilando e publicação a cada amostra
+            nivel_percentual = 40.0f + (float)(amostra++ % 20);
+            webserver_publica_estado();
+            lwip_host_tick();
+            proxima_amostra += AMOSTRA_MS * 1000;
+        }
+        for (int i = 0; i < MAX_CONEXOES; i++) {
+            if (conexoes[i].fd >= 0 && !atende(&conexoes[i], agora, rtt_us)) {
+                fecha(&conexoes[i], true);
+            }
+        }
+    }
+
+    for (int i = 0; i < MAX_CONEXOES; i++) {
+        if (conexoes[i].fd >= 0) {
+            fecha(&conexoes[i], true);
+        }
+    }
+    char resp[4096];
+    servidor_host_requisicao(80, "GET /metricas HTTP/1.1\r\n\r\n", false, resp, sizeof(resp));
+    const char *lwip = strstr(resp, "\"lwip\":");
+    const char *fim = lwip ? strstr(lwip, "}},") : NULL;
+    printf("Conexões que esperaram por pcb: %lu\n", (unsigned long)recusadas);
+    printf("lwIP: %.*s\n", lwip && fim ? (int)(fim + 2 - lwip - 7) : 0, lwip ? lwip + 7 : "");
+    close(escuta);
+    return 0;
+}
@@ -0,0 +1,30 @@
+#ifndef TESTE_H
+#define TESTE_H
+
+// Verificações mínimas para os testes no host: cada falha é reportada com
+// arquivo e linha, e TESTE_FIM() vira o código de saída lido pelo CTest.
+
+#include <stdio.h>
+
+static int teste_falhas = 0;
+
+#define CHECA(cond) do {                                                    \
+        if (!(cond)) {                                                      \
+            fprintf(stderr, "%s:%d: falhou: %s\n", __FILE__, __LINE__, #cond); \
+            teste_falhas++;                                                 \
+        }                                                                   \
+    } while (0)
+
+#define CHECA_IGUAL(obtido, esperado) do {                                  \
+        long long obtido_ = (long long)(obtido);                            \
+        long long esperado_ = (long long)(esperado);                        \
+        if (obtido_ != esperado_) {                                         \
+            fprintf(stderr, "%s:%d: %s = %lld, esperado %lld\n",            \
+                    __FILE__, __LINE__, #obtido, obtido_, esperado_);       \
+            teste_falhas++;                                                 \
+        }                                                                   \
+    } while (0)
+
+#define TESTE_FIM() (teste_falhas ? (fprintf(stderr, "%d falha(s)\n", teste_falhas), 1) : 0)
+
+#endif // TESTE_H
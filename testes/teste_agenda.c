@@ -0,0 +1,101 @@
+/**
+ * Perfil da agenda de tarifas (lib/agenda.c) como vai para a flash: uma
+ * semana de consumo conhecido por hora é aprendida, serializada e restaurada
+ * numa agenda nova com as mesmas previsões; um byte trocado, a flash apagada,
+ * outro fuso ou um perfil truncado são recusados sem tocar na agenda.
+ */
+#include <math.h>
+#include <string.h>
+
+#include "agenda.h"
+#include "teste.h"
+
+// Segunda-feira, 2 de março de 2026, 0h em UTC-3
+#define EPOCA_SEGUNDA 1772420400u
+
+static agenda_t agenda;
+static agenda_t restaurada;
+static uint8_t perfil[AGENDA_PERFIL_TAM];
+
+// Consumo da hora do dia em %/h
+static float taxa(uint32_t hora) {
+    return 1.0f + (float)(hora % 24) / 4.0f;
+}
+
+/**
+ * Oito dias a 60 s: em cada hora a bomba repõe nos 5 primeiros minutos o que
+ * os 55 seguintes consomem, de modo que o nível fica entre 60% e 70%
+ */
+static void aprende_semana(void) {
+    agenda_init(&agenda, agenda_tarifa_branca, agenda_tarifa_branca_num, AGENDA_FUSO_PADRAO_S);
+    float nivel = 60.0f;
+    for (uint32_t min = 0; min < 8 * 24 * 60; min++) {
+        uint32_t hora = min / 60;
+        bool bomba = min % 60 < 5;
+        agenda_amostra(&agenda, EPOCA_SEGUNDA + min * 60, nivel, bomba);
+        nivel += bomba ? taxa(hora) * 55.0f / 60.0f / 5.0f : -taxa(hora) / 60.0f;
+    }
+}
+
+static void teste_aprendizado(void) {
+    aprende_semana();
+    CHECA_IGUAL(agenda_horas_aprendidas(&agenda), AGENDA_SLOTS);
+    // Hora da semana 24 é segunda-feira, 0h
+    for (uint8_t h = 0; h < AGENDA_SLOTS; h++) {
+        float media = (float)agenda.slots[h].media / 256.0f;
+        CHECA(fabsf(media - taxa(h)) < 0.05f);
+    }
+}
+
+static void teste_ida_e_volta(void) {
+    agenda_perfil_serializa(&agenda, perfil);
+    agenda_init(&restaurada, agenda_tarifa_branca, agenda_tarifa_branca_num, AGENDA_FUSO_PADRAO_S);
+    CHECA(agenda_perfil_carrega(&restaurada, perfil, sizeof(perfil)));
+    CHECA(memcmp(restaurada.slots, agenda.slots, sizeof(agenda.slots)) == 0);
+    for (uint8_t h = 0; h < AGENDA_SLOTS; h++) {
+        CHECA(agenda_previsao(&restaurada, h) == agenda_previsao(&agenda, h));
+    }
+
+    // A reserva sai das previsões restauradas já na primeira amostra: sexta,
+    // 15h, dentro das horas baratas finais antes da ponta
+    uint32_t sexta_15h = EPOCA_SEGUNDA + (4 * 24 + 15) * 3600;
+    agenda_amostra(&restaurada, sexta_15h, 50.0f, false);
+    agenda_amostra(&agenda, sexta_15h, 50.0f, false);
+    CHECA(agenda_reserva(&restaurada) > 0.0f);
+    CHECA(agenda_reserva(&restaurada) == agenda_reserva(&agenda));
+}
+
+// Perfil inválido: carrega falha e a agenda continua sem nada aprendido
+static void confere_recusa(const uint8_t *dados, uint32_t len, int32_t fuso_s) {
+    agenda_init(&restaurada, agenda_tarifa_branca, agenda_tarifa_branca_num, fuso_s);
+    CHECA(!agenda_perfil_carrega(&restaurada, dados, len));
+    CHECA_IGUAL(agenda_horas_aprendidas(&restaurada), 0);
+}
+
+static void teste_recusas(void) {
+    static uint8_t apagada[4096];
+    memset(apagada, 0xFF, sizeof(apagada));
+    confere_recusa(apagada, sizeof(apagada), AGENDA_FUSO_PADRAO_S);
+
+    // Um byte trocado no cabeçalho, num slot ou no próprio CRC
+    static const uint32_t posicoes[] = {0, 5, 12, 12 + 5 * 100 + 4, AGENDA_PERFIL_TAM - 1};
+    for (size_t i = 0; i < sizeof(posicoes) / sizeof(posicoes[0]); i++) {
+        perfil[posicoes[i]] ^= 0x10;
+        confere_recusa(perfil, sizeof(perfil), AGENDA_FUSO_PADRAO_S);
+        perfil[posicoes[i]] ^= 0x10;
+    }
+
+    // Horas da semana deslocadas por outro fuso e perfil truncado
+    confere_recusa(perfil, sizeof(perfil), -2 * 3600);
+    confere_recusa(perfil, sizeof(perfil) - 1, AGENDA_FUSO_PADRAO_S);
+
+    agenda_init(&restaurada, agenda_tarifa_branca, agenda_tarifa_branca_num, AGENDA_FUSO_PADRAO_S);
+    CHECA(agenda_perfil_carrega(&restaurada, perfil, sizeof(perfil)));
+}
+
+int main(void) {
+    teste_aprendizado();
+    teste_ida_e_volta();
+    teste_recusas();
+    return TESTE_FIM();
+}
@@ -0,0 +1,103 @@
+/**
+ * Sequenciador do alarme (lib/alarme.c) com relógio virtual: o tempo é só o
+ * argumento de alarme_tick, então o ritmo é conferido ao milissegundo sem
+ * timer nem buzzer.
+ */
+#include "alarme.h"
+#include "teste.h"
+
+static const alarme_passo_t BIPE_CURTO[] = {{440, 10}, {0, 30}};
+
+static void padrao_nivel_baixo(void) {
+    alarme_init();
+    CHECA_IGUAL(alarme_tick(0), 0);
+    CHECA(!alarme_soando());
+
+    // 1000 Hz por 250 ms, silêncio por 750 ms, contados a partir da ativação
+    alarme_ativa(ALARME_NIVEL_BAIXO, true);
+    CHECA_IGUAL(alarme_tick(1000), 1000);
+    CHECA_IGUAL(alarme_tick(1249), 1000);
+    CHECA_IGUAL(alarme_tick(1250), 0);
+    CHECA_IGUAL(alarme_tick(1999), 0);
+    CHECA_IGUAL(alarme_tick(2000), 1000);
+    CHECA_IGUAL(alarme_disparos(ALARME_NIVEL_BAIXO), 1);
+}
+
+static void atraso_nao_desloca_o_ritmo(void) {
+    alarme_init();
+    alarme_ativa(ALARME_NIVEL_ALTO, true);
+    CHECA_IGUAL(alarme_tick(0), 2000);
+    // Um tick atrasado em vários ciclos (2 s cada) cai no passo certo
+    CHECA_IGUAL(alarme_tick(10 * 2000 + 260), 0);
+    CHECA_IGUAL(alarme_tick(10 * 2000 + 500), 2000);
+    CHECA_IGUAL(alarme_tick(10 * 2000 + 750), 0);
+    CHECA_IGUAL(alarme_tick(11 * 2000), 2000);
+}
+
+static void prioridade_e_reconhecimento(void) {
+    alarme_init();
+    alarme_ativa(ALARME_NIVEL_BAIXO, true);
+    CHECA_IGUAL(alarme_tick(0), 1000);
+
+    // Classe de maior prioridade assume e começa do primeiro passo
+    alarme_ativa(ALARME_BOMBA_SECO, true);
+    CHECA_IGUAL(alarme_tick(100), 3000);
+    CHECA_IGUAL(alarme_tick(250), 2000);
+    CHECA_IGUAL(alarme_classe_atual(), ALARME_BOMBA_SECO);
+
+    // Reconhecer silencia tudo o que está ativo, sem esquecer a classe
+    alarme_reconhece();
+    CHECA(!alarme_soando());
+    CHECA_IGUAL(alarme_tick(300), 0);
+    CHECA_IGUAL(alarme_classe_atual(), ALARME_BOMBA_SECO);
+
+    // Reativar uma classe já ativa não desfaz o reconhecimento
+    alarme_ativa(ALARME_BOMBA_SECO, true);
+    CHECA_IGUAL(alarme_tick(400), 0);
+    CHECA_IGUAL(alarme_disparos(ALARME_BOMBA_SECO), 1);
+
+    // Limpar e disparar de novo volta a soar
+    alarme_ativa(ALARME_BOMBA_SECO, false);
+    alarme_ativa(ALARME_BOMBA_SECO, true);
+    CHECA(alarme_soando());
+    CHECA_IGUAL(alarme_tick(500), 3000);
+    CHECA_IGUAL(alarme_disparos(ALARME_BOMBA_SECO), 2);
+
+    // Nível baixo segue reconhecido enquanto não for limpo
+    alarme_ativa(ALARME_BOMBA_SECO, false);
+    CHECA_IGUAL(alarme_tick(600), 0);
+    CHECA_IGUAL(alarme_classe_atual(), ALARME_NIVEL_BAIXO);
+}
+
+static void padrao_configurado(void) {
+    alarme_init();
+    alarme_define_padrao(ALARME_NIVEL_BAIXO, BIPE_CURTO, 2, 9);
+    alarme_ativa(ALARME_NIVEL_BAIXO, true);
+    alarme_ativa(ALARME_FALHA_SENSOR, true);
+    // Prioridade 9 supera a da falha de sensor (3)
+    CHECA_IGUAL(alarme_tick(0), 440);
+    CHECA_IGUAL(alarme_tick(10), 0);
+    CHECA_IGUAL(alarme_tick(40), 440);
+
+    // Classe sem passos nunca é escolhida para tocar
+    alarme_define_padrao(ALARME_NIVEL_BAIXO, BIPE_CURTO, 0, 9);
+    CHECA_IGUAL(alarme_tick(50), 1500);
+}
+
+static void relogio_da_volta(void) {
+    alarme_init();
+    alarme_ativa(ALARME_NIVEL_BAIXO, true);
+    uint32_t t0 = UINT32_MAX - 100;
+    CHECA_IGUAL(alarme_tick(t0), 1000);
+    CHECA_IGUAL(alarme_tick(t0 + 250), 0);   // Passa por zero no meio do passo
+    CHECA_IGUAL(alarme_tick(t0 + 1000), 1000);
+}
+
+int main(void) {
+    padrao_nivel_baixo();
+    atraso_nao_desloca_o_ritmo();
+    prioridade_e_reconhecimento();
+    padrao_configurado();
+    relogio_da_volta();
+    return TESTE_FIM();
+}
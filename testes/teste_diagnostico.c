@@ -0,0 +1,205 @@
+/**
+ * Injeção de falhas no diagnóstico (lib/diagnostico.c): um tanque simulado
+ * gera leituras a cada 500 ms, como o laço principal, e cada classe de falha
+ * é injetada num instante conhecido. O teste confere a latência de detecção
+ * contra a configuração padrão e imprime os tempos medidos.
+ */
+#include "controle.h"
+#include "diagnostico.h"
+#include "teste.h"
+
+#define PERIODO_MS 500
+
+typedef struct {
+    uint32_t t_ms;
+    float nivel;
+    bool bomba;
+    uint32_t falhas;
+} simulacao_t;
+
+// Leitura do ADC que corresponde ao nível, com ±1 LSB de ruído alternado
+static uint16_t adc_do_nivel(float nivel, uint32_t t_ms) {
+    float adc = CONTROLE_ADC_VAZIO + (CONTROLE_ADC_CHEIO - CONTROLE_ADC_VAZIO) * nivel / 100.0f;
+    return (uint16_t)(adc + 0.5f) + ((t_ms / PERIODO_MS) & 1);
+}
+
+static void inicia(simulacao_t *s, float nivel) {
+    diagnostico_init(NULL);
+    *s = (simulacao_t){.t_ms = 1000, .nivel = nivel};
+}
+
+static uint32_t passo(simulacao_t *s, uint16_t adc) {
+    s->falhas = diagnostico_avalia(s->t_ms, adc, controle_nivel_percentual(adc), s->bomba);
+    s->t_ms += PERIODO_MS;
+    return s->falhas;
+}
+
+// Avança até a falha aparecer (ou o limite); retorna a latência desde t_injecao
+static uint32_t ate_detectar(simulacao_t *s, uint32_t falha, uint32_t t_injecao, uint32_t limite_ms,
+                             uint16_t (*leitura)(simulacao_t *)) {
+    while (s->t_ms - t_injecao <= limite_ms) {
+        uint32_t t = s->t_ms;
+        if (passo(s, leitura(s)) & falha) {
+            return t - t_injecao;
+        }
+    }
+    return UINT32_MAX;
+}
+
+static uint16_t leitura_normal(simulacao_t *s) {
+    return adc_do_nivel(s->nivel, s->t_ms);
+}
+
+static uint16_t leitura_desconectado(simulacao_t *s) {
+    (void)s;
+    return 4095;  // Entrada flutuando no topo da escala
+}
+
+static uint16_t leitura_travada(simulacao_t *s) {
+    (void)s;
+    return 2400;
+}
+
+// Travado (ou em curto) com o mesmo ruído de ±1 LSB de uma entrada viva
+static uint16_t leitura_travada_ruidosa(simulacao_t *s) {
+    return (uint16_t)(2400 + (s->t_ms / PERIODO_MS) % 3 - 1);
+}
+
+static uint32_t t_salto;
+static uint16_t leitura_salto(simulacao_t *s) {
+    // Salto de 40% entre duas amostras, depois estável no novo valor
+    return adc_do_nivel(s->t_ms >= t_salto ? s->nivel + 40.0f : s->nivel, s->t_ms);
+}
+
+static void sem_falso_positivo(void) {
+    simulacao_t s;
+    inicia(&s, 30.0f);
+    // Uma hora enchendo e esvaziando devagar, com a bomba acompanhando
+    for (int i = 0; i < 7200; i++) {
+        s.bomba = (i / 600) % 2 == 0;
+        s.nivel += s.bomba ? 0.02f : -0.01f;
+        CHECA_IGUAL(passo(&s, leitura_normal(&s)), 0);
+    }
+    // Duas horas de madrugada a 1%/h: a leitura fica dezenas de minutos na
+    // faixa de ruído, mas sai dela antes de janela_ruido_ms
+    s.bomba = false;
+    for (int i = 0; i < 14400; i++) {
+        s.nivel -= 1.0f / 7200.0f;
+        CHECA_IGUAL(passo(&s, leitura_normal(&s)), 0);
+    }
+    CHECA_IGUAL(diagnostico_metricas()->deteccoes, 0);
+}
+
+static void fora_da_faixa(void) {
+    simulacao_t s;
+    inicia(&s, 50.0f);
+    for (int i = 0; i < 10; i++) {
+        passo(&s, leitura_normal(&s));
+    }
+    uint32_t t0 = s.t_ms;
+    uint32_t latencia = ate_detectar(&s, DIAG_FORA_FAIXA, t0, 10 * PERIODO_MS, leitura_desconectado);
+    printf("fora da faixa: %lu ms\n", (unsigned long)latencia);
+    CHECA_IGUAL(latencia, 0);  // Na primeira leitura
+    CHECA_IGUAL(diagnostico_metricas()->t_fora_faixa_ms, t0);
+    CHECA(diagnostico_estado_seguro());
+
+    // Religado, a falha some na primeira leitura plausível
+    passo(&s, leitura_normal(&s));
+    CHECA(!(s.falhas & DIAG_FORA_FAIXA));
+}
+
+static void estagnado(void) {
+    simulacao_t s;
+    inicia(&s, 50.0f);
+    passo(&s, leitura_normal(&s));
+    uint32_t t0 = s.t_ms;
+    uint32_t latencia = ate_detectar(&s, DIAG_ESTAGNADO, t0, 400000, leitura_travada);
+    printf("estagnado: %lu ms\n", (unsigned long)latencia);
+    CHECA_IGUAL(latencia, 300000);  // janela_estagnado_ms a partir da última mudança
+    CHECA(!(s.falhas & (DIAG_FORA_FAIXA | DIAG_TAXA)));
+
+    passo(&s, leitura_normal(&s));
+    CHECA(!(s.falhas & DIAG_ESTAGNADO));
+}
+
+static void estagnado_com_ruido(void) {
+    simulacao_t s;
+    inicia(&s, 50.0f);
+    passo(&s, leitura_normal(&s));
+    uint32_t t0 = s.t_ms;
+    uint32_t latencia = ate_detectar(&s, DIAG_ESTAGNADO, t0, 4000000, leitura_travada_ruidosa);
+    printf("estagnado com ruído: %lu ms\n", (unsigned long)latencia);
+    CHECA_IGUAL(latencia, 3600000);  // janela_ruido_ms a partir da última saída da faixa
+    CHECA(!(s.falhas & (DIAG_FORA_FAIXA | DIAG_TAXA)));
+
+    passo(&s, leitura_normal(&s));
+    CHECA(!(s.falhas & DIAG_ESTAGNADO));
+}
+
+static void taxa_implausivel(void) {
+    simulacao_t s;
+    inicia(&s, 30.0f);
+    for (int i = 0; i < 10; i++) {
+        passo(&s, leitura_normal(&s));
+    }
+    t_salto = s.t_ms;
+    uint32_t latencia = ate_detectar(&s, DIAG_TAXA, t_salto, 10 * PERIODO_MS, leitura_salto);
+    printf("taxa: %lu ms\n", (unsigned long)latencia);
+    CHECA_IGUAL(latencia, 0);
+
+    // Retida por retencao_taxa_ms depois do salto e liberada em seguida
+    uint32_t t_liberada = 0;
+    for (int i = 0; i < 40 && !t_liberada; i++) {
+        uint32_t t = s.t_ms;
+        if (!(passo(&s, leitura_salto(&s)) & DIAG_TAXA)) {
+            t_liberada = t;
+        }
+    }
+    CHECA_IGUAL(t_liberada - t_salto, 5000);
+}
+
+static void bomba_a_seco(void) {
+    simulacao_t s;
+    inicia(&s, 40.0f);
+    for (int i = 0; i < 10; i++) {
+        passo(&s, leitura_normal(&s));
+    }
+    // Bomba ligada e o nível não sobe: só o ruído do sensor
+    s.bomba = true;
+    uint32_t t0 = s.t_ms;
+    uint32_t latencia = ate_detectar(&s, DIAG_BOMBA_SECO, t0, 120000, leitura_normal);
+    printf("bomba a seco: %lu ms\n", (unsigned long)latencia);
+    CHECA_IGUAL(latencia, 60000);  // janela_seco_ms
+    CHECA_IGUAL(diagnostico_metricas()->t_bomba_seco_ms, t0 + 60000);
+
+    // Travada mesmo com a bomba desligada, até o rearme do operador
+    s.bomba = false;
+    passo(&s, leitura_normal(&s));
+    CHECA(s.falhas & DIAG_BOMBA_SECO);
+    diagnostico_rearma();
+    passo(&s, leitura_normal(&s));
+    CHECA_IGUAL(s.falhas, 0);
+}
+
+static void bomba_enchendo(void) {
+    simulacao_t s;
+    inicia(&s, 40.0f);
+    s.bomba = true;
+    // 0.05 %/s: 3% por janela de 60 s, acima da subida mínima de 2%
+    for (int i = 0; i < 1200; i++) {
+        s.nivel += 0.025f;
+        passo(&s, leitura_normal(&s));
+    }
+    CHECA(!(s.falhas & DIAG_BOMBA_SECO));
+}
+
+int main(void) {
+    sem_falso_positivo();
+    fora_da_faixa();
+    estagnado();
+    estagnado_com_ruido();
+    taxa_implausivel();
+    bomba_a_seco();
+    bomba_enchendo();
+    return TESTE_FIM();
+}
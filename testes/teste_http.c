@@ -0,0 +1,202 @@
+/**
+ * Servidor HTTP (lib/webserver.c) sobre o lwIP simulado: respostas de
+ * /estado, ETag, o tempo de vida do estado da conexão quando o cliente fecha
+ * a escrita antes de a resposta sem cópia ter sido transmitida e respostas
+ * que não cabem no envio e seguem pelo sent e pelo poll. Sem memória para o
+ * estado da conexão, o segmento é recusado intacto e atendido na reentrega.
+ */
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "alarme.h"
+#include "servidor_host.h"
+#include "teste.h"
+#include "webserver.h"
+
+static char resp[8192];
+
+// malloc com falha injetável (ligado com -Wl,--wrap=malloc): a n-ésima
+// chamada a partir de malloc_falha_em = n devolve NULL
+static int malloc_falha_em = 0;
+void *__real_malloc(size_t tamanho);
+void *__wrap_malloc(size_t tamanho) {
+    if (malloc_falha_em && --malloc_falha_em == 0) {
+        return NULL;
+    }
+    return __real_malloc(tamanho);
+}
+
+static const char *corpo(const char *r) {
+    const char *c = strstr(r, "\r\n\r\n");
+    return c ? c + 4 : "";
+}
+
+static void publica_nivel(float nivel) {
+    nivel_percentual = nivel;
+    webserver_publica_estado();
+}
+
+static void teste_estado(void) {
+    publica_nivel(42.0f);
+    CHECA(servidor_host_requisicao(80, "GET /estado HTTP/1.1\r\n\r\n", false, resp, sizeof(resp)) > 0);
+    CHECA(strncmp(resp, "HTTP/1.1 200 OK", 15) == 0);
+    CHECA(strncmp(corpo(resp), "{\"nivel\":42.0,", 14) == 0);
+
+    // Mesma versão no If-None-Match: 304 sem corpo
+    const char *etag = strstr(resp, "ETag: \"");
+    CHECA(etag != NULL);
+    char req[128];
+    snprintf(req, sizeof(req), "GET /estado HTTP/1.1\r\nIf-None-Match: \"%lu\"\r\n\r\n",
+             etag ? strtoul(etag + 7, NULL, 10) : 0ul);
+    servidor_host_requisicao(80, req, false, resp, sizeof(resp));
+    CHECA(strncmp(resp, "HTTP/1.1 304", 12) == 0);
+}
+
+/**
+ * O cliente envia a requisição e já fecha a escrita (FIN); o servidor recebe
+ * p == NULL com a resposta ainda na fila, apontando para o buffer de /estado.
+ * Quatro publicações depois (todos os buffers), o que sai pela rede ainda
+ * tem de ser a versão pedida.
+ */
+static void teste_fin_antes_do_envio(void) {
+    publica_nivel(10.0f);
+    struct tcp_pcb *pcb = lwip_host_conecta(80);
+    CHECA(pcb != NULL);
+    const char *req = "GET /estado HTTP/1.1\r\n\r\n";
+    lwip_host_envia(pcb, req, strlen(req));
+    lwip_host_fin(pcb);
+    CHECA(!lwip_host_encerrado(pcb));
+
+    for (int i = 1; i <= 4; i++) {
+        publica_nivel(10.0f + i * 11.1f);
+    }
+
+    size_t n = 0, lidos;
+    while ((lidos = lwip_host_recebe(pcb, resp + n, sizeof(resp) - 1 - n)) > 0) {
+        n += lidos;
+        lwip_host_confirma(pcb, lidos);
+    }
+    resp[n] = '\0';
+    CHECA(strncmp(corpo(resp), "{\"nivel\":10.0,", 14) == 0);
+    CHECA(lwip_host_encerrado(pcb));
+    lwip_host_libera(pcb);
+    CHECA_IGUAL(lwip_stats.mem.used, 0);
+    CHECA_IGUAL(lwip_stats.memp[MEMP_TCP_SEG]->used, 0);
+
+    // A referência foi devolvida: as próximas publicações circulam normalmente
+    for (int i = 0; i < 8; i++) {
+        publica_nivel(60.0f + i);
+    }
+    servidor_host_requisicao(80, "GET /estado HTTP/1.1\r\n\r\n", true, resp, sizeof(resp));
+    CHECA(strncmp(corpo(resp), "{\"nivel\":67.0,", 14) == 0);
+}
+
+// Conexão reiniciada no meio do envio: http_err libera o estado e a referência
+static void teste_rst_no_envio(void) {
+    publica_nivel(30.0f);
+    struct tcp_pcb *pcbs[3];
+    for (int i = 0; i < 3; i++) {
+        pcbs[i] = lwip_host_conecta(80);
+        lwip_host_envia(pcbs[i], "GET /estado HTTP/1.1\r\n\r\n", 24);
+        lwip_host_fin(pcbs[i]);
+        lwip_host_rst(pcbs[i]);
+        lwip_host_libera(pcbs[i]);
+    }
+    CHECA_IGUAL(lwip_stats.memp[MEMP_TCP_PCB]->used, 1);  // Só o listener
+    for (int i = 0; i < 8; i++) {
+        publica_nivel(70.0f + i);
+    }
+    servidor_host_requisicao(80, "GET /estado HTTP/1.1\r\n\r\n", false, resp, sizeof(resp));
+    CHECA(strncmp(corpo(resp), "{\"nivel\":77.0,", 14) == 0);
+}
+
+// Bytes que faltam para a resposta completa (corpo menor que Content-Length)
+static long falta(const char *r, size_t n) {
+    const char *c = strstr(r, "\r\n\r\n");
+    const char *cl = strstr(r, "Content-Length: ");
+    if (!c || !cl) {
+        return -1;
+    }
+    return strtol(cl + 16, NULL, 10) - (long)(n - (size_t)(c + 4 - r));
+}
+
+/**
+ * Quatro /metricas copiados ao mesmo tempo passam do heap do lwIP (MEM_SIZE):
+ * tcp_write recusa parte com ERR_MEM e o restante sai quando os ACKs e o
+ * timer lento chegam. O heap liberado pelo ACK de uma conexão só é visto
+ * pelas outras no poll. Nenhuma pode ser abortada nem truncada.
+ */
+static void teste_envio_cheio(void) {
+    enum { N = MEMP_NUM_TCP_PCB - 1 };
+    static char respostas[N][4096];
+    struct tcp_pcb *pcbs[N];
+    size_t n[N] = {0};
+    uint32_t erros_antes = lwip_stats.mem.err;
+    for (int i = 0; i < N; i++) {
+        pcbs[i] = lwip_host_conecta(80);
+        CHECA(pcbs[i] != NULL);
+        lwip_host_envia(pcbs[i], "GET /metricas HTTP/1.1\r\n\r\n", 26);
+    }
+    CHECA(lwip_stats.mem.err > erros_antes);
+
+    int abertas = N, voltas = 0;
+    while (abertas && voltas++ < 100) {
+        abertas = 0;
+        for (int i = 0; i < N; i++) {
+            size_t lidos = lwip_host_recebe(pcbs[i], respostas[i] + n[i], sizeof(respostas[i]) - 1 - n[i]);
+            n[i] += lidos;
+            lwip_host_confirma(pcbs[i], lidos);
+            abertas += !lwip_host_encerrado(pcbs[i]);
+        }
+        lwip_host_tick();
+    }
+    for (int i = 0; i < N; i++) {
+        respostas[i][n[i]] = '\0';
+        CHECA(strncmp(respostas[i], "HTTP/1.1 200 OK", 15) == 0);
+        CHECA_IGUAL(falta(respostas[i], n[i]), 0);
+        CHECA(lwip_host_encerrado(pcbs[i]));
+        lwip_host_libera(pcbs[i]);
+    }
+    CHECA_IGUAL(lwip_stats.memp[MEMP_TCP_PCB]->used, 1);  // Nenhuma ficou pendurada
+    CHECA_IGUAL(lwip_stats.mem.used, 0);
+}
+
+/**
+ * O malloc do estado da conexão falha: o recv devolve ERR_MEM sem liberar o
+ * pbuf nem devolver a janela, e o lwIP entrega o mesmo segmento de novo
+ */
+static void teste_sem_memoria(void) {
+    struct tcp_pcb *pcb = lwip_host_conecta(80);
+    uint32_t janela = pcb->janela;
+    const char *req = "GET /estado HTTP/1.1\r\n\r\n";
+    malloc_falha_em = 2;  // 1ª: o pbuf do segmento no lwIP simulado; 2ª: o estado da conexão
+    lwip_host_envia(pcb, req, strlen(req));
+    CHECA_IGUAL(malloc_falha_em, 0);
+    CHECA_IGUAL(lwip_host_pendentes(pcb), strlen(req));
+    CHECA_IGUAL(pcb->janela, janela - strlen(req));
+    CHECA_IGUAL(lwip_host_recebe(pcb, resp, sizeof(resp)), 0);
+
+    lwip_host_tick();
+    size_t n = lwip_host_recebe(pcb, resp, sizeof(resp) - 1);
+    lwip_host_confirma(pcb, n);
+    resp[n] = '\0';
+    CHECA(strncmp(resp, "HTTP/1.1 200 OK", 15) == 0);
+    CHECA_IGUAL(lwip_host_pendentes(pcb), 0);
+    CHECA_IGUAL(pcb->janela, janela);
+    lwip_host_fin(pcb);
+    lwip_host_libera(pcb);
+}
+
+int main(void) {
+    alarme_init();
+    servidor_host_inicia();
+
+    teste_estado();
+    teste_fin_antes_do_envio();
+    teste_rst_no_envio();
+    teste_envio_cheio();
+    teste_sem_memoria();
+
+    return TESTE_FIM();
+}
@@ -0,0 +1,147 @@
+/**
+ * Escravo Modbus TCP (lib/modbus_tcp.c) sobre o lwIP simulado, com um
+ * cliente que manda requisições em pipeline num único segmento maior que o
+ * buffer de recepção e lê as respostas devagar: todas têm de chegar, em
+ * ordem, com a janela fechando enquanto o envio está cheio, sem abortar.
+ */
+#include <stdio.h>
+#include <string.h>
+
+#include "lwip_host.h"
+#include "modbus.h"
+#include "teste.h"
+
+#define NUM_HOLDING 200
+
+static uint8_t le_reg(uint16_t endereco, uint16_t *valor) {
+    *valor = (uint16_t)(endereco * 3 + 1);
+    return 0;
+}
+
+static uint8_t escreve_reg(uint16_t primeiro, const uint16_t *valores, uint16_t quantidade) {
+    (void)primeiro;
+    (void)valores;
+    (void)quantidade;
+    return MODBUS_EXC_ENDERECO_ILEGAL;
+}
+
+static const modbus_mapa_t mapa = {
+    .num_input = NUM_HOLDING,
+    .num_holding = NUM_HOLDING,
+    .le_input = le_reg,
+    .le_holding = le_reg,
+    .escreve_holding = escreve_reg,
+};
+
+// Leitura de `quantidade` holding registers a partir de `primeiro`
+static size_t requisicao(uint8_t *r, uint16_t transacao, uint16_t primeiro, uint16_t quantidade) {
+    const uint8_t adu[12] = {transacao >> 8, transacao & 0xFF, 0, 0, 0, 6, 1,
+                             0x03, primeiro >> 8, primeiro & 0xFF, quantidade >> 8, quantidade & 0xFF};
+    memcpy(r, adu, sizeof(adu));
+    return sizeof(adu);
+}
+
+// Confere uma resposta de leitura e retorna seu tamanho (0 se incompleta)
+static size_t confere_resposta(const uint8_t *r, size_t n, uint16_t transacao, uint16_t primeiro, uint16_t quantidade) {
+    size_t tam = 9 + 2u * quantidade;
+    if (n < tam) {
+        return 0;
+    }
+    CHECA_IGUAL((r[0] << 8) | r[1], transacao);
+    CHECA_IGUAL((r[4] << 8) | r[5], 3 + 2 * quantidade);
+    CHECA_IGUAL(r[7], 0x03);
+    CHECA_IGUAL(r[8], 2 * quantidade);
+    CHECA_IGUAL((r[9 + 2 * (quantidade - 1)] << 8) | r[10 + 2 * (quantidade - 1)],
+                (primeiro + quantidade - 1) * 3 + 1);
+    return tam;
+}
+
+static void teste_requisicao_simples(void) {
+    struct tcp_pcb *pcb = lwip_host_conecta(MODBUS_PORTA);
+    CHECA(pcb != NULL);
+    uint8_t req[12], resp[64];
+    lwip_host_envia(pcb, req, requisicao(req, 7, 10, 4));
+    size_t n = lwip_host_recebe(pcb, resp, sizeof(resp));
+    CHECA_IGUAL(n, 9 + 8);
+    confere_resposta(resp, n, 7, 10, 4);
+    lwip_host_confirma(pcb, n);
+    lwip_host_fin(pcb);
+    CHECA(lwip_host_encerrado(pcb));
+    lwip_host_libera(pcb);
+}
+
+/**
+ * 100 leituras de 125 registradores (1200 bytes de requisição num só
+ * segmento, 25900 de resposta) contra 520 bytes de rx e TCP_SND_BUF de envio.
+ * O cliente lê 1000 bytes por vez e confirma; o timer lento reentrega o
+ * segmento recusado, como o tcp_fasttmr.
+ */
+static void teste_pipeline_com_pressao(void) {
+    enum { N = 100, QTD = 125 };
+    static uint8_t reqs[N * 12];
+    static uint8_t resp[N * (9 + 2 * QTD)];
+    size_t reqs_len = 0;
+    for (int i = 0; i < N; i++) {
+        reqs_len += requisicao(reqs + reqs_len, (uint16_t)(1000 + i), (uint16_t)(i % 50), QTD - (i % 50 > 25 ? 50 : 0));
+    }
+
+    struct tcp_pcb *pcb = lwip_host_conecta(MODBUS_PORTA);
+    CHECA(pcb != NULL);
+    lwip_host_envia(pcb, reqs, reqs_len);
+    CHECA(!lwip_host_encerrado(pcb));
+
+    size_t n = 0, lidos, conferidos = 0;
+    int respostas = 0;
+    uint32_t janela_min = pcb->janela;
+    int voltas = 0;
+    while (respostas < N && voltas++ < 10000) {
+        lidos = lwip_host_recebe(pcb, resp + n, 1000 < sizeof(resp) - n ? 1000 : sizeof(resp) - n);
+        n += lidos;
+        lwip_host_confirma(pcb, lidos);
+        if (pcb->janela < janela_min) {
+            janela_min = pcb->janela;
+        }
+        lwip_host_tick();
+        size_t tam;
+        while (respostas < N &&
+               (tam = confere_resposta(resp + conferidos, n - conferidos, (uint16_t)(1000 + respostas),
+                                       (uint16_t)(respostas % 50), QTD - (respostas % 50 > 25 ? 50 : 0))) > 0) {
+            conferidos += tam;
+            respostas++;
+        }
+    }
+    printf("pipeline: %d respostas, %zu bytes, janela mínima %lu de %d\n", respostas, n,
+           (unsigned long)janela_min, TCP_WND);
+    CHECA_IGUAL(respostas, N);
+    CHECA(!lwip_host_encerrado(pcb));
+    CHECA(janela_min < TCP_WND);           // Bytes sem resposta seguraram a janela
+    CHECA_IGUAL(lwip_host_pendentes(pcb), 0);
+    CHECA_IGUAL(pcb->janela, TCP_WND);     // Tudo respondido devolve a janela
+    CHECA_IGUAL(lwip_stats.memp[MEMP_PBUF_POOL]->used, 0);
+    lwip_host_fin(pcb);
+    lwip_host_libera(pcb);
+}
+
+// Protocolo diferente de 0 no MBAP: a conexão é abortada
+static void teste_cabecalho_invalido(void) {
+    struct tcp_pcb *pcb = lwip_host_conecta(MODBUS_PORTA);
+    uint8_t req[12];
+    requisicao(req, 1, 0, 1);
+    req[3] = 1;
+    lwip_host_envia(pcb, req, sizeof(req));
+    CHECA(lwip_host_encerrado(pcb));
+    lwip_host_libera(pcb);
+    CHECA_IGUAL(lwip_stats.memp[MEMP_PBUF_POOL]->used, 0);
+}
+
+int main(void) {
+    lwip_host_reinicia();
+    CHECA(modbus_tcp_init(&mapa));
+
+    teste_requisicao_simples();
+    teste_pipeline_com_pressao();
+    teste_cabecalho_invalido();
+    CHECA_IGUAL(lwip_stats.memp[MEMP_TCP_PCB]->used, 1);  // Só o listener
+
+    return TESTE_FIM();
+}
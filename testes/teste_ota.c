@@ -0,0 +1,262 @@
+/**
+ * Atualização pela rede sobre a flash simulada em arquivo: HMAC-SHA256 contra
+ * os vetores da RFC 4231, a sessão de lib/ota.c (imagem boa, assinatura
+ * errada, excesso, imagem incompleta, falha do backend e bit preso que só a
+ * releitura encontra) e o POST /update de ponta a ponta, com a janela TCP
+ * presa até o laço principal gravar a fila em webserver_ota_processa e a
+ * sessão descartada quando o cliente para no meio da imagem.
+ */
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "alarme.h"
+#include "ota.h"
+#include "servidor_host.h"
+#include "sha256.h"
+#include "teste.h"
+#include "webserver.h"
+
+#define IMAGEM_TAM 60000
+
+static uint8_t imagem[IMAGEM_TAM];
+static uint8_t chave[SHA256_TAM];
+static ota_escrita_t ota;
+static char resp[4096];
+
+static void hmac(const uint8_t *k, size_t k_len, const void *dados, size_t len, uint8_t mac[SHA256_TAM]) {
+    sha256_hmac_t ctx;
+    sha256_hmac_inicia(&ctx, k, k_len);
+    sha256_hmac_atualiza(&ctx, dados, len);
+    sha256_hmac_finaliza(&ctx, mac);
+}
+
+static void hex(const uint8_t *b, size_t n, char *s) {
+    for (size_t i = 0; i < n; i++) {
+        sprintf(s + 2 * i, "%02x", b[i]);
+    }
+}
+
+// RFC 4231, casos 1, 2 e 6 (chave maior que o bloco)
+static void teste_hmac_rfc4231(void) {
+    static const struct {
+        uint8_t chave_byte;
+        size_t chave_len;
+        const char *chave;
+        const char *dados;
+        const char *mac;
+    } casos[] = {
+        {0x0b, 20, NULL, "Hi There", "b0344c61d8db38535ca8afceaf0bf12b881dc200c9833da726e9376c2e32cff7"},
+        {0, 4, "Jefe", "what do ya want for nothing?",
+         "5bdcc146bf60754e6a042426089575c75a003f089d2739839dec58b964ec3843"},
+        {0xaa, 131, NULL, "Test Using Larger Than Block-Size Key - Hash Key First",
+         "60e431591ee0b67f0d8a26aacbf5b77f8e0bc6213728c5140546040f0ee37f54"},
+    };
+    for (size_t i = 0; i < sizeof(casos) / sizeof(casos[0]); i++) {
+        uint8_t k[131], mac[SHA256_TAM];
+        char obtido[2 * SHA256_TAM + 1];
+        if (casos[i].chave) {
+            memcpy(k, casos[i].chave, casos[i].chave_len);
+        } else {
+            memset(k, casos[i].chave_byte, casos[i].chave_len);
+        }
+        hmac(k, casos[i].chave_len, casos[i].dados, strlen(casos[i].dados), mac);
+        hex(mac, SHA256_TAM, obtido);
+        CHECA(strcmp(obtido, casos[i].mac) == 0);
+    }
+}
+
+// Grava a imagem em pedaços de `passo` bytes e finaliza
+static ota_status_t grava(flash_arquivo_t *fa, uint32_t base, uint32_t tamanho, const uint8_t assinatura[SHA256_TAM],
+                          size_t passo) {
+    ota_flash_t flash = flash_arquivo_backend(fa);
+    if (ota_inicia(&ota, &flash, base, 256 * 1024, tamanho, chave, sizeof(chave), assinatura) != OTA_OK) {
+        return ota.status;
+    }
+    for (size_t i = 0; i < tamanho && ota.status == OTA_OK; i += passo) {
+        ota_escreve(&ota, imagem + i, tamanho - i < passo ? tamanho - i : passo);
+    }
+    return ota_finaliza(&ota);
+}
+
+static void teste_sessao(void) {
+    flash_arquivo_t fa;
+    CHECA(flash_arquivo_abre(&fa, NULL, 512 * 1024));
+    uint8_t assinatura[SHA256_TAM];
+    hmac(chave, sizeof(chave), imagem, IMAGEM_TAM, assinatura);
+
+    // Região suja (gravação anterior): sem apagar, a releitura não bateria
+    static uint8_t zeros[OTA_SETOR_TAM];
+    CHECA(flash_arquivo_programa(&fa, 64 * 1024, zeros, sizeof(zeros)));
+
+    CHECA_IGUAL(grava(&fa, 64 * 1024, IMAGEM_TAM, assinatura, 1000), OTA_OK);
+    CHECA_IGUAL(fa.apagamentos, (IMAGEM_TAM + OTA_SETOR_TAM - 1) / OTA_SETOR_TAM);
+    static uint8_t lido[IMAGEM_TAM];
+    CHECA(flash_arquivo_le(&fa, 64 * 1024, lido, IMAGEM_TAM));
+    CHECA(memcmp(lido, imagem, IMAGEM_TAM) == 0);
+
+    uint8_t errada[SHA256_TAM];
+    memcpy(errada, assinatura, sizeof(errada));
+    errada[31] ^= 1;
+    CHECA_IGUAL(grava(&fa, 64 * 1024, IMAGEM_TAM, errada, 1460), OTA_ERRO_ASSINATURA);
+
+    // Assinatura feita com outra chave também não passa
+    uint8_t outra_chave[SHA256_TAM] = {1};
+    hmac(outra_chave, sizeof(outra_chave), imagem, IMAGEM_TAM, errada);
+    CHECA_IGUAL(grava(&fa, 64 * 1024, IMAGEM_TAM, errada, 1460), OTA_ERRO_ASSINATURA);
+
+    CHECA_IGUAL(grava(&fa, 64 * 1024, 300 * 1024, assinatura, 1000), OTA_ERRO_TAMANHO);
+
+    ota_flash_t flash = flash_arquivo_backend(&fa);
+    ota_inicia(&ota, &flash, 64 * 1024, 256 * 1024, 100, chave, sizeof(chave), assinatura);
+    CHECA_IGUAL(ota_escreve(&ota, imagem, 101), OTA_ERRO_EXCESSO);
+    ota_inicia(&ota, &flash, 64 * 1024, 256 * 1024, IMAGEM_TAM, chave, sizeof(chave), assinatura);
+    ota_escreve(&ota, imagem, IMAGEM_TAM / 2);
+    CHECA_IGUAL(ota_finaliza(&ota), OTA_ERRO_INCOMPLETO);
+
+    // Segundo apagamento falha no backend
+    fa.apagamentos = fa.programacoes = 0;
+    fa.falha_na_operacao = 3;
+    CHECA_IGUAL(grava(&fa, 64 * 1024, IMAGEM_TAM, assinatura, 4096), OTA_ERRO_FLASH);
+    fa.falha_na_operacao = 0;
+
+    // Bit que não vai a zero: os dados recebidos conferem, a flash não
+    imagem[100] = 0x00;
+    hmac(chave, sizeof(chave), imagem, IMAGEM_TAM, assinatura);
+    fa.bit_preso = (64 * 1024 + 100) * 8 + 3;
+    CHECA_IGUAL(grava(&fa, 64 * 1024, IMAGEM_TAM, assinatura, 1000), OTA_ERRO_VERIFICACAO);
+    flash_arquivo_fecha(&fa);
+}
+
+// Envia o cabeçalho e a imagem inteira; o lwIP entrega conforme a janela
+static struct tcp_pcb *inicia_upload(const char *token, const uint8_t assinatura[SHA256_TAM]) {
+    char assinatura_hex[2 * SHA256_TAM + 1];
+    char cabecalho[320];
+    hex(assinatura, SHA256_TAM, assinatura_hex);
+    int n = snprintf(cabecalho, sizeof(cabecalho),
+                     "POST /update HTTP/1.1\r\nX-Token: %s\r\nContent-Length: %d\r\nX-Assinatura: %s\r\n\r\n", token,
+                     IMAGEM_TAM, assinatura_hex);
+    struct tcp_pcb *pcb = lwip_host_conecta(80);
+    CHECA(pcb != NULL);
+    lwip_host_envia(pcb, cabecalho, (size_t)n);
+    lwip_host_envia(pcb, imagem, IMAGEM_TAM);
+    lwip_host_fin(pcb);
+    return pcb;
+}
+
+// Laço principal gravando a fila até a resposta sair; retorna os bytes lidos
+static size_t conclui_upload(struct tcp_pcb *pcb, int *voltas) {
+    size_t n = 0, lidos;
+    *voltas = 0;
+    while (!lwip_host_encerrado(pcb) && (*voltas)++ < 1000) {
+        webserver_ota_processa();
+        lwip_host_processa(pcb);
+        while ((lidos = lwip_host_recebe(pcb, resp + n, sizeof(resp) - 1 - n)) > 0) {
+            n += lidos;
+            lwip_host_confirma(pcb, lidos);
+        }
+    }
+    resp[n] = '\0';
+    return n;
+}
+
+static void teste_update(void) {
+    uint8_t assinatura[SHA256_TAM];
+    int voltas;
+
+    imagem[100] = 0x5a;
+    hmac(chave, sizeof(chave), imagem, IMAGEM_TAM, assinatura);
+    struct tcp_pcb *pcb = inicia_upload("errado", assinatura);
+    conclui_upload(pcb, &voltas);
+    CHECA(strncmp(resp, "HTTP/1.1 401", 12) == 0);
+    lwip_host_libera(pcb);
+
+    // Assinatura errada: toda a imagem passa pela flash e o resultado é 422
+    uint8_t errada[SHA256_TAM];
+    memcpy(errada, assinatura, sizeof(errada));
+    errada[0] ^= 0x80;
+    pcb = inicia_upload("teste-token", errada);
+    conclui_upload(pcb, &voltas);
+    CHECA(strncmp(resp, "HTTP/1.1 422", 12) == 0);
+    CHECA(strstr(resp, "assinatura nao confere") != NULL);
+    lwip_host_libera(pcb);
+
+    // Cliente para na metade sem fechar: com a fila gravada e a janela
+    // aberta, HTTP_POLL_MAX polls sem bytes novos derrubam conexão e sessão
+    char cabecalho[320];
+    char assinatura_hex[2 * SHA256_TAM + 1];
+    hex(assinatura, SHA256_TAM, assinatura_hex);
+    int n = snprintf(cabecalho, sizeof(cabecalho),
+                     "POST /update HTTP/1.1\r\nX-Token: teste-token\r\nContent-Length: %d\r\nX-Assinatura: %s\r\n\r\n",
+                     IMAGEM_TAM, assinatura_hex);
+    pcb = lwip_host_conecta(80);
+    CHECA(pcb != NULL);
+    lwip_host_envia(pcb, cabecalho, (size_t)n);
+    lwip_host_envia(pcb, imagem, IMAGEM_TAM / 2);
+    while (webserver_ota_processa() && lwip_host_pendentes(pcb) > 0) {
+        lwip_host_processa(pcb);
+    }
+    CHECA(webserver_ota_processa());
+    int ticks = 0;
+    while (!lwip_host_encerrado(pcb) && ticks < 100) {
+        lwip_host_tick();
+        ticks++;
+    }
+    CHECA(lwip_host_encerrado(pcb));
+    CHECA(ticks <= 2 * (8 + 1));
+    CHECA(!webserver_ota_processa());
+    lwip_host_libera(pcb);
+
+    // Imagem boa. Nada é gravado no recv (contexto do lwIP): a janela fica
+    // presa até o laço principal processar a fila
+    uint32_t programacoes = servidor_host_flash.programacoes;
+    pcb = inicia_upload("teste-token", assinatura);
+    CHECA_IGUAL(servidor_host_flash.programacoes, programacoes);
+    CHECA(lwip_host_pendentes(pcb) > 0);
+    CHECA_IGUAL(pcb->janela, 0);
+    CHECA(webserver_ota_processa());
+    CHECA(servidor_host_flash.programacoes > programacoes);
+    CHECA(pcb->janela > 0);
+    conclui_upload(pcb, &voltas);
+    printf("upload: %d voltas do laço, %lu programações\n", voltas,
+           (unsigned long)(servidor_host_flash.programacoes - programacoes));
+    CHECA(strncmp(resp, "HTTP/1.1 200", 12) == 0);
+    CHECA(strstr(resp, "\"resultado\":\"ok\"") != NULL);
+    CHECA(!webserver_ota_processa());
+    lwip_host_libera(pcb);
+
+    uint32_t base, capacidade, tamanho = 0;
+    ota_regiao_staging(&base, &capacidade);
+    static uint8_t lido[IMAGEM_TAM];
+    CHECA(flash_arquivo_le(&servidor_host_flash, base, lido, IMAGEM_TAM));
+    CHECA(memcmp(lido, imagem, IMAGEM_TAM) == 0);
+    sdk_host_avanca_us(2000000);
+    CHECA(webserver_ota_pronta(to_ms_since_boot(get_absolute_time()), &tamanho));
+    CHECA_IGUAL(tamanho, IMAGEM_TAM);
+
+    // Com uma imagem pronta para a troca, outra sessão é recusada
+    servidor_host_requisicao(80, "POST /update HTTP/1.1\r\nX-Token: teste-token\r\nContent-Length: 10\r\n"
+                                 "X-Assinatura: 00000000000000000000000000000000"
+                                 "00000000000000000000000000000000\r\n\r\n",
+                             true, resp, sizeof(resp));
+    CHECA(strncmp(resp, "HTTP/1.1 409", 12) == 0);
+    CHECA_IGUAL(lwip_stats.memp[MEMP_PBUF_POOL]->used, 0);
+    CHECA_IGUAL(lwip_stats.mem.used, 0);
+}
+
+int main(void) {
+    srand(4231);
+    for (size_t i = 0; i < IMAGEM_TAM; i++) {
+        imagem[i] = (uint8_t)rand();
+    }
+    CHECA(ota_hash_de_hex(OTA_CHAVE, chave));
+
+    alarme_init();
+    servidor_host_inicia();
+
+    teste_hmac_rfc4231();
+    teste_sessao();
+    teste_update();
+
+    return TESTE_FIM();
+}
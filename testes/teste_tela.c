@@ -0,0 +1,163 @@
+/**
+ * Espelho do OLED (lib/tela.c) contra o SSD1306 emulado: o PBM codificado
+ * página a página tem de ser idêntico ao que painel_host_pbm grava da
+ * GDDRAM, e os registros de /tela/delta aplicados por um cliente têm de
+ * reconstituir o que o display mostra a cada envio. Pelo servidor real,
+ * /tela.pbm e /tela/delta entregam os mesmos bytes.
+ */
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "alarme.h"
+#include "painel_host.h"
+#include "servidor_host.h"
+#include "teste.h"
+#include "tela.h"
+#include "webserver.h"
+
+static ssd1306_t ssd;
+static uint8_t cliente[PAINEL_HOST_LARGURA][PAINEL_HOST_PAGINAS];  // Quadro do lado do cliente
+static uint8_t registro[TELA_REGISTRO_CAB + WIDTH * HEIGHT / 8];
+static uint32_t seq = 0;
+static char resp[4096];
+
+// Aplica um registro como o cliente de /tela/delta; retorna o tamanho consumido
+static size_t aplica(const uint8_t *r, size_t n) {
+    if (n < TELA_REGISTRO_CAB) {
+        return 0;
+    }
+    uint8_t x0 = r[4], x1 = r[5], p0 = r[6], p1 = r[7];
+    size_t tam = tela_tam_registro(x0, x1, p0, p1);
+    if (n < tam) {
+        return 0;
+    }
+    const uint8_t *d = r + TELA_REGISTRO_CAB;
+    for (uint16_t x = x0; x <= x1; x++) {
+        memcpy(&cliente[x][p0], d, p1 - p0 + 1);
+        d += p1 - p0 + 1;
+    }
+    return tam;
+}
+
+static void ao_enviar(const ssd1306_t *s, uint8_t x0, uint8_t x1, uint8_t p0, uint8_t p1) {
+    size_t n = tela_codifica_registro(s, seq, x0, x1, p0, p1, registro);
+    CHECA_IGUAL(n, tela_tam_registro(x0, x1, p0, p1));
+    CHECA_IGUAL(registro[0] | registro[1] << 8 | registro[2] << 16 | (uint32_t)registro[3] << 24, seq);
+    seq++;
+    CHECA_IGUAL(aplica(registro, n), n);
+}
+
+static size_t le_arquivo(const char *nome, uint8_t *dados, size_t max) {
+    FILE *f = fopen(nome, "rb");
+    if (!f) {
+        return 0;
+    }
+    size_t n = fread(dados, 1, max, f);
+    fclose(f);
+    return n;
+}
+
+// PBM completo pelos codificadores, como /tela.pbm o monta
+static size_t pbm_codificado(uint8_t *saida) {
+    size_t n = (size_t)tela_cabecalho_pbm(&ssd, (char *)saida, 16);
+    for (uint8_t p = 0; p < ssd.pages; p++) {
+        n += tela_codifica_pagina_pbm(&ssd, p, saida + n);
+    }
+    return n;
+}
+
+static void desenha(int i) {
+    ssd1306_fill(&ssd, false);
+    ssd1306_rect(&ssd, 3 + i, 5, 60, 21, true, false);
+    ssd1306_draw_string(&ssd, "Nivel 42%", 10 + i, 30);
+    ssd1306_line(&ssd, 0, 63, 127, (uint8_t)(i * 7), true);
+}
+
+static void teste_pbm(void) {
+    static uint8_t esperado[2048], obtido[2048];
+    for (int i = 0; i < 3; i++) {
+        desenha(i);
+        ssd1306_send_data(&ssd);
+        CHECA(painel_host_pbm("tela_host.pbm", ssd.width, ssd.height));
+        size_t n_esperado = le_arquivo("tela_host.pbm", esperado, sizeof(esperado));
+        size_t n = pbm_codificado(obtido);
+        CHECA_IGUAL(n, n_esperado);
+        CHECA_IGUAL(n - (size_t)tela_cabecalho_pbm(&ssd, NULL, 0), tela_tam_pbm(&ssd));
+        CHECA(memcmp(obtido, esperado, n) == 0);
+    }
+}
+
+static void teste_registros(void) {
+    ssd.ao_enviar = ao_enviar;
+    ssd1306_send_data(&ssd);
+    CHECA(memcmp(cliente, painel_host.gddram, sizeof(cliente)) == 0);
+
+    // Janelas parciais de vários tamanhos, inclusive atravessando páginas
+    // x, y, largura, altura
+    static const uint8_t janelas[][4] = {{0, 0, 10, 7}, {40, 13, 80, 20}, {120, 8, 62, 2}, {3, 3, 120, 60}};
+    for (size_t i = 0; i < sizeof(janelas) / sizeof(janelas[0]); i++) {
+        const uint8_t *j = janelas[i];
+        ssd1306_rect(&ssd, j[1], j[0], j[2] > 4 ? 4 : j[2], j[3] > 4 ? 4 : j[3], i & 1, true);
+        ssd1306_draw_string(&ssd, "ab", j[0], j[1]);
+        ssd1306_mark_dirty(&ssd, j[0], j[1], j[2], j[3]);
+        ssd1306_send_dirty(&ssd);
+        CHECA(memcmp(cliente, painel_host.gddram, sizeof(cliente)) == 0);
+    }
+    CHECA_IGUAL(seq, 1 + sizeof(janelas) / sizeof(janelas[0]));
+    ssd.ao_enviar = NULL;
+}
+
+static void teste_http(void) {
+    webserver_espelha_tela(&ssd);
+    desenha(5);
+    ssd1306_send_data(&ssd);
+
+    // /tela.pbm: o corpo é o PBM da GDDRAM
+    int n = servidor_host_requisicao(80, "GET /tela.pbm HTTP/1.1\r\n\r\n", false, resp, sizeof(resp));
+    const char *corpo = strstr(resp, "\r\n\r\n");
+    CHECA(n > 0 && corpo != NULL);
+    static uint8_t esperado[2048];
+    CHECA(painel_host_pbm("tela_host.pbm", ssd.width, ssd.height));
+    size_t n_esperado = le_arquivo("tela_host.pbm", esperado, sizeof(esperado));
+    CHECA_IGUAL(n - (corpo + 4 - resp), n_esperado);
+    CHECA(corpo && memcmp(corpo + 4, esperado, n_esperado) == 0);
+
+    // /tela/delta: quadro inteiro e depois só a janela enviada ao display
+    struct tcp_pcb *pcb = lwip_host_conecta(80);
+    const char *req = "GET /tela/delta HTTP/1.1\r\n\r\n";
+    lwip_host_envia(pcb, req, strlen(req));
+    size_t lidos = lwip_host_recebe(pcb, resp, sizeof(resp));
+    lwip_host_confirma(pcb, lidos);
+    corpo = strstr(resp, "\r\n\r\n");
+    CHECA(corpo != NULL);
+    size_t cab = corpo ? (size_t)(corpo + 4 - resp) : 0;
+    memset(cliente, 0, sizeof(cliente));
+    CHECA_IGUAL(aplica((const uint8_t *)resp + cab, lidos - cab), lidos - cab);
+    CHECA(memcmp(cliente, painel_host.gddram, sizeof(cliente)) == 0);
+
+    ssd1306_draw_string(&ssd, "xyz", 70, 50);
+    ssd1306_mark_dirty(&ssd, 70, 50, 24, 8);
+    ssd1306_send_dirty(&ssd);
+    lidos = lwip_host_recebe(pcb, resp, sizeof(resp));
+    lwip_host_confirma(pcb, lidos);
+    CHECA_IGUAL(lidos, tela_tam_registro(70, 93, 6, 7));
+    CHECA_IGUAL(aplica((const uint8_t *)resp, lidos), lidos);
+    CHECA(memcmp(cliente, painel_host.gddram, sizeof(cliente)) == 0);
+    lwip_host_fin(pcb);
+    lwip_host_libera(pcb);
+}
+
+int main(void) {
+    painel_host_reinicia();
+    ssd1306_init(&ssd, WIDTH, HEIGHT, false, 0x3C, i2c1);
+    ssd1306_config(&ssd);
+    alarme_init();
+    servidor_host_inicia();
+
+    teste_pbm();
+    teste_registros();
+    teste_http();
+
+    return TESTE_FIM();
+}
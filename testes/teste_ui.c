@@ -0,0 +1,103 @@
+/**
+ * Interface retida (lib/ui.c) sobre o driver real (lib/ssd1306.cpp) e um
+ * SSD1306 emulado: cada quadro é gravado como PBM (ui_quadro_N.pbm no
+ * diretório de execução) e o teste confere quantos pixels foram de fato
+ * enviados, que o display ficou igual ao framebuffer e que um quadro sem
+ * mudança não toca o barramento.
+ */
+#include <stdio.h>
+
+#include "fonte_digitos.h"
+#include "painel_host.h"
+#include "teste.h"
+#include "ui.h"
+
+static const uint8_t ICONES[][8] = {
+    {0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00},
+    {0x04, 0x12, 0x49, 0x6D, 0x49, 0x12, 0x04, 0x00},
+};
+static const char *const TXT_NIVEL = "Nível de Água:";
+static const char *const TXT_HISTORICO = "Histórico";
+
+static int32_t nivel = 42, icone = 0;
+static const char *bomba = "Bomba: DESLIGADA";
+static ui_historico_t historico;
+
+// Mesma disposição da tela de nível de main.c
+static ui_widget_t widgets_nivel[] = {
+    {.tipo = UI_ROTULO, .x = 4,   .y = 0,  .largura = 112, .altura = 12, .fonte = {.texto = &TXT_NIVEL}},
+    {.tipo = UI_ICONE,  .x = 120, .y = 2,  .largura = 8,   .altura = 8,  .fonte = {.valor = &icone}, .extra = {.icones = ICONES}},
+    {.tipo = UI_VALOR,  .x = 0,   .y = 16, .largura = 64,  .altura = 16, .fonte = {.valor = &nivel}, .extra = {.sufixo = "%"},
+     .tipografia = &fonte_digitos, .centralizado = true},
+    {.tipo = UI_BARRA,  .x = 66,  .y = 20, .largura = 58,  .altura = 8,  .fonte = {.valor = &nivel}},
+    {.tipo = UI_ROTULO, .x = 4,   .y = 52, .largura = 124, .altura = 12, .fonte = {.texto = &bomba}},
+};
+static ui_widget_t widgets_historico[] = {
+    {.tipo = UI_ROTULO,  .x = 4, .y = 0,  .largura = 72,  .altura = 12, .fonte = {.texto = &TXT_HISTORICO}},
+    {.tipo = UI_GRAFICO, .x = 4, .y = 14, .largura = 120, .altura = 50, .fonte = {.historico = &historico}},
+};
+static const ui_tela_t telas[] = {
+    {widgets_nivel, count_of(widgets_nivel)},
+    {widgets_historico, count_of(widgets_historico)},
+};
+
+static ssd1306_t ssd;
+static ui_t ui;
+static int quadro = 0;
+
+// Renderiza um quadro, grava o PBM e confere a contagem contra o barramento
+static uint32_t renderiza(const char *descricao) {
+    char nome[32];
+    painel_host_zera_contadores();
+    ui_renderiza(&ui);
+    snprintf(nome, sizeof(nome), "ui_quadro_%d.pbm", quadro++);
+    CHECA(painel_host_pbm(nome, ssd.width, ssd.height));
+    CHECA(painel_host_igual(ssd.ram_buffer + 1, ssd.width, ssd.pages));
+    CHECA_IGUAL(ui.pixels_redesenhados, painel_host.bytes_dados * 8);
+    printf("%s  widgets %lu  pixels %5lu  bytes %4lu  transações %lu  %s\n", nome,
+           (unsigned long)ui.widgets_redesenhados, (unsigned long)ui.pixels_redesenhados,
+           (unsigned long)painel_host.bytes_dados, (unsigned long)painel_host.transacoes, descricao);
+    return ui.pixels_redesenhados;
+}
+
+static bool aceso(uint8_t x, uint8_t y) {
+    return painel_host.gddram[x][y >> 3] & (1u << (y & 7));
+}
+
+int main(void) {
+    painel_host_reinicia();
+    ssd1306_init(&ssd, 128, 64, false, 0x3C, i2c1);
+    ssd1306_config(&ssd);
+    ui_init(&ui, &ssd, telas, count_of(telas));
+
+    CHECA_IGUAL(renderiza("primeiro quadro"), 128 * 64);
+    CHECA_IGUAL(ui.widgets_redesenhados, count_of(widgets_nivel));
+    CHECA(aceso(66, 20) && aceso(123, 27));      // Moldura da barra
+    CHECA(aceso(67, 21) && !aceso(122, 21));     // 42% preenchido
+
+    ui.pixels_redesenhados = 1;
+    CHECA_IGUAL(renderiza("sem mudança"), 0);
+    CHECA_IGUAL(painel_host.transacoes, 0);
+
+    // Valor e barra mudam juntos: uma janela cobre os dois, páginas 2 e 3
+    nivel = 43;
+    CHECA_IGUAL(renderiza("nível 42 -> 43"), (123 - 0 + 1) * 2 * 8);
+    CHECA_IGUAL(ui.widgets_redesenhados, 2);
+
+    bomba = "Bomba: LIGADA";
+    CHECA_IGUAL(renderiza("bomba liga"), (127 - 4 + 1) * 2 * 8);
+
+    icone = 1;
+    CHECA_IGUAL(renderiza("ícone do Wi-Fi"), 8 * 2 * 8);
+    CHECA(aceso(120 + 3, 2 + 0));
+
+    // Troca de tela reenvia tudo; depois só o gráfico muda
+    ui_proxima_tela(&ui);
+    CHECA_IGUAL(renderiza("tela de histórico"), 128 * 64);
+    for (int i = 0; i < 10; i++) {
+        ui_historico_adiciona(&historico, 10 * i);
+    }
+    CHECA_IGUAL(renderiza("gráfico com 10 pontos"), (123 - 4 + 1) * 7 * 8);
+
+    return TESTE_FIM();
+}
@@ -0,0 +1,215 @@
+#!/usr/bin/env python3
+"""
+Gerador de carga HTTP para o servidor web do controlador de nível.
+
+Abre N clientes concorrentes contra o dispositivo (ou qualquer servidor
+compatível), cada um repetindo requisições sorteadas conforme o mix
+configurado, e reporta requisições por segundo, latências p50/p90/p99,
+erros e, ao final, o pico de uso dos pools do lwIP lido em /metricas.
+
+Exemplos:
+  tools/carga_http.py 192.168.0.50 -c 5 -d 30
+  tools/carga_http.py 192.168.0.50 -c 50 --mix "/=1,/estado=8,/limites=1" --keep-alive
+
+Atenção: /limites altera os limites do dispositivo; o mix usa os valores
+de --limites (padrão 30,70, os mesmos do firmware).
+"""
+
+import argparse
+import asyncio
+import json
+import random
+import sys
+import time
+
+
+def percentil(ordenados, p):
+    if not ordenados:
+        return 0.0
+    k = min(len(ordenados) - 1, int(round(p / 100.0 * (len(ordenados) - 1))))
+    return ordenados[k]
+
+
+def interpreta_mix(texto, limites):
+    rotas, pesos = [], []
+    for item in texto.split(","):
+        caminho, _, peso = item.partition("=")
+        caminho = caminho.strip()
+        if caminho == "/limites":
+            caminho = "/limites?min=%s&max=%s" % limites
+        rotas.append(caminho)
+        pesos.append(float(peso or 1))
+    return rotas, pesos
+
+
+class Resultados:
+    def __init__(self):
+        self.latencias = []
+        self.por_rota = {}
+        self.status = {}
+        self.erros = {}
+        self.conexoes = 0
+        self.fechadas_pelo_servidor = 0
+
+    def erro(self, tipo):
+        self.erros[tipo] = self.erros.get(tipo, 0) + 1
+
+
+async def le_resposta(leitor):
+    """Lê uma resposta HTTP/1.1; retorna (status, servidor_fechou)."""
+    linha = await leitor.readline()
+    if not linha:
+        raise ConnectionResetError("conexão fechada sem resposta")
+    versao, status = linha.split()[:2]
+    status = int(status)
+    tamanho = None
+    fechar = versao == b"HTTP/1.0"
+    while True:
+        cab = await leitor.readline()
+        if cab in (b"\r\n", b"\n", b""):
+            break
+        nome, _, valor = cab.decode("latin-1").partition(":")
+        nome = nome.strip().lower()
+        if nome == "content-length":
+            tamanho = int(valor.strip())
+        elif nome == "connection":
+            fechar = valor.strip().lower() != "keep-alive"
+    if status in (204, 304) or (100 <= status < 200):
+        return status, fechar
+    if tamanho is not None:
+        await leitor.readexactly(tamanho)
+    else:
+        await leitor.read()  # Sem Content-Length: corpo vai até o fechamento
+        fechar = True
+    return status, fechar
+
+
+async def cliente(args, rotas, pesos, fim, res, rng):
+    leitor = escritor = None
+    while time.monotonic() < fim:
+        caminho = rng.choices(rotas, pesos)[0]
+        try:
+            if escritor is None:
+                leitor, escritor = await asyncio.wait_for(
+                    asyncio.open_connection(args.host, args.porta), args.timeout)
+                res.conexoes += 1
+            pedido = ("GET %s HTTP/1.1\r\nHost: %s\r\nConnection: %s\r\n\r\n"
+                      % (caminho, args.host, "keep-alive" if args.keep_alive else "close"))
+            t0 = time.perf_counter()
+            escritor.write(pedido.encode())
+            await escritor.drain()
+            status, fechou = await asyncio.wait_for(le_resposta(leitor), args.timeout)
+            res.latencias.append((time.perf_counter() - t0) * 1000.0)
+            rota = caminho.split("?")[0]
+            res.por_rota[rota] = res.por_rota.get(rota, 0) + 1
+            res.status[status] = res.status.get(status, 0) + 1
+            if status >= 400:
+                res.erro("http_%d" % status)
+            if fechou or not args.keep_alive:
+                if args.keep_alive:
+                    res.fechadas_pelo_servidor += 1
+                escritor.close()
+                escritor = None
+        except asyncio.TimeoutError:
+            res.erro("timeout")
+            escritor = None
+        except (ConnectionError, OSError, ValueError, IndexError, asyncio.IncompleteReadError) as e:
+            res.erro(type(e).__name__)
+            escritor = None
+            await asyncio.sleep(0.05)
+        if args.intervalo:
+            await asyncio.sleep(args.intervalo)
+    if escritor is not None:
+        escritor.close()
+
+
+async def busca_metricas(args):
+    leitor, escritor = await asyncio.wait_for(asyncio.open_connection(args.host, args.porta), args.timeout)
+    escritor.write(("GET /metricas HTTP/1.1\r\nHost: %s\r\nConnection: close\r\n\r\n" % args.host).encode())
+    dados = await asyncio.wait_for(leitor.read(), args.timeout)
+    escritor.close()
+    return json.loads(dados.split(b"\r\n\r\n", 1)[1])
+
+
+async def executa(args):
+    rotas, pesos = interpreta_mix(args.mix, tuple(args.limites.split(",")))
+    res = Resultados()
+    rng = random.Random(args.semente)
+    inicio = time.monotonic()
+    fim = inicio + args.duracao
+    await asyncio.gather(*(cliente(args, rotas, pesos, fim, res, random.Random(rng.random()))
+                           for _ in range(args.concorrencia)))
+    decorrido = time.monotonic() - inicio
+
+    lat = sorted(res.latencias)
+    total = len(lat)
+    erros = sum(res.erros.values())
+    erros_transporte = sum(v for k, v in res.erros.items() if not k.startswith("http_"))
+    relatorio = {
+        "concorrencia": args.concorrencia,
+        "keep_alive": args.keep_alive,
+        "duracao_s": round(decorrido, 2),
+        "requisicoes": total,
+        "req_por_s": round(total / decorrido, 1) if decorrido else 0,
+        "latencia_ms": {
+            "p50": round(percentil(lat, 50), 2),
+            "p90": round(percentil(lat, 90), 2),
+            "p99": round(percentil(lat, 99), 2),
+            "max": round(lat[-1], 2) if lat else 0,
+        },
+        "erros": res.erros,
+        "taxa_erro": round(erros / float(total + erros_transporte), 4) if total + erros_transporte else 0,
+        "status": {str(k): v for k, v in sorted(res.status.items())},
+        "por_rota": res.por_rota,
+        "conexoes": res.conexoes,
+        "fechadas_pelo_servidor": res.fechadas_pelo_servidor,
+    }
+    if not args.sem_metricas:
+        try:
+            metricas = await busca_metricas(args)
+            relatorio["lwip"] = metricas.get("lwip")
+            relatorio["http_servidor"] = metricas.get("http")
+        except Exception as e:  # noqa: BLE001 - relatório segue sem as métricas
+            relatorio["lwip"] = "indisponível (%s)" % e
+    return relatorio
+
+
+def main():
+    ap = argparse.ArgumentParser(description=__doc__, formatter_class=argparse.RawDescriptionHelpFormatter)
+    ap.add_argument("host")
+    ap.add_argument("-p", "--porta", type=int, default=80)
+    ap.add_argument("-c", "--concorrencia", type=int, default=5)
+    ap.add_argument("-d", "--duracao", type=float, default=10.0, help="segundos")
+    ap.add_argument("--mix", default="/=1,/estado=8,/limites=1",
+                    help="rotas e pesos, ex.: \"/=1,/estado=8,/limites=1\"")
+    ap.add_argument("--limites", default="30,70", help="min,max usados em /limites")
+    ap.add_argument("--keep-alive", action="store_true", help="reutiliza conexões quando o servidor permitir")
+    ap.add_argument("--intervalo", type=float, default=0.0, help="pausa por cliente entre requisições (s)")
+    ap.add_argument("--timeout", type=float, default=5.0)
+    ap.add_argument("--semente", type=int, default=1)
+    ap.add_argument("--sem-metricas", action="store_true", help="não consulta /metricas ao final")
+    ap.add_argument("--json", action="store_true", help="saída em JSON")
+    args = ap.parse_args()
+
+    relatorio = asyncio.run(executa(args))
+    if args.json:
+        json.dump(relatorio, sys.stdout, indent=2, ensure_ascii=False)
+        print()
+        return
+
+    lat = relatorio["latencia_ms"]
+    print("Clientes: %d  keep-alive: %s  duração: %.1f s"
+          % (args.concorrencia, "sim" if args.keep_alive else "não", relatorio["duracao_s"]))
+    print("Requisições: %d  (%.1f req/s)" % (relatorio["requisicoes"], relatorio["req_por_s"]))
+    print("Latência ms: p50 %.2f  p90 %.2f  p99 %.2f  máx %.2f" % (lat["p50"], lat["p90"], lat["p99"], lat["max"]))
+    print("Erros: %s  (taxa %.2f%%)" % (relatorio["erros"] or "nenhum", relatorio["taxa_erro"] * 100))
+    print("Status: %s" % relatorio["status"])
+    print("Por rota: %s" % relatorio["por_rota"])
+    if args.keep_alive:
+        print("Conexões: %d  fechadas pelo servidor: %d" % (relatorio["conexoes"], relatorio["fechadas_pelo_servidor"]))
+    if "lwip" in relatorio:
+        print("lwIP: %s" % json.dumps(relatorio["lwip"], ensure_ascii=False))
+
+
+if __name__ == "__main__":
+    main()
@@ -0,0 +1,430 @@
+#!/usr/bin/env python3
+"""
+Gera atlas de fontes proporcionais para o display SSD1306.
+
+O atlas é gravado como um cabeçalho C com os bitmaps já no formato do
+framebuffer (endereçamento vertical): cada coluna do glifo ocupa
+`paginas` bytes consecutivos, bit 0 = linha superior da página. Assim
+o desenho copia páginas inteiras, sem operações por pixel.
+
+Fontes de entrada aceitas:
+  --bdf arquivo.bdf           fonte bitmap BDF
+  --ttf arquivo.ttf --tamanho  fonte TrueType (requer Pillow)
+  --font-h lib/font.h          tabela 8x8 fixa original do projeto
+
+Exemplos (os cabeçalhos em lib/ foram gerados assim):
+  tools/gera_fonte.py --font-h lib/font.h --acentos --kerning \\
+      --nome fonte_texto -o lib/fonte_texto.h
+  tools/gera_fonte.py --ttf /usr/share/fonts/truetype/dejavu/DejaVuSans-Bold.ttf \\
+      --tamanho 20 --caracteres " %-.0123456789" --justa \\
+      --nome fonte_digitos -o lib/fonte_digitos.h
+
+O texto vem da tabela 8x8 do projeto (lib/font.h): os acentos são compostos
+sobre as letras dela e o kerning sai do perfil dos glifos, mantendo o visual
+de antes sem trazer uma fonte de terceiros só para 95 caracteres de 8 px. Os
+dígitos grandes vêm de um TTF de verdade (DejaVu, licença livre que permite
+redistribuir os bitmaps), já que ampliar a 8x8 em 2x só dobra os degraus.
+"""
+
+import argparse
+import os
+import re
+import sys
+
+PRIMEIRO = 0x20
+ULTIMO = 0xFF
+
+
+class Glifo:
+    """Glifo como lista de colunas; cada coluna é um inteiro (bit n = linha n)."""
+
+    def __init__(self, colunas, avanco=None):
+        self.colunas = list(colunas)
+        self.avanco = avanco
+
+    def copia(self):
+        return Glifo(self.colunas, self.avanco)
+
+    def topo(self):
+        tudo = 0
+        for c in self.colunas:
+            tudo |= c
+        if not tudo:
+            return None
+        return (tudo & -tudo).bit_length() - 1
+
+
+# ---------------------------------------------------------------- entradas
+
+def le_font_h(caminho):
+    src = open(caminho, encoding="utf-8").read()
+    dados = [int(x, 16) for x in re.findall(r"0x([0-9A-Fa-f]{2})", src)]
+    glifos = {}
+    for i in range(len(dados) // 8):
+        glifos[0x20 + i] = Glifo(dados[i * 8:(i + 1) * 8])
+    return glifos, 8
+
+
+def le_bdf(caminho):
+    glifos = {}
+    ascent = descent = None
+    cp = None
+    bbx = None
+    dwidth = None
+    linhas = None
+    for linha in open(caminho, encoding="latin-1"):
+        partes = linha.split()
+        if not partes:
+            continue
+        chave = partes[0]
+        if chave == "FONT_ASCENT":
+            ascent = int(partes[1])
+        elif chave == "FONT_DESCENT":
+            descent = int(partes[1])
+        elif chave == "ENCODING":
+            cp = int(partes[1])
+        elif chave == "DWIDTH":
+            dwidth = int(partes[1])
+        elif chave == "BBX":
+            bbx = [int(v) for v in partes[1:5]]
+        elif chave == "BITMAP":
+            linhas = []
+        elif chave == "ENDCHAR":
+            if cp is not None and PRIMEIRO <= cp <= ULTIMO and bbx:
+                w, h, xoff, yoff = bbx
+                largura = max(dwidth or 0, w + max(xoff, 0))
+                colunas = [0] * largura
+                # Linha 0 do glifo = topo da fonte (ascent)
+                topo = ascent - (yoff + h)
+                for r, hexa in enumerate(linhas):
+                    bits = int(hexa, 16)
+                    total = len(hexa) * 4
+                    for c in range(w):
+                        if bits >> (total - 1 - c) & 1:
+                            x = c + max(xoff, 0)
+                            y = topo + r
+                            if 0 <= y < ascent + descent and x < largura:
+                                colunas[x] |= 1 << y
+                glifos[cp] = Glifo(colunas, dwidth)
+            cp, bbx, dwidth, linhas = None, None, None, None
+        elif linhas is not None:
+            linhas.append(chave)
+    if ascent is None or descent is None:
+        sys.exit("BDF sem FONT_ASCENT/FONT_DESCENT")
+    return glifos, ascent + descent
+
+
+def le_ttf(caminho, tamanho):
+    try:
+        from PIL import Image, ImageDraw, ImageFont
+    except ImportError:
+        sys.exit("Leitura de TTF requer Pillow (pip install pillow)")
+    fonte = ImageFont.truetype(caminho, tamanho)
+    ascent, descent = fonte.getmetrics()
+    altura = ascent + descent
+    glifos = {}
+    for cp in range(PRIMEIRO, ULTIMO + 1):
+        ch = chr(cp)
+        avanco = int(round(fonte.getlength(ch)))
+        largura = max(avanco, 1) + 2
+        img = Image.new("1", (largura, altura), 0)
+        ImageDraw.Draw(img).text((0, 0), ch, font=fonte, fill=1)
+        colunas = []
+        for x in range(largura):
+            col = 0
+            for y in range(altura):
+                if img.getpixel((x, y)):
+                    col |= 1 << y
+            colunas.append(col)
+        while colunas and not colunas[-1] and len(colunas) > avanco:
+            colunas.pop()
+        glifos[cp] = Glifo(colunas, avanco)
+
+    def kerning_ttf(esq, dir_):
+        par = fonte.getlength(chr(esq) + chr(dir_))
+        return int(round(par - fonte.getlength(chr(esq)) - fonte.getlength(chr(dir_))))
+
+    return glifos, altura, kerning_ttf
+
+
+# ------------------------------------------------------------ transformações
+
+def escala(glifos, fator):
+    novos = {}
+    for cp, g in glifos.items():
+        colunas = []
+        for c in g.colunas:
+            col = 0
+            for y in range(32):
+                if c >> y & 1:
+                    for k in range(fator):
+                        col |= 1 << (y * fator + k)
+            colunas.extend([col] * fator)
+        novos[cp] = Glifo(colunas, g.avanco * fator if g.avanco else None)
+    return novos
+
+
+# Diacríticos de duas linhas (linha superior, linha inferior), desenhados
+# centralizados acima do glifo base
+DIACRITICOS = {
+    "agudo": ["..#", ".#."],
+    "grave": ["#..", ".#."],
+    "circunflexo": [".#.", "#.#"],
+    "til": [".#.#", "#.#."],
+    "trema": ["#.#", "..."],
+    "anel": [".#.", "#.#"],
+}
+
+# Latin-1 acentuado: código -> (base, diacrítico)
+COMPOSTOS = {}
+for base_mai, base_min, marcas in [
+    ("A", "a", {"grave": 0xC0, "agudo": 0xC1, "circunflexo": 0xC2, "til": 0xC3, "trema": 0xC4, "anel": 0xC5}),
+    ("E", "e", {"grave": 0xC8, "agudo": 0xC9, "circunflexo": 0xCA, "trema": 0xCB}),
+    ("I", "i", {"grave": 0xCC, "agudo": 0xCD, "circunflexo": 0xCE, "trema": 0xCF}),
+    ("N", "n", {"til": 0xD1}),
+    ("O", "o", {"grave": 0xD2, "agudo": 0xD3, "circunflexo": 0xD4, "til": 0xD5, "trema": 0xD6}),
+    ("U", "u", {"grave": 0xD9, "agudo": 0xDA, "circunflexo": 0xDB, "trema": 0xDC}),
+    ("Y", "y", {"agudo": 0xDD}),
+]:
+    for marca, cp in marcas.items():
+        COMPOSTOS[cp] = (ord(base_mai), marca)
+        COMPOSTOS[cp + 0x20] = (ord(base_min), marca)
+COMPOSTOS[0xFF] = (ord("y"), "trema")
+
+
+def sem_ponto(g, topo_minuscula):
+    """Remove o pingo de i/j (tudo acima da altura-x)."""
+    mascara = ~((1 << topo_minuscula) - 1)
+    return Glifo([c & mascara for c in g.colunas], g.avanco)
+
+
+def aplica_diacritico(g, marca, topo):
+    padrao = DIACRITICOS[marca]
+    largura_marca = len(padrao[0])
+    tinta = [i for i, c in enumerate(g.colunas) if c]
+    centro = (tinta[0] + tinta[-1]) // 2 if tinta else len(g.colunas) // 2
+    x0 = max(centro - largura_marca // 2, 0)
+    novo = g.copia()
+    for linha, texto in enumerate(padrao):
+        y = topo - 3 + linha
+        for i, ch in enumerate(texto):
+            if ch == "#" and 0 <= y:
+                x = x0 + i
+                while x >= len(novo.colunas):
+                    novo.colunas.append(0)
+                novo.colunas[x] |= 1 << y
+    return novo
+
+
+def gera_acentos(glifos, altura):
+    """Desloca tudo 3 linhas para baixo e compõe os acentos Latin-1."""
+    deslocamento = 3
+    base = {cp: Glifo([c << deslocamento for c in g.colunas], g.avanco) for cp, g in glifos.items()}
+    topo_minuscula = base[ord("n")].topo()
+    for cp, (cp_base, marca) in COMPOSTOS.items():
+        if cp_base not in base:
+            continue
+        g = base[cp_base]
+        if cp_base in (ord("i"), ord("j")):
+            g = sem_ponto(g, topo_minuscula)
+        topo = g.topo()
+        if topo is None:
+            continue
+        base[cp] = aplica_diacritico(g, marca, topo)
+
+    # Ç / ç: gancho abaixo da linha de base
+    for cp, cp_base in ((0xC7, ord("C")), (0xE7, ord("c"))):
+        if cp_base in base:
+            g = base[cp_base].copia()
+            fundo = max(c.bit_length() for c in g.colunas) - 1
+            tinta = [i for i, c in enumerate(g.colunas) if c]
+            centro = (tinta[0] + tinta[-1]) // 2
+            g.colunas[centro] |= 1 << (fundo + 1)
+            g.colunas[centro - 1] |= 1 << (fundo + 2)
+            base[cp] = g
+
+    # Sinal de grau e indicadores ordinais (º ª), na altura das maiúsculas
+    base[0xB0] = Glifo([c << deslocamento for c in (0x06, 0x09, 0x09, 0x06)])
+    base[0xBA] = Glifo([c << deslocamento for c in (0x26, 0x29, 0x29, 0x26)])
+    base[0xAA] = Glifo([c << deslocamento for c in (0x24, 0x2A, 0x2A, 0x2E)])
+    return base, altura + 4
+
+
+def ajusta_altura(glifos):
+    """Remove as linhas vazias acima e abaixo de todos os glifos do atlas."""
+    tudo = 0
+    for g in glifos.values():
+        for c in g.colunas:
+            tudo |= c
+    if not tudo:
+        return glifos, 1
+    topo = (tudo & -tudo).bit_length() - 1
+    altura = tudo.bit_length() - topo
+    return {cp: Glifo([c >> topo for c in g.colunas], g.avanco) for cp, g in glifos.items()}, altura
+
+
+def recorta(glifos, espaco):
+    """Remove colunas vazias nas bordas e calcula o avanço proporcional."""
+    resultado = {}
+    for cp, g in glifos.items():
+        colunas = list(g.colunas)
+        while colunas and not colunas[0]:
+            colunas.pop(0)
+        while colunas and not colunas[-1]:
+            colunas.pop()
+        if not colunas:
+            resultado[cp] = Glifo([], espaco)
+        else:
+            resultado[cp] = Glifo(colunas, len(colunas) + 1)
+    return resultado
+
+
+def calcula_kerning(glifos, altura, caracteres):
+    """
+    Kerning automático: aproxima o par em 1 coluna quando, em todas as linhas
+    (e vizinhas), o espaço livre entre os perfis é de pelo menos 3 colunas.
+    """
+    def perfil(g, direita):
+        p = []
+        for y in range(altura):
+            xs = [x for x, c in enumerate(g.colunas) if c >> y & 1]
+            if not xs:
+                p.append(None)
+            elif direita:
+                p.append(len(g.colunas) - 1 - xs[-1])
+            else:
+                p.append(xs[0])
+        return p
+
+    pares = []
+    cps = [ord(c) for c in caracteres if ord(c) in glifos and glifos[ord(c)].colunas]
+    perfis_dir = {cp: perfil(glifos[cp], True) for cp in cps}
+    perfis_esq = {cp: perfil(glifos[cp], False) for cp in cps}
+    for a in cps:
+        for b in cps:
+            folga_min = None
+            for y in range(altura):
+                for dy in (-1, 0, 1):
+                    y2 = y + dy
+                    if not 0 <= y2 < altura:
+                        continue
+                    pa, pb = perfis_dir[a][y], perfis_esq[b][y2]
+                    if pa is None or pb is None:
+                        continue
+                    folga = pa + pb
+                    folga_min = folga if folga_min is None else min(folga_min, folga)
+            if folga_min is not None and folga_min >= 3:
+                pares.append((a, b, -1))
+    return pares
+
+
+# ------------------------------------------------------------------- saída
+
+def escreve_cabecalho(caminho, nome, glifos, altura, kerning, fonte_origem):
+    paginas = (altura + 7) // 8
+    bitmap = []
+    entradas = []
+    for cp in range(PRIMEIRO, ULTIMO + 1):
+        g = glifos.get(cp)
+        if g is None:
+            entradas.append((0, 0, 0, cp))
+            continue
+        offset = len(bitmap)
+        for c in g.colunas:
+            for p in range(paginas):
+                bitmap.append((c >> (8 * p)) & 0xFF)
+        entradas.append((offset, len(g.colunas), g.avanco, cp))
+
+    guarda = nome.upper() + "_H"
+    with open(caminho, "w", encoding="utf-8") as f:
+        f.write("// Gerado por tools/gera_fonte.py a partir de %s. Não editar à mão.\n" % fonte_origem)
+        f.write("#ifndef %s\n#define %s\n\n#include \"texto.h\"\n\n" % (guarda, guarda))
+        f.write("static const uint8_t %s_bitmap[] = {\n" % nome)
+        for i in range(0, len(bitmap), 16):
+            f.write("    " + ", ".join("0x%02X" % b for b in bitmap[i:i + 16]) + ",\n")
+        f.write("};\n\n")
+        f.write("static const texto_glifo_t %s_glifos[] = {\n" % nome)
+        for offset, largura, avanco, cp in entradas:
+            # Barra invertida no fim de um comentário // continuaria a linha em C
+            rotulo = chr(cp) if (cp < 0x7F or cp >= 0xA0) and cp != 0x5C else ""
+            f.write(("    {%5d, %2d, %2d},  // U+%04X %s" % (offset, largura, avanco, cp, rotulo)).rstrip() + "\n")
+        f.write("};\n\n")
+        if kerning:
+            f.write("static const texto_kerning_t %s_kerning[] = {\n" % nome)
+            for a, b, aj in sorted(kerning):
+                f.write("    {0x%02X, 0x%02X, %d},\n" % (a, b, aj))
+            f.write("};\n\n")
+        f.write("static const texto_fonte_t %s = {\n" % nome)
+        f.write("    .altura = %d,\n    .paginas = %d,\n" % (altura, paginas))
+        f.write("    .primeiro = 0x%02X,\n    .ultimo = 0x%02X,\n" % (PRIMEIRO, ULTIMO))
+        f.write("    .glifos = %s_glifos,\n    .bitmap = %s_bitmap,\n" % (nome, nome))
+        if kerning:
+            f.write("    .kerning = %s_kerning,\n    .num_kerning = %d,\n" % (nome, len(kerning)))
+        else:
+            f.write("    .kerning = 0,\n    .num_kerning = 0,\n")
+        f.write("};\n\n#endif // %s\n" % guarda)
+    return len(bitmap), len(kerning)
+
+
+def main():
+    ap = argparse.ArgumentParser(description=__doc__, formatter_class=argparse.RawDescriptionHelpFormatter)
+    origem = ap.add_mutually_exclusive_group(required=True)
+    origem.add_argument("--bdf")
+    origem.add_argument("--ttf")
+    origem.add_argument("--font-h")
+    ap.add_argument("--tamanho", type=int, default=12, help="tamanho em px para TTF")
+    ap.add_argument("--nome", required=True, help="nome da variável C")
+    ap.add_argument("--escala", type=int, default=1)
+    ap.add_argument("--acentos", action="store_true", help="compõe os acentos Latin-1 a partir das letras base")
+    ap.add_argument("--kerning", action="store_true", help="gera pares de kerning")
+    ap.add_argument("--caracteres", help="restringe o atlas a estes caracteres")
+    ap.add_argument("--justa", action="store_true", help="corta as linhas vazias comuns a todos os glifos")
+    ap.add_argument("--espaco", type=int, default=3, help="avanço de glifos vazios (espaço)")
+    ap.add_argument("-o", "--saida", required=True)
+    args = ap.parse_args()
+
+    kerning_ttf = None
+    if args.bdf:
+        glifos, altura = le_bdf(args.bdf)
+        fonte_origem = os.path.basename(args.bdf)
+    elif args.ttf:
+        glifos, altura, kerning_ttf = le_ttf(args.ttf, args.tamanho)
+        fonte_origem = os.path.basename(args.ttf)
+    else:
+        glifos, altura = le_font_h(args.font_h)
+        fonte_origem = args.font_h
+
+    if args.acentos:
+        glifos, altura = gera_acentos(glifos, altura)
+    if args.escala > 1:
+        glifos = escala(glifos, args.escala)
+        altura *= args.escala
+        args.espaco *= args.escala
+    if args.caracteres:
+        glifos = {cp: g for cp, g in glifos.items() if chr(cp) in args.caracteres}
+    if args.justa:
+        glifos, altura = ajusta_altura(glifos)
+    if altura > 32:
+        sys.exit("Altura máxima suportada é 32 px (4 páginas)")
+    if not args.ttf:
+        glifos = recorta(glifos, args.espaco)
+
+    kerning = []
+    if args.kerning:
+        if kerning_ttf:
+            for a in glifos:
+                for b in glifos:
+                    aj = kerning_ttf(a, b)
+                    if aj:
+                        kerning.append((a, b, aj))
+        else:
+            alvo = "".join(chr(c) for c in range(0x21, 0x7F))
+            kerning = calcula_kerning(glifos, altura, alvo)
+
+    tam, pares = escreve_cabecalho(args.saida, args.nome, glifos, altura, kerning, fonte_origem)
+    print("%s: %d glifos, %d px de altura, %d bytes de bitmap, %d pares de kerning"
+          % (args.saida, len(glifos), altura, tam, pares))
+
+
+if __name__ == "__main__":
+    main()
@@ -0,0 +1,226 @@
+#!/usr/bin/env python3
+"""
+Gera o corpus de gravações do sensor em traces/ para os testes de regressão
+do tools/reproduz.c.
+
+Cada cenário simula o reservatório (consumo, enchimento, ruído de ±2 LSB no
+ADC) com uma semente fixa e grava no formato do firmware: log da USB
+("NVL <ms> <adc>" e "NVL ACK <ms>") ou binário .nvl (lib/controle.h). O
+manifesto traces/corpus.txt lista cada gravação com os argumentos do
+reprodutor; com --reproduz, o resumo de cada uma é gravado em
+traces/<nome>.esperado, que o teste do host compara com a saída atual.
+
+Regenere os resumos só quando uma mudança de comportamento for intencional:
+  tools/gera_tracos.py --reproduz _gate_build/reproduz
+"""
+
+import argparse
+import calendar
+import os
+import random
+import struct
+import subprocess
+import sys
+
+ADC_VAZIO = 2680
+ADC_CHEIO = 2040
+LACUNA = 0xFFFF
+RECONHECE = 0xFFFE
+
+
+class Tanque:
+    """
+    Reservatório com bomba por histerese, como o firmware sem agenda: a bomba
+    decide pela leitura com ruído, como a réplica, e vale até a amostra seguinte.
+    """
+
+    def __init__(self, rnd, nivel, lim_min, lim_max, enchimento):
+        self.rnd = rnd
+        self.nivel = nivel
+        self.lim_min = lim_min
+        self.lim_max = lim_max
+        self.enchimento = enchimento  # %/s com a bomba ligada
+        self.bomba = False
+        self.seco = False             # Bomba ligada sem água na entrada
+
+    def le(self):
+        adc = int(round(ADC_VAZIO + (ADC_CHEIO - ADC_VAZIO) * self.nivel / 100.0)) + self.rnd.randint(-2, 2)
+        medido = (ADC_VAZIO - adc) * 100.0 / (ADC_VAZIO - ADC_CHEIO)
+        if medido < self.lim_min:
+            self.bomba = True
+        elif medido > self.lim_max:
+            self.bomba = False
+        return adc
+
+    def passo(self, dt_s, consumo):
+        entrada = self.enchimento if self.bomba and not self.seco else 0.0
+        self.nivel = min(100.0, max(0.0, self.nivel + (entrada - consumo) * dt_s))
+
+
+def normal(rnd):
+    """30 min a 500 ms, ciclos normais e um reconhecimento sem falha."""
+    tq = Tanque(rnd, 50.0, 30.0, 70.0, 0.12)
+    linhas = []
+    t_ms = 1000
+    for i in range(3600):
+        if i == 1800:
+            linhas.append("NVL ACK %d" % t_ms)
+        if i % 600 == 0:
+            linhas.append("Wi-Fi: conectado")  # Outras mensagens da USB
+        linhas.append("NVL %d %d" % (t_ms, tq.le()))
+        tq.passo(0.5, 0.02)
+        t_ms += 500
+    return linhas
+
+
+def sensor_travado(rnd):
+    """Leitura congelada por 7 min (estado seguro) e um salto implausível."""
+    tq = Tanque(rnd, 45.0, 30.0, 70.0, 0.12)
+    amostras = []
+    t_ms = 0
+    congelada = None
+    for i in range(4800):
+        adc = tq.le()
+        tq.passo(0.5, 0.02)
+        if 1200 <= i < 2040:
+            congelada = congelada or adc
+            adc = congelada
+        if i == 3000:
+            adc -= 200  # Interferência: 30% em meio segundo
+        amostras.append((t_ms, adc))
+        t_ms += 500
+    return amostras
+
+
+def bomba_seco(rnd):
+    """Entrada sem água com a bomba ligada; o operador reconhece depois."""
+    tq = Tanque(rnd, 32.0, 30.0, 70.0, 0.12)
+    amostras = []
+    t_ms = 0
+    for i in range(3600):
+        tq.seco = 200 <= i < 1400
+        if i == 1500:
+            amostras.append((t_ms, RECONHECE))
+        amostras.append((t_ms, tq.le()))
+        if tq.seco and i >= 400:
+            tq.bomba = False  # Falha detectada: o firmware desligou até o reconhecimento
+        tq.passo(0.5, 0.01)
+        t_ms += 500
+    return amostras
+
+
+def tarifa(rnd):
+    """
+    8 dias a 60 s a partir de uma segunda-feira, com consumo maior de manhã e
+    à noite e uma lacuna. A gravação não fecha o laço com o reprodutor: para
+    que a bomba da réplica (ligada mais cedo pela agenda) encontre o nível
+    subindo, o tanque gravado pré-enche das 14h às 17h dos dias úteis, as
+    horas baratas finais em que a agenda eleva o mínimo.
+    """
+    tq = Tanque(rnd, 60.0, 30.0, 70.0, 0.06)
+    amostras = []
+    t_ms = 0
+    for i in range(8 * 24 * 60):
+        hora = (i // 60) % 24
+        dia = (i // 1440) % 7  # 0 = segunda-feira
+        consumo = 8.0 if hora in (6, 7, 8, 19, 20, 21) else (1.0 if hora < 6 else 3.0)
+        tq.lim_min = 65.0 if dia < 5 and 14 <= hora < 17 else 30.0
+        adc = tq.le()
+        tq.passo(60.0, consumo / 3600.0)
+        if not 3 * 1440 + 600 <= i < 3 * 1440 + 620:
+            amostras.append((t_ms, adc))  # Fora da lacuna (intervalo maior que 65535 ms)
+        t_ms += 60000
+    return amostras
+
+
+def mes(rnd):
+    """
+    30 dias a 60 s a partir de uma segunda-feira, com a histerese pura, para
+    a simulação da agenda (reproduz --simula): consumo maior de manhã e na
+    ponta da noite, manhã mais tarde no fim de semana e cada dia com uma
+    escala própria.
+    """
+    tq = Tanque(rnd, 55.0, 30.0, 70.0, 0.06)
+    amostras = []
+    t_ms = 0
+    escala = 1.0
+    for i in range(30 * 24 * 60):
+        hora = (i // 60) % 24
+        dia = (i // 1440) % 7  # 0 = segunda-feira
+        if i % 1440 == 0:
+            escala = rnd.uniform(0.8, 1.2)
+        manha = (8, 9, 10) if dia >= 5 else (6, 7, 8)
+        if hora in manha:
+            consumo = 9.0
+        elif 18 <= hora < 22:
+            consumo = 10.0
+        elif hora < 6:
+            consumo = 1.0
+        else:
+            consumo = 3.0
+        amostras.append((t_ms, tq.le()))
+        tq.passo(60.0, escala * consumo / 3600.0)
+        t_ms += 60000
+    return amostras
+
+
+def grava_nvl(caminho, amostras):
+    with open(caminho, "wb") as f:
+        f.write(b"NVL1")
+        anterior = amostras[0][0]
+        f.write(struct.pack("<I", anterior))
+        for t_ms, adc in amostras:
+            dt = t_ms - anterior
+            while dt > 0xFFFF:
+                f.write(struct.pack("<HH", 0xFFFF, LACUNA))
+                dt -= 0xFFFF
+            f.write(struct.pack("<HH", dt, adc))
+            anterior = t_ms
+
+
+# Segunda-feira, 2 de março de 2026, 0h em UTC-3
+EPOCA_SEGUNDA = calendar.timegm((2026, 3, 2, 3, 0, 0))
+
+CENARIOS = [
+    ("normal.txt", normal, ""),
+    ("sensor_travado.nvl", sensor_travado, ""),
+    ("bomba_seco.nvl", bomba_seco, ""),
+    ("tarifa.nvl", tarifa, "--epoca %d" % EPOCA_SEGUNDA),
+    ("tarifa_sem_hora.nvl", tarifa, ""),
+    ("mes.nvl", mes, "--epoca %d --simula 0.06" % EPOCA_SEGUNDA),
+]
+
+
+def main():
+    ap = argparse.ArgumentParser(description=__doc__, formatter_class=argparse.RawDescriptionHelpFormatter)
+    ap.add_argument("-d", "--destino", default=os.path.join(os.path.dirname(__file__), "..", "traces"))
+    ap.add_argument("--reproduz", help="executável do reprodutor para gravar os resumos esperados")
+    args = ap.parse_args()
+
+    os.makedirs(args.destino, exist_ok=True)
+    manifesto = ["# gravacao [argumentos do reproduz]; resumo esperado em <nome>.esperado"]
+    for arquivo, gera, argumentos in CENARIOS:
+        dados = gera(random.Random(arquivo))
+        caminho = os.path.join(args.destino, arquivo)
+        if arquivo.endswith(".txt"):
+            with open(caminho, "w") as f:
+                f.write("\n".join(dados) + "\n")
+        else:
+            grava_nvl(caminho, dados)
+        manifesto.append(("%s %s" % (arquivo, argumentos)).strip())
+
+        if args.reproduz:
+            saida = subprocess.run([args.reproduz] + argumentos.split() + [caminho],
+                                   check=True, capture_output=True, text=True).stdout
+            nome = os.path.splitext(arquivo)[0]
+            with open(os.path.join(args.destino, nome + ".esperado"), "w") as f:
+                f.write(saida)
+            print("%s:\n%s" % (arquivo, saida))
+
+    with open(os.path.join(args.destino, "corpus.txt"), "w") as f:
+        f.write("\n".join(manifesto) + "\n")
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
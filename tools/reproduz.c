@@ -0,0 +1,431 @@
+/**
+ * Reprodutor de gravações do sensor: passa as leituras brutas do ADC pelo
+ * mesmo passo de controle do firmware (controle_amostra em lib/controle.c:
+ * conversão, diagnóstico, agenda de tarifas e decisão da bomba), aplica os
+ * reconhecimentos do operador gravados, sem esperar o tempo real, e resume o
+ * comportamento. O resumo é comparado com traces/ nos testes do host.
+ *
+ * Compilação (no host):
+ *   cc -O2 -Ilib -o reproduz tools/reproduz.c lib/controle.c lib/diagnostico.c \
+ *      lib/agenda.c lib/alarme.c -lm
+ *
+ * Uso:
+ *   reproduz [--min 30] [--max 70] [--epoca s] [--fuso h] [-v] [-o saida.nvl] gravacao
+ *   reproduz --simula enchimento --epoca s [--potencia kW] [--min 30] [--max 70] gravacao
+ *
+ * A gravação pode ser o log da USB (linhas "NVL <ms> <adc>" e "NVL ACK <ms>",
+ * geradas após enviar 'g' ao dispositivo) ou o formato binário .nvl descrito
+ * em lib/controle.h; -o converte o que foi lido para .nvl. --epoca é a hora
+ * UTC (s desde 1970) da primeira amostra: sem ela não há hora de parede e a
+ * agenda não aprende, como no firmware antes do SNTP. --fuso é o da tabela
+ * de tarifas (padrão -3).
+ *
+ * --simula fecha a malha sobre uma gravação feita com a histerese pura nos
+ * mesmos limites: o consumo, o ruído e os reconhecimentos são os gravados e
+ * o nível simulado difere do gravado só pela água que a bomba simulada põe a
+ * mais ou a menos (enchimento em %/s com a bomba ligada). A histerese e a
+ * agenda de tarifas rodam assim sobre o mesmo mês e o resumo compara as
+ * partidas da bomba, a energia em cada posto da tarifa branca e o custo.
+ */
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "controle.h"
+#include "diagnostico.h"
+
+typedef struct {
+    uint32_t t_ms;
+    uint16_t adc;
+    bool reconhece;  // Reconhecimento do operador antes desta amostra
+} amostra_t;
+
+typedef struct {
+    amostra_t *itens;
+    size_t n;
+    size_t capacidade;
+    bool reconhece;  // Reconhecimento lido, aplicado à próxima amostra
+} gravacao_t;
+
+static void adiciona(gravacao_t *g, uint32_t t_ms, uint16_t adc) {
+    if (g->n == g->capacidade) {
+        g->capacidade = g->capacidade ? 2 * g->capacidade : 1024;
+        g->itens = realloc(g->itens, g->capacidade * sizeof(amostra_t));
+        if (!g->itens) {
+            fprintf(stderr, "memória insuficiente\n");
+            exit(1);
+        }
+    }
+    g->itens[g->n].t_ms = t_ms;
+    g->itens[g->n].adc = adc;
+    g->itens[g->n].reconhece = g->reconhece;
+    g->reconhece = false;
+    g->n++;
+}
+
+static uint16_t le_u16(const uint8_t *p) {
+    return (uint16_t)(p[0] | (p[1] << 8));
+}
+
+static uint32_t le_u32(const uint8_t *p) {
+    return (uint32_t)p[0] | ((uint32_t)p[1] << 8) | ((uint32_t)p[2] << 16) | ((uint32_t)p[3] << 24);
+}
+
+static void escreve_u16(FILE *f, uint16_t v) {
+    fputc(v & 0xFF, f);
+    fputc(v >> 8, f);
+}
+
+static void escreve_u32(FILE *f, uint32_t v) {
+    escreve_u16(f, v & 0xFFFF);
+    escreve_u16(f, v >> 16);
+}
+
+static bool carrega_binario(FILE *f, gravacao_t *g) {
+    uint8_t buf[4];
+    if (fread(buf, 1, 4, f) != 4 || memcmp(buf, CONTROLE_NVL_ASSINATURA, 4) != 0) {
+        return false;
+    }
+    if (fread(buf, 1, 4, f) != 4) {
+        return false;
+    }
+    // A primeira amostra tem intervalo 0: ocorre no instante do cabeçalho
+    uint32_t t_ms = le_u32(buf);
+    while (fread(buf, 1, 4, f) == 4) {
+        t_ms += le_u16(buf);
+        uint16_t adc = le_u16(buf + 2);
+        if (adc == CONTROLE_NVL_LACUNA) {
+            continue;
+        }
+        if (adc == CONTROLE_NVL_RECONHECE) {
+            g->reconhece = true;
+            continue;
+        }
+        adiciona(g, t_ms, adc);
+    }
+    return true;
+}
+
+static void carrega_texto(FILE *f, gravacao_t *g) {
+    char linha[128];
+    while (fgets(linha, sizeof(linha), f)) {
+        unsigned long t_ms;
+        unsigned adc;
+        // Outras mensagens da USB podem estar intercaladas e são ignoradas
+        const char *p = strstr(linha, "NVL ");
+        if (p && sscanf(p, "NVL ACK %lu", &t_ms) == 1) {
+            g->reconhece = true;
+        } else if (p && sscanf(p, "NVL %lu %u", &t_ms, &adc) == 2 && adc < CONTROLE_NVL_RECONHECE) {
+            adiciona(g, (uint32_t)t_ms, (uint16_t)adc);
+        }
+    }
+}
+
+static bool salva_binario(const char *caminho, const gravacao_t *g) {
+    FILE *f = fopen(caminho, "wb");
+    if (!f) {
+        return false;
+    }
+    fwrite(CONTROLE_NVL_ASSINATURA, 1, 4, f);
+    uint32_t anterior = g->n ? g->itens[0].t_ms : 0;
+    escreve_u32(f, anterior);
+    for (size_t i = 0; i < g->n; i++) {
+        uint32_t dt = g->itens[i].t_ms - anterior;
+        while (dt > 0xFFFF) {
+            escreve_u16(f, 0xFFFF);
+            escreve_u16(f, CONTROLE_NVL_LACUNA);
+            dt -= 0xFFFF;
+        }
+        if (g->itens[i].reconhece) {
+            escreve_u16(f, (uint16_t)dt);
+            escreve_u16(f, CONTROLE_NVL_RECONHECE);
+            dt = 0;
+        }
+        escreve_u16(f, (uint16_t)dt);
+        escreve_u16(f, g->itens[i].adc);
+        anterior = g->itens[i].t_ms;
+    }
+    return fclose(f) == 0;
+}
+
+// ===== Simulação em malha fechada (--simula) =====
+
+// Postos da tarifa branca e preço de referência (R$/kWh); na comparação só
+// a razão entre eles importa
+typedef enum { FORA_PONTA, INTERMEDIARIO, PONTA, NUM_POSTOS } posto_t;
+static const char *const NOMES_POSTOS[NUM_POSTOS] = {"fora de ponta", "intermediario", "ponta"};
+static const double PRECO_KWH[NUM_POSTOS] = {0.63, 0.91, 1.44};
+
+// Ponta das 18h às 21h dos dias úteis, intermediário na hora antes e depois
+static posto_t posto(uint32_t epoca_s, int32_t fuso_s) {
+    uint32_t local = epoca_s + (uint32_t)fuso_s;
+    uint32_t hora = local / 3600 % 24;
+    uint32_t dia = (local / 86400 + 4) % 7;  // 01/01/1970 foi quinta-feira; 0 = domingo
+    if (dia == 0 || dia == 6) {
+        return FORA_PONTA;
+    }
+    if (hora >= 18 && hora < 21) {
+        return PONTA;
+    }
+    return hora == 17 || hora == 21 ? INTERMEDIARIO : FORA_PONTA;
+}
+
+typedef struct {
+    uint32_t partidas;
+    double horas_ligada[NUM_POSTOS];
+    float nivel_min;     // Leitura do nível simulado, como o controle a vê
+    double t_abaixo_s;   // Leitura abaixo de lim_min
+    double t_seguro_s;
+    uint8_t horas_aprendidas;
+} simulacao_t;
+
+// Estado da bomba em cada amostra da gravação, pela histerese pura
+static bool *bomba_gravada(const gravacao_t *g, float lim_min, float lim_max) {
+    bool *bomba = malloc(g->n * sizeof(bool));
+    if (!bomba) {
+        fprintf(stderr, "memória insuficiente\n");
+        exit(1);
+    }
+    diagnostico_init(NULL);
+    agenda_t agenda;
+    agenda_init(&agenda, agenda_tarifa_branca, agenda_tarifa_branca_num, AGENDA_FUSO_PADRAO_S);
+    controle_t c = {0};
+    for (size_t i = 0; i < g->n; i++) {
+        if (g->itens[i].reconhece) {
+            controle_reconhece();
+        }
+        controle_amostra(&c, &agenda, g->itens[i].t_ms, g->itens[i].adc, NULL, lim_min, lim_max);
+        bomba[i] = c.bomba_ligada;
+    }
+    return bomba;
+}
+
+/**
+ * Roda o controle (com a agenda se `epoca_s` não for NULL) sobre o
+ * reservatório simulado: a cada amostra, a leitura gravada é deslocada pela
+ * diferença acumulada entre a água bombeada na simulação e na gravação.
+ */
+static void simula(const gravacao_t *g, const bool *gravada, float enchimento, uint32_t epoca0_s,
+                   const uint32_t *epoca_s, int32_t fuso_s, float lim_min, float lim_max, simulacao_t *r) {
+    const float lsb_por_ponto = (CONTROLE_ADC_CHEIO - CONTROLE_ADC_VAZIO) / 100.0f;
+    diagnostico_init(NULL);
+    agenda_t agenda;
+    agenda_init(&agenda, agenda_tarifa_branca, agenda_tarifa_branca_num, fuso_s);
+    controle_t c = {0};
+    float desvio = 0.0f;  // Nível simulado menos o gravado (%)
+    *r = (simulacao_t){.nivel_min = 100.0f};
+
+    for (size_t i = 0; i < g->n; i++) {
+        const amostra_t *a = &g->itens[i];
+        if (a->reconhece) {
+            controle_reconhece();
+        }
+        // O reservatório simulado não transborda nem fica abaixo do vazio
+        float nivel_gravado = controle_nivel_percentual(a->adc);
+        if (nivel_gravado + desvio > 100.0f) {
+            desvio = 100.0f - nivel_gravado;
+        } else if (nivel_gravado + desvio < 0.0f) {
+            desvio = -nivel_gravado;
+        }
+        uint16_t adc = (uint16_t)(a->adc + lroundf(desvio * lsb_por_ponto));
+        uint32_t agora_s = epoca0_s + (a->t_ms - g->itens[0].t_ms) / 1000;
+
+        bool estava_ligada = c.bomba_ligada;
+        controle_amostra(&c, &agenda, a->t_ms, adc, epoca_s ? &agora_s : NULL, lim_min, lim_max);
+        if (c.bomba_ligada && !estava_ligada) {
+            r->partidas++;
+        }
+
+        double dt_s = i + 1 < g->n ? (g->itens[i + 1].t_ms - a->t_ms) / 1000.0 : 0.0;
+        if (c.bomba_ligada) {
+            r->horas_ligada[posto(agora_s, fuso_s)] += dt_s / 3600.0;
+        }
+        if (c.nivel < r->nivel_min) {
+            r->nivel_min = c.nivel;
+        }
+        if (c.nivel < lim_min) {
+            r->t_abaixo_s += dt_s;
+        }
+        if (diagnostico_estado_seguro()) {
+            r->t_seguro_s += dt_s;
+        }
+        desvio += (float)(((int)c.bomba_ligada - (int)gravada[i]) * enchimento * dt_s);
+    }
+    r->horas_aprendidas = agenda_horas_aprendidas(&agenda);
+}
+
+static double custo(const simulacao_t *r, float potencia_kw) {
+    double total = 0.0;
+    for (int p = 0; p < NUM_POSTOS; p++) {
+        total += r->horas_ligada[p] * potencia_kw * PRECO_KWH[p];
+    }
+    return total;
+}
+
+static void simula_e_compara(const gravacao_t *g, float enchimento, float potencia_kw, uint32_t epoca_s,
+                             int32_t fuso_s, float lim_min, float lim_max) {
+    bool *gravada = bomba_gravada(g, lim_min, lim_max);
+    simulacao_t r[2];
+    simula(g, gravada, enchimento, epoca_s, NULL, fuso_s, lim_min, lim_max, &r[0]);
+    simula(g, gravada, enchimento, epoca_s, &epoca_s, fuso_s, lim_min, lim_max, &r[1]);
+    free(gravada);
+
+    uint32_t duracao_ms = g->itens[g->n - 1].t_ms - g->itens[0].t_ms;
+    printf("amostras:           %zu\n", g->n);
+    printf("duracao:            %.1f s\n", duracao_ms / 1000.0);
+    printf("limites:            %.1f%% a %.1f%%\n", lim_min, lim_max);
+    printf("bomba:              %.3f%%/s, %.2f kW\n", enchimento, potencia_kw);
+    printf("%-20s%12s%12s\n", "", "histerese", "agenda");
+    printf("%-20s%12lu%12lu\n", "partidas:", (unsigned long)r[0].partidas, (unsigned long)r[1].partidas);
+    for (int p = 0; p < NUM_POSTOS; p++) {
+        char nome[32];
+        snprintf(nome, sizeof(nome), "kWh %s:", NOMES_POSTOS[p]);
+        printf("%-20s%12.2f%12.2f\n", nome, r[0].horas_ligada[p] * potencia_kw, r[1].horas_ligada[p] * potencia_kw);
+    }
+    printf("%-20s%12.2f%12.2f\n", "custo (R$):", custo(&r[0], potencia_kw), custo(&r[1], potencia_kw));
+    printf("%-20s%12.1f%12.1f\n", "nivel minimo (%):", r[0].nivel_min, r[1].nivel_min);
+    printf("%-20s%12.1f%12.1f\n", "abaixo do min. (s):", r[0].t_abaixo_s, r[1].t_abaixo_s);
+    printf("%-20s%12.1f%12.1f\n", "estado seguro (s):", r[0].t_seguro_s, r[1].t_seguro_s);
+    printf("%-20s%12u%12u\n", "horas aprendidas:", r[0].horas_aprendidas, r[1].horas_aprendidas);
+}
+
+int main(int argc, char **argv) {
+    float lim_min = 30.0f;
+    float lim_max = 70.0f;
+    bool tem_epoca = false;
+    uint32_t epoca_s = 0;
+    int32_t fuso_s = AGENDA_FUSO_PADRAO_S;
+    bool verboso = false;
+    float enchimento = 0.0f;
+    float potencia_kw = 0.37f;  // Bomba de 1/2 cv
+    const char *entrada = NULL;
+    const char *saida = NULL;
+
+    for (int i = 1; i < argc; i++) {
+        if (!strcmp(argv[i], "--min") && i + 1 < argc) {
+            lim_min = strtof(argv[++i], NULL);
+        } else if (!strcmp(argv[i], "--max") && i + 1 < argc) {
+            lim_max = strtof(argv[++i], NULL);
+        } else if (!strcmp(argv[i], "--epoca") && i + 1 < argc) {
+            epoca_s = (uint32_t)strtoul(argv[++i], NULL, 10);
+            tem_epoca = true;
+        } else if (!strcmp(argv[i], "--fuso") && i + 1 < argc) {
+            fuso_s = (int32_t)(strtof(argv[++i], NULL) * 3600.0f);
+        } else if (!strcmp(argv[i], "--simula") && i + 1 < argc) {
+            enchimento = strtof(argv[++i], NULL);
+        } else if (!strcmp(argv[i], "--potencia") && i + 1 < argc) {
+            potencia_kw = strtof(argv[++i], NULL);
+        } else if (!strcmp(argv[i], "-o") && i + 1 < argc) {
+            saida = argv[++i];
+        } else if (!strcmp(argv[i], "-v")) {
+            verboso = true;
+        } else if (argv[i][0] != '-' && !entrada) {
+            entrada = argv[i];
+        } else {
+            entrada = NULL;
+            break;
+        }
+    }
+    if (!entrada || !(lim_min >= 0.0f && lim_max <= 100.0f && lim_min < lim_max) || enchimento < 0.0f ||
+        (enchimento > 0.0f && !tem_epoca)) {
+        fprintf(stderr,
+                "uso: %s [--min 30] [--max 70] [--epoca s] [--fuso h] [-v] [-o saida.nvl] gravacao\n"
+                "     %s --simula enchimento --epoca s [--potencia kW] [--min 30] [--max 70] gravacao\n",
+                argv[0], argv[0]);
+        return 2;
+    }
+
+    FILE *f = fopen(entrada, "rb");
+    if (!f) {
+        perror(entrada);
+        return 1;
+    }
+    gravacao_t g = {0};
+    if (!carrega_binario(f, &g)) {
+        rewind(f);
+        carrega_texto(f, &g);
+    }
+    fclose(f);
+    if (g.n == 0) {
+        fprintf(stderr, "%s: nenhuma amostra\n", entrada);
+        return 1;
+    }
+    if (saida && !salva_binario(saida, &g)) {
+        perror(saida);
+        return 1;
+    }
+
+    if (enchimento > 0.0f) {
+        simula_e_compara(&g, enchimento, potencia_kw, epoca_s, fuso_s, lim_min, lim_max);
+        free(g.itens);
+        return 0;
+    }
+
+    // Mesmo passo do laço principal, com os reconhecimentos no mesmo ponto
+    diagnostico_init(NULL);
+    agenda_t agenda;
+    agenda_init(&agenda, agenda_tarifa_branca, agenda_tarifa_branca_num, fuso_s);
+    controle_t c = {0};
+    uint32_t ciclos = 0, reconhecimentos = 0;
+    uint64_t t_ligada_ms = 0, t_fora_faixa_ms = 0, t_seguro_ms = 0, t_elevado_ms = 0;
+    uint32_t falhas_vistas = 0;
+    float min_efetivo_max = lim_min;
+
+    for (size_t i = 0; i < g.n; i++) {
+        const amostra_t *a = &g.itens[i];
+        if (a->reconhece) {
+            controle_reconhece();
+            reconhecimentos++;
+            if (verboso) {
+                printf("%10lu ms  RECONHECE\n", (unsigned long)a->t_ms);
+            }
+        }
+        uint32_t agora_s = epoca_s + (a->t_ms - g.itens[0].t_ms) / 1000;
+        bool mudou = controle_amostra(&c, &agenda, a->t_ms, a->adc, tem_epoca ? &agora_s : NULL, lim_min, lim_max);
+        falhas_vistas |= c.falhas;
+        if (c.lim_min_efetivo > min_efetivo_max) {
+            min_efetivo_max = c.lim_min_efetivo;
+        }
+
+        if (mudou) {
+            if (c.bomba_ligada) {
+                ciclos++;
+            }
+            if (verboso) {
+                printf("%10lu ms  %-8s nivel %5.1f%%  minimo %5.1f%%  falhas 0x%lx\n", (unsigned long)a->t_ms,
+                       c.bomba_ligada ? "LIGA" : "DESLIGA", c.nivel, c.lim_min_efetivo, (unsigned long)c.falhas);
+            }
+        }
+
+        // Cada amostra vale até a próxima
+        uint32_t dt = i + 1 < g.n ? g.itens[i + 1].t_ms - a->t_ms : 0;
+        if (c.bomba_ligada) {
+            t_ligada_ms += dt;
+        }
+        if (c.nivel < lim_min || c.nivel > lim_max) {
+            t_fora_faixa_ms += dt;
+        }
+        if (diagnostico_estado_seguro()) {
+            t_seguro_ms += dt;
+        }
+        if (c.lim_min_efetivo > lim_min) {
+            t_elevado_ms += dt;
+        }
+    }
+
+    uint32_t duracao_ms = g.itens[g.n - 1].t_ms - g.itens[0].t_ms;
+    printf("amostras:           %zu\n", g.n);
+    printf("duracao:            %.1f s\n", duracao_ms / 1000.0);
+    printf("limites:            %.1f%% a %.1f%%\n", lim_min, lim_max);
+    printf("ciclos do rele:     %lu\n", (unsigned long)ciclos);
+    printf("bomba ligada:       %.1f s\n", t_ligada_ms / 1000.0);
+    printf("fora da faixa:      %.1f s\n", t_fora_faixa_ms / 1000.0);
+    printf("estado seguro:      %.1f s\n", t_seguro_ms / 1000.0);
+    printf("falhas detectadas:  0x%lx\n", (unsigned long)falhas_vistas);
+    printf("reconhecimentos:    %lu\n", (unsigned long)reconhecimentos);
+    printf("minimo efetivo:     ate %.1f%%, elevado por %.1f s\n", min_efetivo_max, t_elevado_ms / 1000.0);
+    printf("horas aprendidas:   %u\n", agenda_horas_aprendidas(&agenda));
+    free(g.itens);
+    return 0;
+}
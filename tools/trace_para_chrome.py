@@ -0,0 +1,178 @@
+#!/usr/bin/env python3
+"""
+Decodifica o rastreamento binário do firmware (lib/trace.h) para o formato
+JSON de eventos do Chrome, aberto em chrome://tracing ou ui.perfetto.dev.
+
+A entrada pode ser o corpo binário de /trace ou o despejo em hexadecimal
+feito pela USB (linhas "TRACE ..." geradas ao enviar 't' ao dispositivo);
+o formato é detectado automaticamente. Os nomes dos eventos e das rotas
+HTTP são lidos de lib/trace.h, então não há tabela duplicada aqui.
+
+Pares *_INICIO/*_FIM viram eventos com duração ("X"); os demais, eventos
+instantâneos ("i"). Cada núcleo aparece como uma thread.
+
+Exemplos:
+  curl -s http://192.168.0.50/trace -o trace.bin
+  tools/trace_para_chrome.py trace.bin -o trace.json
+  tools/trace_para_chrome.py --serial /dev/ttyACM0 -o trace.json
+"""
+
+import argparse
+import json
+import os
+import re
+import struct
+import sys
+
+CABECALHO_BASE = 16
+ANEL_CABECALHO = 8
+
+
+def le_definicoes(caminho):
+    """Retorna ({id: (nome, legenda)}, {rota: nome}) a partir de trace.h."""
+    texto = open(caminho, encoding="utf-8").read()
+    eventos = {}
+    for m in re.finditer(r"^\s*TRACE_(\w+)\s*=\s*(\d+),\s*(?://\s*(.*))?$", texto, re.M):
+        eventos[int(m.group(2))] = (m.group(1), (m.group(3) or "").strip())
+    rotas = {}
+    bloco = re.search(r"enum\s*\{([^}]*TRACE_ROTA_[^}]*)\}", texto)
+    if bloco:
+        for i, nome in enumerate(re.findall(r"TRACE_ROTA_(\w+)", bloco.group(1))):
+            rotas[i] = nome.lower()
+    return eventos, rotas
+
+
+def hex_para_binario(linhas):
+    dados = bytearray()
+    for linha in linhas:
+        linha = linha.strip()
+        if not linha.startswith("TRACE "):
+            continue
+        conteudo = linha[len("TRACE "):]
+        if conteudo == "FIM":
+            break
+        dados += bytes.fromhex(conteudo)
+    return bytes(dados)
+
+
+def le_serial(porta, tempo_limite):
+    import serial  # pyserial, só necessário para esta opção
+
+    with serial.Serial(porta, 115200, timeout=tempo_limite) as s:
+        s.reset_input_buffer()
+        s.write(b"t")
+        linhas = []
+        while True:
+            linha = s.readline()
+            if not linha:
+                raise SystemExit("tempo esgotado aguardando o despejo pela USB")
+            linha = linha.decode("ascii", "replace").strip()
+            linhas.append(linha)
+            if linha == "TRACE FIM":
+                return hex_para_binario(linhas)
+
+
+def carrega(caminho):
+    bruto = sys.stdin.buffer.read() if caminho == "-" else open(caminho, "rb").read()
+    # Despejo hexadecimal, possivelmente misturado a outras mensagens da USB
+    if not bruto.startswith(b"TRC") and re.search(rb"^TRACE [0-9a-f]", bruto, re.M):
+        return hex_para_binario(bruto.decode("ascii", "replace").splitlines())
+    # Aceita também a resposta HTTP completa (ex.: curl -i)
+    if bruto.startswith(b"HTTP/"):
+        bruto = bruto.split(b"\r\n\r\n", 1)[1]
+    return bruto
+
+
+def decodifica(dados):
+    """Retorna [(nucleo, idade_us, id, a, b)] em ordem de escrita por núcleo."""
+    if len(dados) < CABECALHO_BASE or dados[:3] != b"TRC":
+        raise SystemExit("entrada não é um rastreamento (assinatura TRC ausente)")
+    versao, nucleos = dados[3], dados[4]
+    if versao != 1:
+        raise SystemExit("versão de rastreamento não suportada: %d" % versao)
+    tam, tam_reg = struct.unpack_from("<HB", dados, 6)
+    (agora,) = struct.unpack_from("<I", dados, 12)
+    escritas = struct.unpack_from("<%dI" % nucleos, dados, CABECALHO_BASE)
+    inicio = CABECALHO_BASE + 4 * nucleos
+    tam_anel = ANEL_CABECALHO + tam * tam_reg
+    if len(dados) < inicio + nucleos * tam_anel:
+        raise SystemExit("rastreamento truncado: %d bytes" % len(dados))
+
+    registros = []
+    for nucleo in range(nucleos):
+        base = inicio + nucleo * tam_anel + ANEL_CABECALHO
+        escrita = escritas[nucleo]
+        n = min(escrita, tam)
+        for i in range(escrita - n, escrita):
+            ts, ev, a, b = struct.unpack_from("<IHHi", dados, base + (i % tam) * tam_reg)
+            # Idade em relação à captura; desfaz a volta do contador de 32 bits
+            idade = (agora - ts) & 0xFFFFFFFF
+            if idade >= 0x80000000:
+                continue  # Escrito depois da captura, durante o envio
+            registros.append((nucleo, idade, ev, a, b))
+    return registros
+
+
+def para_chrome(registros, eventos, rotas):
+    if not registros:
+        return {"traceEvents": [], "displayTimeUnit": "ms"}
+    mais_antigo = max(r[1] for r in registros)
+    saida = [{"name": "thread_name", "ph": "M", "pid": 0, "tid": n, "args": {"name": "núcleo %d" % n}}
+             for n in sorted({r[0] for r in registros})]
+    abertos = {}
+
+    for nucleo, idade, ev, a, b in registros:
+        nome, legenda = eventos.get(ev, ("EVENTO_%d" % ev, ""))
+        ts = mais_antigo - idade
+        args = {"a": a, "b": b}
+        if legenda:
+            args["legenda"] = legenda
+        if nome.startswith("HTTP_"):
+            args["rota"] = rotas.get(a, str(a))
+
+        if nome.endswith("_INICIO"):
+            abertos[(nucleo, nome[:-len("_INICIO")], a)] = (ts, args)
+            continue
+        if nome.endswith("_FIM"):
+            base = nome[:-len("_FIM")]
+            par = abertos.pop((nucleo, base, a), None)
+            if par:
+                rotulo = base if base != "HTTP" else "HTTP /" + args["rota"]
+                saida.append({"name": rotulo, "ph": "X", "pid": 0, "tid": nucleo,
+                              "ts": par[0], "dur": ts - par[0], "args": args})
+                continue
+        saida.append({"name": nome, "ph": "i", "s": "t", "pid": 0, "tid": nucleo, "ts": ts, "args": args})
+
+    # Inícios sem fim (envio em andamento na captura) viram instantâneos
+    for (nucleo, base, _), (ts, args) in abertos.items():
+        saida.append({"name": base + "_INICIO", "ph": "i", "s": "t", "pid": 0, "tid": nucleo,
+                      "ts": ts, "args": args})
+    return {"traceEvents": saida, "displayTimeUnit": "ms"}
+
+
+def main():
+    raiz = os.path.dirname(os.path.dirname(os.path.abspath(__file__)))
+    ap = argparse.ArgumentParser(description=__doc__, formatter_class=argparse.RawDescriptionHelpFormatter)
+    ap.add_argument("entrada", nargs="?", default="-", help="arquivo binário ou despejo hex ('-' = stdin)")
+    ap.add_argument("--serial", help="porta USB do dispositivo; envia 't' e lê o despejo")
+    ap.add_argument("--tempo-limite", type=float, default=5.0, help="segundos de espera na serial")
+    ap.add_argument("--cabecalho", default=os.path.join(raiz, "lib", "trace.h"), help="caminho de trace.h")
+    ap.add_argument("-o", "--saida", default="-", help="arquivo JSON de saída ('-' = stdout)")
+    args = ap.parse_args()
+
+    eventos, rotas = le_definicoes(args.cabecalho)
+    dados = le_serial(args.serial, args.tempo_limite) if args.serial else carrega(args.entrada)
+    registros = decodifica(dados)
+    resultado = para_chrome(registros, eventos, rotas)
+
+    if args.saida == "-":
+        json.dump(resultado, sys.stdout, ensure_ascii=False)
+        sys.stdout.write("\n")
+    else:
+        with open(args.saida, "w", encoding="utf-8") as f:
+            json.dump(resultado, f, ensure_ascii=False)
+    print("%d eventos decodificados" % len(registros), file=sys.stderr)
+
+
+if __name__ == "__main__":
+    main()